@@ -0,0 +1,29 @@
+#include "../product/ensemble_simu_runner.hpp"
+#include <iostream>
+#include <chrono>
+
+using namespace std::chrono;
+
+/*
+Ensemble of FloeDyn simulations in one process (no MPI, no PBC), sharing the floe meshes and external forces
+*/
+
+#ifdef MULTIOUTPUT
+#error "FLOE_ENSEMBLE writes one out file per member: not available with MULTIOUTPUT"
+#endif
+
+int main( int argc, char* argv[] )
+{
+	auto t_start = high_resolution_clock::now();
+    product::EnsembleSimuRunner simu(argc, argv);
+    simu.run();
+	auto t_end = high_resolution_clock::now();
+
+	auto simu_time = t_end-t_start;
+	hours hh = duration_cast<hours> (simu_time);
+	minutes mm = duration_cast<minutes> (simu_time % hours(1));
+	seconds ss = duration_cast<seconds> (simu_time % minutes(1));
+	std::cout 	<< "Chrono : Total ensemble simulation: " << hh.count() << "h "
+				<< mm.count() << "m " << ss.count() << "s \n";
+    return 0;
+}
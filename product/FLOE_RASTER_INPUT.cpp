@@ -0,0 +1,61 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include "../product/config/config_base.hpp"
+#include "floe/io/hdf5_raster_import.hpp"
+
+/*
+Creates an hdf5 input file from a labelled raster (segmented imagery): one floe per label, 0 being water.
+The raster is either the uint32 dataset "labels" of an hdf5 file (with an optional "pixel_size" attribute),
+or a raw file of nx * ny native uint32 (rows from the top of the image).
+*/
+
+int main( int argc, char* argv[] )
+{
+    using namespace std;
+    using namespace types;
+
+    if ( argc < 3 )
+    {
+        cout << "Usage: " << argv[0] << " <label_file (.h5 or raw)> <output_file.h5> [pixel_size (m)] [nx ny (raw file)]"
+             << " [max_error (pixels, default 0.5)] [min_pixels (default 4)]" << endl;
+        return 1;
+    }
+
+    std::string label_filename = argv[1];
+    std::string output_filename = argv[2];
+    const value_type pixel_size = (argc > 3) ? atof(argv[3]) : 1;
+    const bool raw = label_filename.substr(label_filename.find_last_of(".") + 1) != "h5";
+    if ( raw && argc < 6 )
+    {
+        cerr << "Error : raw label files require the pixel size and the raster dimensions nx ny." << endl;
+        return 1;
+    }
+    const int first_opt = raw ? 6 : 4;
+    const value_type max_error = (argc > first_opt) ? atof(argv[first_opt]) : 0.5;
+    const std::size_t min_pixels = (argc > first_opt + 1) ? atoi(argv[first_opt + 1]) : 4;
+
+    const auto start = std::chrono::steady_clock::now();
+    floe::io::LabelRaster<value_type> raster;
+    try {
+        raster = raw ? floe::io::read_raw_label_raster(label_filename, atoi(argv[4]), atoi(argv[5]), pixel_size)
+                     : floe::io::read_h5_label_raster(label_filename, pixel_size);
+    }
+    catch(std::exception& e)
+    {
+        cerr << "Error : " << e.what() << endl;
+        return 1;
+    }
+    cout << "Raster " << raster.nx << " x " << raster.ny << ", pixel size " << raster.pixel_size << " m" << endl;
+
+    auto floes = floe::io::extract_raster_floes<point_type>(raster, max_error, min_pixels);
+    std::size_t nb_points = 0;
+    for (auto const& floe : floes) nb_points += floe.shape.size();
+    floe::io::write_raster_floes_input(output_filename, floes, raster.window());
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    cout << floes.size() << " floes (" << nb_points << " boundary points) written to " << output_filename
+         << " in " << elapsed.count() << "s" << endl;
+    return 0;
+}
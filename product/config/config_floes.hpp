@@ -11,6 +11,7 @@
 #ifdef MPIRUN
 // #include "floe/floes/partial_floe_group.hpp"
 #include "floe/floes/identifiable_mixin.hpp"
+#include "floe/utils/shared_storage_allocator.hpp"
 #endif
 // #include "floe/floes/partial_floe_group.hpp"
 
@@ -20,7 +21,11 @@ namespace types { // testings
 
 
 #ifdef MPIRUN
-using floe_type = ff::Identifiable<std::size_t, ff::KinematicFloe<ff::StaticFloe<value_type, point_type>>>;
+// static boundaries and meshes attachable to node shared memory (see io::share_static_floes)
+using static_geometry_type = boost::geometry::model::polygon<
+    point_type, false, false, std::vector, std::vector, floe::utils::SharedStorageAllocator>;
+using static_mesh_type = floe::geometry::TriangleMesh<point_type, floe::utils::SharedStorageAllocator>;
+using floe_type = ff::Identifiable<std::size_t, ff::KinematicFloe<ff::StaticFloe<value_type, point_type, static_geometry_type, static_mesh_type>>>;
 using floe_group_type = floe::floes::PartialFloeGroup<floe_type>;
 #else
 using floe_type = ff::KinematicFloe<ff::StaticFloe<value_type, point_type>>;
@@ -0,0 +1,109 @@
+/*!
+ * \file floe/product/ensemble_simu_runner.hpp
+ * \brief Ensemble simulation runner
+ */
+
+#ifndef PRODUCT_ENSEMBLE_SIMU_RUNNER_HPP
+#define PRODUCT_ENSEMBLE_SIMU_RUNNER_HPP
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../product/simu_runner.hpp"
+
+namespace product {
+
+/*! Runs several members of an ensemble in one process
+ *
+ * The floes are loaded and meshed once, the external forces read once: each member is a problem
+ * over these shared floe meshes, with its own states, random seed and out file.
+ * The members are advanced concurrently, one member per thread.
+ */
+class EnsembleSimuRunner : public SimuRunner {
+public:
+    EnsembleSimuRunner( int argc, char* argv[] ) : SimuRunner(argc, argv) {}
+
+    virtual int run() override {
+        if (this->vm.count("help")) {
+            cout << this->desc << "\n";
+            return 0;
+        }
+        if (!this->check_options()){
+            return 1;
+        }
+        if (fracture || melting || vm.count("rectime")) {
+            cerr << "Error : crack, melting and recovery are not available for an ensemble (shared floe meshes).\n";
+            return 1;
+        }
+        if (input_file_name.substr(input_file_name.find(".") + 1) != "h5") {
+            cerr << "Error : an ensemble requires a .h5 input file.\n";
+            return 1;
+        }
+        #ifdef _OPENMP
+        Eigen::initParallel();
+        #endif
+
+        // Static data: floes loaded and meshed once, external forces read once
+        problem_type shared_problem(epsilon, OBL_status);
+        bool floes_characs;
+        try {
+            shared_problem.load_config(input_file_name);
+            if (simplify_factor > 0)
+                shared_problem.get_floe_group().simplify_floe_shapes(simplify_factor);
+            floes_characs = shared_problem.get_floe_group().h5_contains_floes_characs(input_file_name);
+            if (forcing_window)
+                this->convert_forcing_series();
+            else
+                shared_problem.load_matlab_topaz_data(matlab_topaz_filename);
+        }
+        catch(std::exception& e)
+        {
+            handle_exception(e);
+            return 1;
+        }
+
+        std::vector<std::unique_ptr<problem_type>> members;
+        for (std::size_t m = 0; m < nb_members; ++m)
+        {
+            members.emplace_back(new problem_type(epsilon, OBL_status));
+            problem_type& P = *members.back();
+            P.QUIT = &QUIT;
+            const unsigned seed = ensemble_seed + m;
+            try {
+                P.load_config_sharing_floes(input_file_name, shared_problem.get_floe_group());
+            }
+            catch(std::exception& e)
+            {
+                handle_exception(e);
+                return 1;
+            }
+            if (!floes_characs) {
+                P.get_floe_group().randomize_floes_thickness(random_thickness_coeff, seed);
+                P.get_floe_group().randomize_floes_oceanic_skin_drag(0.01, seed);
+            }
+            for (auto i: obstacles_indexes)
+                P.get_floe_group().get_floes()[i].is_obstacle() = true;
+            if (forcing_window)
+                P.load_forcing_series(this->forcing_series_file(), forcing_window);
+            else
+                P.get_dynamics_manager().get_external_forces().get_physical_data().copy_topaz_data(
+                    shared_problem.get_dynamics_manager().get_external_forces().get_physical_data());
+            P.get_dynamics_manager().set_random_seed(seed);
+            this->set_dynamics_options(P);
+            if (this->set_solver_options(P))
+                return 1;
+            P.get_out_manager().set_out_file_name(ensemble_out + "_" + std::to_string(m) + ".h5");
+        }
+
+        std::cout << "SOLVE " << nb_members << " MEMBERS..." << std::endl;
+        // One member per thread (the parallel loops of a member then run on its thread only)
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (std::size_t m = 0; m < members.size(); ++m)
+            members[m]->solve(endtime, default_time_step, out_time_step, true, false, false);
+        return 0;
+    }
+};
+
+} // namespace floe::product
+
+#endif // PRODUCT_ENSEMBLE_SIMU_RUNNER_HPP
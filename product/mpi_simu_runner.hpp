@@ -59,6 +59,8 @@ private:
         if (!generate_floes){
             try {
                 P.load_config(this->vm["input"].as<string>());
+                if (this->simplify_factor > 0)
+                    P.simplify_floe_shapes(this->simplify_factor); // once per node
             }
             catch(std::exception& e)
             {
@@ -71,9 +73,19 @@ private:
         }
 
         std::cout << "read TOPAZ" << std::endl;
-        P.load_matlab_topaz_data(this->vm["fext"].as<string>());
+        if (forcing_window) {
+            // converted once by the master, then each process only reads its windows
+            int rank;
+            MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+            if (rank == 0) this->convert_forcing_series();
+            MPI_Barrier( MPI_COMM_WORLD );
+            P.load_forcing_series(this->forcing_series_file(), forcing_window);
+        } else
+            P.load_matlab_topaz_data(this->vm["fext"].as<string>());
         P.get_dynamics_manager().set_rand_speed_add(rand_speed_add);
         P.get_dynamics_manager().set_norm_rand_speed(rand_norm);
+        P.get_dynamics_manager().set_implicit_drag(implicit_drag);
+        P.set_subgraph_task_size(lcp_task_size);
         P.get_dynamics_manager().get_external_forces().get_physical_data().set_modes(force_modes[0],force_modes[1]);
         P.get_dynamics_manager().get_external_forces().get_physical_data().set_speeds(force_speeds[0],force_speeds[1]);
         
@@ -118,6 +130,11 @@ private:
 
         std::cout << "SOLVE..." << std::endl;
         P.get_floe_group().set_mu_static(mu_static);
+        P.proximity_detector().set_manifold_max_size(manifold_max_size);
+        P.proximity_detector().set_oriented_boxes(oriented_boxes);
+        P.proximity_detector().set_hull_separation(hull_separation);
+        P.get_lcp_manager().get_solver().set_mixed_precision(lcp_mixed_precision);
+        P.get_lcp_manager().get_solver().set_fallback(lcp_fallback);
         if (mu_static!=0.7) {std::cout << "Warning: the ice/ice static friction coefficient is fixed to: " << mu_static << std::endl;}
         if (epsilon!=0.4) {std::cout << "Warning: the restitution coefficient is fixed to: " << epsilon << std::endl;}
         P.get_floe_group().randomize_floes_thickness(this->vm["sigma"].as<value_type>());
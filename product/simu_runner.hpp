@@ -6,7 +6,9 @@
 
 #ifndef PRODUCT_SIMU_RUNNER_HPP
 #define PRODUCT_SIMU_RUNNER_HPP
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <vector>
 #include <string>
 #include <cassert>
@@ -62,6 +64,8 @@ public:
         if (!generate_floes){
             try {
                 P.load_config(input_file_name);
+                if (simplify_factor > 0)
+                    P.get_floe_group().simplify_floe_shapes(simplify_factor);
                 if (!P.get_floe_group().h5_contains_floes_characs(input_file_name)) {
                     std::cout << "Randomizing floes thickness and oceanic skin drag coeff" << std::endl;
                     P.get_floe_group().randomize_floes_thickness(random_thickness_coeff);
@@ -110,28 +114,12 @@ public:
         }
 
         //std::cout << "read TOPAZ" << std::endl;
-        P.load_matlab_topaz_data(matlab_topaz_filename);
-        P.get_dynamics_manager().set_rand_speed_add(rand_speed_add);
-        P.get_dynamics_manager().set_norm_rand_speed(rand_norm);
-        if (vortex_characs[0]>0) {
-            P.get_dynamics_manager().get_external_forces().get_physical_data().set_nb_vortex(vortex_characs[0]);
-           P.get_dynamics_manager().get_external_forces().get_physical_data().set_nbVortexByZone(vortex_characs[1]);
-            P.get_dynamics_manager().get_external_forces().get_physical_data().set_vortexZoneSize(vortex_characs[2]*1e3);
-            P.get_dynamics_manager().get_external_forces().get_physical_data().set_firstVortexZoneDistToOrigin(vortex_characs[3]*1e3);
-        }
-        P.get_dynamics_manager().get_external_forces().get_physical_data().set_modes(force_modes[0],force_modes[1]);
-        P.get_dynamics_manager().get_external_forces().get_physical_data().set_speeds(force_speeds[0],force_speeds[1]);
-        // P.get_dynamics_manager().get_external_forces().get_physical_data().set_storm_mode(); // for simu: with storm
-        // P.get_dynamics_manager().get_external_forces().get_physical_data().set_modes(2,0);   // for simu: ?
-        // P.get_dynamics_manager().get_external_forces().get_physical_data().set_modes(-1,4);  // for simu: floes against obstacle
-
-        #ifdef MULTIOUTPUT
-            P.get_out_manager().set_size(nb_floe_select);
-        #endif
-        #ifdef LCPSTATS
-            P.get_lcp_manager().get_solver().set_max_storage_sol(max_storage[0]);
-            P.get_lcp_manager().get_solver().set_max_storage_unsol(max_storage[1]);
-        #endif
+        if (forcing_window) {
+            this->convert_forcing_series();
+            P.load_forcing_series(this->forcing_series_file(), forcing_window);
+        } else
+            P.load_matlab_topaz_data(matlab_topaz_filename);
+        this->set_dynamics_options(P);
 
         if (vm.count("rectime"))
         {
@@ -190,8 +178,8 @@ public:
         std::cout << "SOLVE..." << std::endl;
         // cout.precision(17);
         // std::cout << P.get_floe_group().total_area();
-        P.get_floe_group().set_mu_static(mu_static);
-        P.get_floe_group().set_min_thickness(min_thickness);
+        if (this->set_solver_options(P))
+            return 1;
         if (mu_static!=0.7) {std::cout << "Warning: the ice/ice static friction coefficient is fixed to: " << mu_static << std::endl;}
         if (epsilon!=0.4) {std::cout << "Warning: the restitution coefficient is fixed to: " << epsilon << std::endl;}
         P.solve(endtime, default_time_step, out_time_step, true, fracture, melting);
@@ -217,20 +205,45 @@ protected:
     std::vector<int>        force_modes             = std::vector<int> {1, 1};
     std::vector<value_type> force_speeds            = std::vector<value_type> {0, 0};
     int                     OBL_status              = 0;
+    std::size_t             OBL_grid_size           = 8;
+    value_type              subgrid_area            = 0;
+    std::size_t             subgrid_size            = 16;
     value_type              epsilon                 = 0.4;
     value_type              mu_static               = 0.7;
     value_type              random_thickness_coeff  = 0.01;
     value_type              min_thickness           = 0.01;
     string                  matlab_topaz_filename   = "io/library/DataTopaz01.mat";
+    std::size_t             forcing_window          = 0;
     value_type              max_size                = 250;
     bool                    fracture                = 0;
     bool                    melting                 = 0;
     bool                    rand_speed_add          = 1;
+    bool                    implicit_drag           = 0;
     value_type              rand_norm               = 1e-7;
     value_type              alpha                   = 1.5;
     int                     nbfpersize              = 1;
     std::vector<value_type> vortex_characs          = std::vector<value_type>(4,0);
     std::vector<std::size_t> obstacles_indexes       = std::vector<std::size_t>{};
+    std::size_t             manifold_max_size       = 0;
+    bool                    oriented_boxes          = 0;
+    bool                    hull_separation         = 0;
+    bool                    lcp_mixed_precision     = 0;
+    bool                    lcp_fallback            = 1;
+    bool                    contact_output          = 0;
+    std::size_t             aggregate_steps         = 0;
+    std::vector<value_type> aggregate_thresholds    = std::vector<value_type>{};
+    value_type              dem_stiffness           = 0;
+    std::vector<value_type> dem_coefs               = std::vector<value_type>{};
+    value_type              diag_step               = 0;
+    std::size_t             diag_grid_size          = 32;
+    string                  tracer_file_name        = "";
+    value_type              tracer_step             = 60;
+    value_type              simplify_factor         = 0;
+    std::size_t             reorder_steps           = 0;
+    std::size_t             lcp_task_size           = 0;
+    std::size_t             nb_members              = 1;
+    unsigned                ensemble_seed           = 1;
+    string                  ensemble_out            = "io/outputs/ensemble";
 
 
     void init_program_options( int argc, char* argv[] ){
@@ -241,6 +254,9 @@ protected:
         ("help,h", "print usage message")
         ("input,i", po::value(&input_file_name)->required(), "input file path")
         ("fext, z", po::value(&matlab_topaz_filename)->default_value(matlab_topaz_filename), "external forces input file")
+        ("fextwindow", po::value(&forcing_window)->default_value(forcing_window),
+            "Number of hours of external forces kept in memory (0 to load the whole file). A topaz .mat file is "
+            "converted once into a forcing series file (same name, .frc extension) read by windows.")
         #ifdef MULTIOUTPUT
             ("nbsefloes", po::value<std::size_t>(&nb_floe_select)->required(), "the size of the floe selection for the multiple output files")
         #endif
@@ -289,12 +305,21 @@ protected:
             "   or  air speed: 0      water speed: 1\n\n")
 
         ("bustle", po::value<bool>(&rand_speed_add), "0 to disable the additional random floe velocities.")
+        ("implicitdrag", po::value<bool>(&implicit_drag),
+            "1 to update the floes' speeds with a linearised implicit drag (stable whatever the floe size and the time step).")
         ("nbustle", po::value<value_type>(&rand_norm), "norm of the additional random floe velocities.")
+        ("subgrid", po::value(&subgrid_area)->default_value(subgrid_area),
+            "Floes with an area (m^2) lower than this value are converted into a continuum ice field, exchanging drag "
+            "and pressure with the remaining floes (0 to disable).")
+        ("subgridsize", po::value(&subgrid_size)->default_value(subgrid_size),
+            "Number of cells of the continuum ice grid along each direction.")
 
         ("tend,t", po::value(&endtime)->required(), "simulation duration (seconds)")
         ("step,s", po::value(&default_time_step)->default_value(default_time_step), "default time step")
         ("outstep,o", po::value(&out_time_step)->default_value(out_time_step), "output time step")
-        ("obl", po::value(&OBL_status)->default_value(OBL_status), "OBL status (0 or 1)")
+        ("obl", po::value(&OBL_status)->default_value(OBL_status), "OBL status (0 or 1, 2 for a gridded OBL)")
+        ("oblgrid", po::value(&OBL_grid_size)->default_value(OBL_grid_size),
+            "Number of cells along each direction of the gridded OBL coupling grid (OBL status 2).")
         ("rectime,r", po::value<value_type>(), "time to recover states from")
         ("recfile,f", po::value<string>(), "file name to recover states from")
 
@@ -327,6 +352,67 @@ protected:
             "Minimum floe thickness : considered molten and disappears under this value")
         ("obstacles", po::value<std::vector<std::size_t>>(&obstacles_indexes)->multitoken(),
             "Indexes of the floes to consider as obstacles (no move).")
+        ("manifold", po::value(&manifold_max_size)->default_value(manifold_max_size),
+            "Max number of contacts kept per contact cluster between two floes (0 to keep all contacts). "
+            "Kept contacts are the extreme ones along the shared boundary plus the deepest one (at least 3).")
+        ("obb", po::value<bool>(&oriented_boxes),
+            "1 to also bound each floe by the minimal area oriented box of its convex hull in the collision broad "
+            "phase (separating axis test after the global disk test): fewer candidate pairs for elongated floes.\n")
+        ("sat", po::value<bool>(&hull_separation),
+            "1 to test the convex hulls of close floes (and of their intersecting local disks) before the contact "
+            "search (separating axis test): close but separated pairs skip the point-segment distances.\n")
+        ("lcpmixed", po::value<bool>(&lcp_mixed_precision),
+            "1 to run the LCP pivoting in single precision, with a refined double precision solve on the final basis "
+            "(falls back to double precision pivoting when the refined solution is not accurate enough).\n")
+        ("lcpfallback", po::value<bool>(&lcp_fallback)->default_value(lcp_fallback),
+            "0 to leave the floes' speeds unchanged when a LCP is not solved. By default, the solution is replaced "
+            "by a projected Gauss-Seidel one, with a restitution clamped to not increase the kinetic energy.\n")
+        ("contacts", po::value<bool>(&contact_output),
+            "1 to save the impulses of each contact point (dataset contact_impulses of the out file: "
+            "time, floe ids, contact point, normal and tangential impulses).\n")
+        ("aggregate", po::value(&aggregate_steps)->default_value(aggregate_steps),
+            "Number of steps after which two floes in quiet contact are bonded into a compound rigid aggregate "
+            "(0 to disable aggregation, not available with crack or melting).")
+        ("aggthresholds", po::value<std::vector<value_type>>(&aggregate_thresholds)->multitoken(),
+            "Aggregation thresholds as a vector of size 3: max relative contact speed (m/s) and max impulse received "
+            "in a step for a quiet contact, impulse received in a step that splits an aggregate. "
+            "Default: 1e-3 1e3 1e5.")
+        ("dem", po::value(&dem_stiffness)->default_value(dem_stiffness),
+            "Normal stiffness (N/m) of a contact point to replace the LCP solving by explicit penalty contact forces "
+            "(soft contacts in the collision skin of the floes, time step bounded by the stiffness). 0 to solve LCPs.")
+        ("demcoefs", po::value<std::vector<value_type>>(&dem_coefs)->multitoken(),
+            "Penalty contact coefficients as a vector of size 3: ratio of the normal damping to the critical damping, "
+            "ratio of the tangential stiffness to the normal stiffness, time step safety factor. "
+            "Default: 0.3 0.5 0.2.")
+        ("diagstep", po::value(&diag_step)->default_value(diag_step),
+            "Time step (s) of the in-situ diagnostics (group diagnostics of the out file: gridded concentration, "
+            "velocity and kinetic energy, kinetic energy spectrum, floe size distribution, dispersion). "
+            "0 to disable. The full state output step can then be much larger.")
+        ("diaggrid", po::value(&diag_grid_size)->default_value(diag_grid_size),
+            "Number of cells along each direction of the diagnostic grids.")
+        ("tracers", po::value(&tracer_file_name),
+            "Virtual buoys file (initial position \"x y\" per line). Each tracer moves with the floe containing it "
+            "(dataset diagnostics/tracers of the out file: time, then x, y and floe id per tracer).")
+        ("tracerstep", po::value(&tracer_step)->default_value(tracer_step), "Time step (s) of the tracer output.")
+        ("simplify", po::value(&simplify_factor)->default_value(simplify_factor),
+            "Simplification of the imported floe boundaries (topology, area and mass preserving): max distance "
+            "between removed boundary points and the new boundary, in units of the floe contact distance "
+            "(sqrt(area) / 100). The floes are meshed again. 0 to disable.")
+        ("reorder", po::value(&reorder_steps)->default_value(reorder_steps),
+            "Number of steps between two sortings of the floes along a Hilbert curve of their positions, for the "
+            "memory locality of the collision detection (0 to disable). The output order is unchanged. "
+            "Not used with MPI.")
+        ("lcptask", po::value(&lcp_task_size)->default_value(lcp_task_size),
+            "MPI only: collision subgraphs with more than this number of contacts are not solved by the worker of "
+            "their partition but queued as tasks, each idle worker taking the next one (0 to disable).")
+        ("members", po::value(&nb_members)->default_value(nb_members),
+            "FLOE_ENSEMBLE only: number of ensemble members, advanced concurrently by the threads over the floe "
+            "meshes and external forces loaded once.")
+        ("seed", po::value(&ensemble_seed)->default_value(ensemble_seed),
+            "FLOE_ENSEMBLE only: random seed of the first member (seed + m for the member m), used by the extra "
+            "random floe velocities and, if the input file has none, by the floe thickness and oceanic skin drag.")
+        ("ensout", po::value(&ensemble_out)->default_value(ensemble_out),
+            "FLOE_ENSEMBLE only: out file prefix, the member m writes <prefix>_<m>.h5.")
         ;
         try {
             po::store(po::parse_command_line(argc, argv, desc), this->vm);
@@ -346,6 +432,102 @@ protected:
         sigaction(SIGSEGV,&sa,NULL); 
     }
 
+    //!< Forcing series file read by windows (the external forces file itself if it is not a .mat file)
+    string forcing_series_file() const {
+        const string ext = ".mat";
+        if (matlab_topaz_filename.size() < ext.size() ||
+            matlab_topaz_filename.compare(matlab_topaz_filename.size() - ext.size(), ext.size(), ext) != 0)
+            return matlab_topaz_filename;
+        return matlab_topaz_filename.substr(0, matlab_topaz_filename.size() - ext.size()) + ".frc";
+    }
+
+    //!< Converts the topaz .mat file into the forcing series file, if not done yet
+    void convert_forcing_series() const {
+        const string series_file = this->forcing_series_file();
+        if (series_file == matlab_topaz_filename || std::ifstream(series_file).good())
+            return;
+        std::cout << "Convert " << matlab_topaz_filename << " into " << series_file << std::endl;
+        floe::io::matlab::convert_topaz_to_forcing_series(matlab_topaz_filename, series_file);
+    }
+
+    //!< Dynamics options (forcing modes, random velocities, drag, OBL) of a loaded problem
+    void set_dynamics_options(problem_type& P){
+        P.get_dynamics_manager().set_rand_speed_add(rand_speed_add);
+        P.get_dynamics_manager().set_norm_rand_speed(rand_norm);
+        P.get_dynamics_manager().set_implicit_drag(implicit_drag);
+        P.get_dynamics_manager().set_OBL_grid_size(OBL_grid_size, OBL_grid_size);
+        P.get_dynamics_manager().set_subgrid(subgrid_area, subgrid_size, subgrid_size);
+        if (vortex_characs[0]>0) {
+            P.get_dynamics_manager().get_external_forces().get_physical_data().set_nb_vortex(vortex_characs[0]);
+           P.get_dynamics_manager().get_external_forces().get_physical_data().set_nbVortexByZone(vortex_characs[1]);
+            P.get_dynamics_manager().get_external_forces().get_physical_data().set_vortexZoneSize(vortex_characs[2]*1e3);
+            P.get_dynamics_manager().get_external_forces().get_physical_data().set_firstVortexZoneDistToOrigin(vortex_characs[3]*1e3);
+        }
+        P.get_dynamics_manager().get_external_forces().get_physical_data().set_modes(force_modes[0],force_modes[1]);
+        P.get_dynamics_manager().get_external_forces().get_physical_data().set_speeds(force_speeds[0],force_speeds[1]);
+        // P.get_dynamics_manager().get_external_forces().get_physical_data().set_storm_mode(); // for simu: with storm
+        // P.get_dynamics_manager().get_external_forces().get_physical_data().set_modes(2,0);   // for simu: ?
+        // P.get_dynamics_manager().get_external_forces().get_physical_data().set_modes(-1,4);  // for simu: floes against obstacle
+
+        #ifdef MULTIOUTPUT
+            P.get_out_manager().set_size(nb_floe_select);
+        #endif
+        #ifdef LCPSTATS
+            P.get_lcp_manager().get_solver().set_max_storage_sol(max_storage[0]);
+            P.get_lcp_manager().get_solver().set_max_storage_unsol(max_storage[1]);
+        #endif
+    }
+
+    //!< Floe, collision and output options of a loaded problem (returns 1 on error)
+    int set_solver_options(problem_type& P){
+        P.get_floe_group().set_mu_static(mu_static);
+        P.get_floe_group().set_min_thickness(min_thickness);
+        P.proximity_detector().set_manifold_max_size(manifold_max_size);
+        P.proximity_detector().set_oriented_boxes(oriented_boxes);
+        P.proximity_detector().set_hull_separation(hull_separation);
+        P.set_reorder_steps(reorder_steps);
+        P.get_lcp_manager().get_solver().set_mixed_precision(lcp_mixed_precision);
+        P.get_lcp_manager().get_solver().set_fallback(lcp_fallback);
+        P.get_lcp_manager().get_contact_record().set_enabled(contact_output);
+        P.get_aggregate_manager().set_nb_steps(aggregate_steps);
+        if (aggregate_thresholds.size() == 3) {
+            P.get_aggregate_manager().set_speed_threshold(aggregate_thresholds[0]);
+            P.get_aggregate_manager().set_impulse_threshold(aggregate_thresholds[1]);
+            P.get_aggregate_manager().set_split_impulse(aggregate_thresholds[2]);
+        }
+        P.get_dem_manager().set_stiffness(dem_stiffness);
+        if (dem_coefs.size() == 3) {
+            P.get_dem_manager().set_damping_ratio(dem_coefs[0]);
+            P.get_dem_manager().set_tangential_ratio(dem_coefs[1]);
+            P.get_dem_manager().set_safety_factor(dem_coefs[2]);
+        }
+        if (diag_step > 0) {
+            // floe size distribution range from the initial floes
+            value_type min_area = std::numeric_limits<value_type>::max(), max_area = 0;
+            for (auto const& floe : P.get_floe_group().get_floes()) {
+                min_area = std::min(min_area, floe.area());
+                max_area = std::max(max_area, floe.area());
+            }
+            P.get_diagnostics().add_default_reducers(diag_grid_size, min_area / 10, max_area * 10);
+            P.get_diagnostics().set_out_step(diag_step);
+        }
+        if (!tracer_file_name.empty()) {
+            // one tracer initial position "x y" per line
+            std::ifstream tracer_file(tracer_file_name);
+            if (!tracer_file) {
+                cerr << "Error : cannot open tracer file " << tracer_file_name << "\n";
+                return 1;
+            }
+            std::vector<point_type> tracer_points;
+            value_type x, y;
+            while (tracer_file >> x >> y) tracer_points.push_back({x, y});
+            P.get_tracers().set_points(tracer_points);
+            P.get_tracers().set_out_step(tracer_step);
+            std::cout << tracer_points.size() << " tracers read from " << tracer_file_name << std::endl;
+        }
+        return 0;
+    }
+
     bool check_options(){
         try {
             po::notify(vm);
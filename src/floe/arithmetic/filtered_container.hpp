@@ -59,6 +59,7 @@ public:
     }
     void filter_off() { m_filter = false; }
     void filter_on() { m_filter = true; }
+    bool is_filtered() const { return m_filter; }
 private:
     bool m_filter;
     std::vector<std::size_t> m_ids;
@@ -0,0 +1,440 @@
+/*!
+ * \file floe/collision/aggregate_manager.hpp
+ * \brief Compound rigid aggregates of floes locked in persistent contact.
+ */
+
+#ifndef FLOE_COLLISION_AGGREGATE_MANAGER_HPP
+#define FLOE_COLLISION_AGGREGATE_MANAGER_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <boost/graph/graph_utility.hpp>
+
+#include "floe/geometry/core/access.hpp"
+
+namespace floe { namespace collision
+{
+
+/*! AggregateManager
+ *
+ * Two floes in contact are bonded when, during nb_steps consecutive steps, their relative speed at every contact point
+ * stays below speed_threshold and the impulse received by each of them stays below impulse_threshold.
+ * The connected components of the bonds are the aggregates, moving as compound rigid bodies: after each collision
+ * solving, the speeds of the members are replaced by the rigid motion with the same momentum and angular momentum
+ * (combined mass and inertia about the compound mass center). This projection can make the contacts of the members
+ * with other floes approaching again: the collisions are then solved again on these external contacts, followed by
+ * a new projection (see solve_external_contacts).
+ * The members moved one by one with their own speed, their positions are then set back to a rigid displacement
+ * of the aggregate, and their speeds, updated with their own drag, to the rigid motion driven by the summed drag
+ * (see save_positions and rigid_move).
+ * The detector keeps the contacts between members of a same aggregate out of the contact graph, so that they are
+ * not solved, but still checks their interpenetration.
+ * An aggregate is split when one of its members receives an impulse greater than split_impulse during a step.
+ *
+ * \tparam TFloe    Type of floe.
+ */
+template <typename TFloe>
+class AggregateManager
+{
+
+public:
+    using floe_type = TFloe;
+    using real_type = typename floe_type::real_type;
+    using point_type = typename floe_type::point_type;
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max(); //!< id of floes out of any aggregate
+
+    AggregateManager() : m_nb_steps{0}, m_speed_threshold{1e-3}, m_impulse_threshold{1e3}, m_split_impulse{1e5},
+                         m_max_resolves{10}, m_nb_aggregates{0}, m_nb_merges{0}, m_nb_splits{0}, m_nb_resolves{0},
+                         m_nb_unresolved{0} {}
+
+    ~AggregateManager() {
+        if (m_nb_merges)
+            std::cout << "#AGGREGATES: " << m_nb_merges << " bonds created, " << m_nb_splits << " aggregates split, "
+                      << m_nb_resolves << " external collisions solved again, " << m_nb_unresolved
+                      << " steps with approaching contacts left\n";
+    }
+
+    //! Number of quiet steps before bonding two floes (0 disables the aggregation)
+    inline void set_nb_steps(std::size_t nb_steps) { m_nb_steps = nb_steps; }
+    inline bool is_enabled() const { return m_nb_steps != 0; }
+    inline void set_speed_threshold(real_type speed) { m_speed_threshold = speed; }
+    inline void set_impulse_threshold(real_type impulse) { m_impulse_threshold = impulse; }
+    inline void set_split_impulse(real_type impulse) { m_split_impulse = impulse; }
+    //! Max number of collision solvings of the external contacts after the rigid projection
+    inline void set_max_resolves(std::size_t max_resolves) { m_max_resolves = max_resolves; }
+
+    //! Aggregate id of each floe (npos if the floe is not bonded)
+    inline std::vector<std::size_t> const& aggregate_ids() const { return m_ids; }
+    inline std::size_t nb_aggregates() const { return m_nb_aggregates; }
+    inline std::size_t nb_bonds() const { return m_bonds.size(); }
+
+    //! Dissolve every aggregate (new floe set or states recovered from file)
+    void reset(std::size_t nb_floes);
+
+    /*! Update the aggregates after the collision solving of a step
+     *
+     * Splits the aggregates hit by a strong impulse, counts the quiet steps of the contacts of the graph,
+     * bonds the floes quiet for long enough and sets the speeds of the aggregate members to a rigid motion.
+     *
+     * \param floes     the floe list (the floe ids are their indexes in this list).
+     * \param graph     the contact graph of the step, after collision solving.
+     */
+    template <typename TFloeList, typename TContactGraph>
+    void update(TFloeList& floes, TContactGraph const& graph);
+
+    //! Set the speeds of the members of each aggregate to a rigid motion (same momentum and angular momentum)
+    template <typename TFloeList>
+    void rigidify(TFloeList& floes) const;
+
+    /*! Number of contacts between an aggregate member and another floe that are approaching (see ContactPoint::is_active)
+     *
+     * The relative speeds of these contacts are marked as changed (the member speeds are modified out of the collision solving).
+     */
+    template <typename TFloeList, typename TContactGraph>
+    std::size_t nb_approaching_contacts(TFloeList const& floes, TContactGraph const& graph) const;
+
+    /*! Solve again the collisions of the external contacts made approaching by the rigid projection
+     *
+     * The members being bodies of their own in the collision solving, the impulse of an external contact is too weak
+     * to stop the whole aggregate: the collisions are solved and the speeds projected until no external contact is
+     * approaching anymore (at most max_resolves times).
+     *
+     * \param floes     the floe list (the floe ids are their indexes in this list).
+     * \param graph     the contact graph of the step (the contacts between members are not part of it).
+     * \param collision_manager collision solver of the contact graph (e.g. LCPManager).
+     * eturn  the number of external contacts still approaching.
+     */
+    template <typename TFloeList, typename TContactGraph, typename TCollisionManager>
+    std::size_t solve_external_contacts(TFloeList& floes, TContactGraph& graph, TCollisionManager& collision_manager);
+
+    //! Save the positions of the aggregate members before they are moved (see rigid_move)
+    template <typename TFloeList>
+    void save_positions(TFloeList const& floes);
+
+    /*! Set the members moved one by one to a rigid displacement of their aggregate
+     *
+     * The mass center is moved as the members mass center, and the aggregate rotated by the mean rotation of
+     * the members weighted by their inertia about it. The speeds are then set to a rigid motion.
+     */
+    template <typename TFloeList>
+    void rigid_move(TFloeList& floes);
+
+private:
+    using key_type = std::pair<std::size_t, std::size_t>;
+
+    std::size_t m_nb_steps; //!< Number of quiet steps before bonding
+    real_type m_speed_threshold; //!< Max relative speed of quiet contacts
+    real_type m_impulse_threshold; //!< Max impulse received in a step by floes in quiet contact
+    real_type m_split_impulse; //!< Impulse received in a step that splits an aggregate
+    std::size_t m_max_resolves; //!< Max number of collision solvings of the external contacts after the projection
+    std::map<key_type, std::size_t> m_quiet_steps; //!< Number of consecutive quiet steps of each floe pair in contact
+    std::set<key_type> m_bonds; //!< Bonded floe pairs
+    std::vector<std::size_t> m_ids; //!< Aggregate id of each floe
+    std::vector<real_type> m_last_impulse; //!< Total received impulse of each floe at the previous update
+    std::vector<point_type> m_saved_pos; //!< Position of each member before the move (see save_positions)
+    std::vector<real_type> m_saved_theta; //!< Angle of each member before the move (see save_positions)
+    std::size_t m_nb_aggregates; //!< Number of aggregates
+    long m_nb_merges; //!< Total number of bonds created
+    long m_nb_splits; //!< Total number of aggregates split
+    long m_nb_resolves; //!< Total number of collision solvings of the external contacts
+    long m_nb_unresolved; //!< Number of steps ending with approaching external contacts
+
+    //! Aggregate ids from the connected components of the bonds
+    void update_ids();
+    //! Mass center of each aggregate
+    template <typename TFloeList>
+    void mass_centers(TFloeList const& floes, std::vector<real_type>& mass, std::vector<point_type>& center) const;
+
+    //! Speed of a floe at point p
+    static inline point_type point_speed(floe_type const& floe, point_type const& p)
+    {
+        auto const& state = floe.state();
+        return { state.speed.x - state.rot * (p.y - state.pos.y), state.speed.y + state.rot * (p.x - state.pos.x) };
+    }
+};
+
+template <typename TFloe>
+constexpr std::size_t AggregateManager<TFloe>::npos;
+
+
+template <typename TFloe>
+void
+AggregateManager<TFloe>::reset(std::size_t nb_floes)
+{
+    m_quiet_steps.clear();
+    m_bonds.clear();
+    m_ids.assign(nb_floes, npos);
+    m_last_impulse.assign(nb_floes, -1);
+    m_nb_aggregates = 0;
+}
+
+template <typename TFloe>
+template <typename TFloeList, typename TContactGraph>
+void
+AggregateManager<TFloe>::update(TFloeList& floes, TContactGraph const& graph)
+{
+    const std::size_t nb_floes = floes.size();
+    if (m_ids.size() != nb_floes) reset(nb_floes);
+    floe_type const* origin = floes.data();
+
+    // impulse received by each floe during the step (the first step after reset is considered quiet)
+    std::vector<real_type> step_impulse(nb_floes, 0);
+    for (std::size_t i = 0; i < nb_floes; ++i)
+    {
+        const real_type impulse = floes[i].total_received_impulse();
+        if (m_last_impulse[i] >= 0)
+            step_impulse[i] = (impulse >= m_last_impulse[i]) ? impulse - m_last_impulse[i] : impulse;
+        m_last_impulse[i] = impulse;
+    }
+
+    // splitting
+    bool changed = false;
+    std::vector<bool> split(m_nb_aggregates, false);
+    for (std::size_t i = 0; i < nb_floes; ++i)
+        if (m_ids[i] != npos && step_impulse[i] > m_split_impulse)
+            split[m_ids[i]] = true;
+    for (auto it = m_bonds.begin(); it != m_bonds.end(); )
+    {
+        if (split[m_ids[it->first]])
+            { it = m_bonds.erase(it); changed = true; }
+        else
+            ++it;
+    }
+    m_nb_splits += std::count(split.begin(), split.end(), true);
+
+    // quiet contacts counting (pairs not in contact anymore are forgotten)
+    std::map<key_type, std::size_t> quiet_steps;
+    for ( auto const& edge : boost::make_iterator_range( edges( graph ) ) )
+    {
+        floe_type const* floe1 = graph[source(edge, graph)].floe;
+        floe_type const* floe2 = graph[target(edge, graph)].floe;
+        const std::size_t n1 = floe1 - origin, n2 = floe2 - origin;
+        if (n1 >= nb_floes || n2 >= nb_floes || floe1->is_obstacle() || floe2->is_obstacle())
+            continue; // ghost floe or obstacle
+        bool quiet = step_impulse[n1] < m_impulse_threshold && step_impulse[n2] < m_impulse_threshold;
+        for ( auto const& contact : graph[edge] )
+        {
+            if (!quiet) break;
+            const point_type p{geometry::get<0>(contact.frame.center()), geometry::get<1>(contact.frame.center())};
+            const point_type dv = point_speed(*floe1, p) - point_speed(*floe2, p);
+            quiet = std::sqrt(dv.x * dv.x + dv.y * dv.y) < m_speed_threshold;
+        }
+        const key_type key = std::minmax(n1, n2);
+        if (!quiet || m_bonds.count(key)) continue;
+        auto const it = m_quiet_steps.find(key);
+        const std::size_t count = (it == m_quiet_steps.end()) ? 1 : it->second + 1;
+        if (count >= m_nb_steps)
+        {
+            m_bonds.insert(key);
+            ++m_nb_merges;
+            changed = true;
+        }
+        else
+            quiet_steps[key] = count;
+    }
+    m_quiet_steps = std::move(quiet_steps);
+
+    if (changed) update_ids();
+    rigidify(floes);
+}
+
+template <typename TFloe>
+void
+AggregateManager<TFloe>::update_ids()
+{
+    // union-find over the bonds
+    std::vector<std::size_t> parent(m_ids.size());
+    for (std::size_t i = 0; i < parent.size(); ++i) parent[i] = i;
+    auto find = [&parent](std::size_t i) {
+        while (parent[i] != i) i = parent[i] = parent[parent[i]];
+        return i;
+    };
+    for (auto const& bond : m_bonds)
+        parent[find(bond.first)] = find(bond.second);
+
+    std::fill(m_ids.begin(), m_ids.end(), npos);
+    std::vector<std::size_t> root_id(parent.size(), npos);
+    m_nb_aggregates = 0;
+    for (auto const& bond : m_bonds)
+        for (std::size_t i : {bond.first, bond.second})
+        {
+            const std::size_t root = find(i);
+            if (root_id[root] == npos) root_id[root] = m_nb_aggregates++;
+            m_ids[i] = root_id[root];
+        }
+}
+
+template <typename TFloe>
+template <typename TFloeList>
+void
+AggregateManager<TFloe>::rigidify(TFloeList& floes) const
+{
+    if (m_nb_aggregates == 0) return;
+
+    // mass, mass center and momentum of each aggregate
+    std::vector<real_type> mass;
+    std::vector<point_type> center, speed(m_nb_aggregates, point_type{0, 0});
+    mass_centers(floes, mass, center);
+    for (std::size_t i = 0; i < m_ids.size(); ++i)
+    {
+        const std::size_t a = m_ids[i];
+        if (a == npos) continue;
+        speed[a] += floes[i].state().speed * floes[i].mass();
+    }
+    for (std::size_t a = 0; a < m_nb_aggregates; ++a)
+        speed[a] = speed[a] / mass[a];
+
+    // angular momentum and inertia about the mass center
+    std::vector<real_type> ang_momentum(m_nb_aggregates, 0), inertia(m_nb_aggregates, 0);
+    for (std::size_t i = 0; i < m_ids.size(); ++i)
+    {
+        const std::size_t a = m_ids[i];
+        if (a == npos) continue;
+        auto const& state = floes[i].state();
+        const real_type m = floes[i].mass();
+        const point_type r = state.pos - center[a];
+        const point_type v = state.speed - speed[a];
+        ang_momentum[a] += floes[i].moment_cst() * state.rot + m * (r.x * v.y - r.y * v.x);
+        inertia[a] += floes[i].moment_cst() + m * (r.x * r.x + r.y * r.y);
+    }
+    std::vector<real_type> rot(m_nb_aggregates);
+    for (std::size_t a = 0; a < m_nb_aggregates; ++a)
+        rot[a] = ang_momentum[a] / inertia[a];
+
+    for (std::size_t i = 0; i < m_ids.size(); ++i)
+    {
+        const std::size_t a = m_ids[i];
+        if (a == npos) continue;
+        auto& state = floes[i].state();
+        state.speed = { speed[a].x - rot[a] * (state.pos.y - center[a].y), speed[a].y + rot[a] * (state.pos.x - center[a].x) };
+        state.rot = rot[a];
+    }
+}
+
+template <typename TFloe>
+template <typename TFloeList>
+void
+AggregateManager<TFloe>::mass_centers(TFloeList const& floes, std::vector<real_type>& mass, std::vector<point_type>& center) const
+{
+    mass.assign(m_nb_aggregates, 0);
+    center.assign(m_nb_aggregates, point_type{0, 0});
+    for (std::size_t i = 0; i < m_ids.size(); ++i)
+    {
+        const std::size_t a = m_ids[i];
+        if (a == npos) continue;
+        const real_type m = floes[i].mass();
+        mass[a] += m;
+        center[a] += floes[i].state().pos * m;
+    }
+    for (std::size_t a = 0; a < m_nb_aggregates; ++a)
+        center[a] = center[a] / mass[a];
+}
+
+template <typename TFloe>
+template <typename TFloeList, typename TContactGraph>
+std::size_t
+AggregateManager<TFloe>::nb_approaching_contacts(TFloeList const& floes, TContactGraph const& graph) const
+{
+    if (m_nb_aggregates == 0) return 0;
+    floe_type const* origin = floes.data();
+    std::size_t nb_approaching = 0;
+    for ( auto const& edge : boost::make_iterator_range( edges( graph ) ) )
+    {
+        const std::size_t n1 = graph[source(edge, graph)].floe - origin, n2 = graph[target(edge, graph)].floe - origin;
+        const bool member1 = n1 < m_ids.size() && m_ids[n1] != npos, member2 = n2 < m_ids.size() && m_ids[n2] != npos;
+        if (!member1 && !member2) continue;
+        graph[edge].mark_changed();
+        for ( auto const& contact : graph[edge] )
+            if (contact.is_active()) ++nb_approaching;
+    }
+    return nb_approaching;
+}
+
+template <typename TFloe>
+template <typename TFloeList, typename TContactGraph, typename TCollisionManager>
+std::size_t
+AggregateManager<TFloe>::solve_external_contacts(TFloeList& floes, TContactGraph& graph, TCollisionManager& collision_manager)
+{
+    std::size_t nb_approaching = nb_approaching_contacts(floes, graph);
+    for (std::size_t n = 0; n < m_max_resolves && nb_approaching != 0; ++n)
+    {
+        collision_manager.solve_contacts(graph);
+        rigidify(floes);
+        nb_approaching = nb_approaching_contacts(floes, graph);
+        ++m_nb_resolves;
+    }
+    if (nb_approaching) ++m_nb_unresolved;
+    return nb_approaching;
+}
+
+template <typename TFloe>
+template <typename TFloeList>
+void
+AggregateManager<TFloe>::save_positions(TFloeList const& floes)
+{
+    m_saved_pos.resize(m_ids.size());
+    m_saved_theta.resize(m_ids.size());
+    for (std::size_t i = 0; i < m_ids.size(); ++i)
+    {
+        if (m_ids[i] == npos) continue;
+        m_saved_pos[i] = floes[i].state().pos;
+        m_saved_theta[i] = floes[i].state().theta;
+    }
+}
+
+template <typename TFloe>
+template <typename TFloeList>
+void
+AggregateManager<TFloe>::rigid_move(TFloeList& floes)
+{
+    if (m_nb_aggregates == 0 || m_saved_pos.size() != m_ids.size()) return;
+
+    // displacement of the mass centers
+    std::vector<real_type> mass;
+    std::vector<point_type> old_center, new_center;
+    mass_centers(floes, mass, new_center);
+    old_center.assign(m_nb_aggregates, point_type{0, 0});
+    for (std::size_t i = 0; i < m_ids.size(); ++i)
+        if (m_ids[i] != npos)
+            old_center[m_ids[i]] += m_saved_pos[i] * floes[i].mass();
+    for (std::size_t a = 0; a < m_nb_aggregates; ++a)
+        old_center[a] = old_center[a] / mass[a];
+
+    // mean rotation weighted by the inertia about the mass center
+    std::vector<real_type> rotation(m_nb_aggregates, 0), inertia(m_nb_aggregates, 0);
+    for (std::size_t i = 0; i < m_ids.size(); ++i)
+    {
+        const std::size_t a = m_ids[i];
+        if (a == npos) continue;
+        const point_type r = m_saved_pos[i] - old_center[a];
+        const real_type I = floes[i].moment_cst() + floes[i].mass() * (r.x * r.x + r.y * r.y);
+        rotation[a] += I * (floes[i].state().theta - m_saved_theta[i]);
+        inertia[a] += I;
+    }
+
+    for (std::size_t i = 0; i < m_ids.size(); ++i)
+    {
+        const std::size_t a = m_ids[i];
+        if (a == npos) continue;
+        const real_type angle = rotation[a] / inertia[a];
+        const real_type c = std::cos(angle), s = std::sin(angle);
+        const point_type r = m_saved_pos[i] - old_center[a];
+        auto state = floes[i].state();
+        state.pos = new_center[a] + point_type{c * r.x - s * r.y, s * r.x + c * r.y};
+        state.theta = m_saved_theta[i] + angle;
+        floes[i].set_state(state);
+    }
+    rigidify(floes);
+}
+
+}} // namespace floe::collision
+
+#endif // FLOE_COLLISION_AGGREGATE_MANAGER_HPP
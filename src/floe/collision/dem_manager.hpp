@@ -0,0 +1,307 @@
+/*!
+ * \file floe/collision/dem_manager.hpp
+ * \brief Explicit penalty (soft contact) collision manager, alternative to the LCP solving.
+ */
+
+#ifndef FLOE_COLLISION_DEM_MANAGER_HPP
+#define FLOE_COLLISION_DEM_MANAGER_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <boost/graph/graph_utility.hpp>
+
+#include "floe/geometry/arithmetic/point_operators.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace floe { namespace collision
+{
+
+/*! DEMManager
+ *
+ * Soft contact model (discrete element method): instead of solving the LCPs of the collision subgraphs,
+ * each contact point of the detector applies a force integrated explicitly over the coming time step.
+ *
+ * The contact distances of the detector being unsigned, the floes are surrounded by a compressible skin
+ * of the detector collision distance (sqrt(area)/100, the lowest of the two floes): a contact point at a
+ * distance d gives a normal overlap delta = skin - d.
+ *  - Normal force: stiffness * delta - damping * normal relative speed (repulsive only), the damping being
+ *    2 * damping_ratio * sqrt(stiffness * reduced mass).
+ *  - Tangential force: one spring per pair of floes in contact (stiffness tangential_ratio * stiffness per
+ *    loaded contact point), stretched by the mean tangential relative speed and capped by Coulomb friction
+ *    (mu_static * total normal force). The spring is released when the floes separate.
+ *    The pair is ordered (lowest floe address first) and the contacts of all its edges are turned to this order,
+ *    so that the spring is kept when the detection direction of the pair changes.
+ *
+ * The forces of the pairs in contact are computed in parallel. The time step is bounded by stable_time_step.
+ * An actual interpenetration (skin fully compressed) is still handled by the time step rewind of Problem.
+ *
+ * \tparam TFloe    Type of floe.
+ */
+template <typename TFloe>
+class DEMManager
+{
+
+public:
+    using floe_type = TFloe;
+    using real_type = typename floe_type::real_type;
+    using point_type = typename floe_type::point_type;
+
+    DEMManager() : m_stiffness{0}, m_damping_ratio{0.3}, m_tangential_ratio{0.5}, m_safety_factor{0.2},
+                   m_nb_steps{0}, m_nb_contacts{0}, m_max_compression{0} {}
+
+    ~DEMManager() {
+        if (m_nb_steps)
+            std::cout << "#DEM contacts: " << m_nb_contacts << " loaded contact points over " << m_nb_steps
+                      << " steps, max skin compression " << 100 * m_max_compression << "%\n";
+    }
+
+    //! Normal stiffness of a contact point in N/m (0 disables the soft contacts: LCP solving)
+    inline void set_stiffness(real_type stiffness) { m_stiffness = stiffness; }
+    inline bool is_enabled() const { return m_stiffness > 0; }
+    //! Ratio of the normal damping to the critical damping
+    inline void set_damping_ratio(real_type ratio) { m_damping_ratio = ratio; }
+    //! Ratio of the tangential stiffness to the normal stiffness
+    inline void set_tangential_ratio(real_type ratio) { m_tangential_ratio = ratio; }
+    //! Time step safety factor (see stable_time_step)
+    inline void set_safety_factor(real_type factor) { m_safety_factor = factor; }
+
+    //! Release every tangential spring (new floe set or states recovered from file)
+    void reset() { m_springs.clear(); }
+
+    //! Skin thickness of a floe (collision distance of the detector, see OptimizedFloe)
+    static inline real_type skin(floe_type const& floe) { return std::sqrt(floe.area()) / 100; }
+
+    /*! Apply the contact forces of a contact graph during a time step
+     *
+     * \param graph     contact graph of the detector.
+     * \param dt        time step over which the forces are integrated.
+     * \return  the number of loaded contact points.
+     */
+    template <typename TContactGraph>
+    int solve_contacts(TContactGraph& graph, real_type dt);
+
+    /*! Stable time step
+     *
+     * Lowest of dt_default, of safety_factor * sqrt(mass / (stiffness * number of contact points)) over the floes
+     * in contact (period of the stiffest floe oscillation), and of the time for the fastest floe point
+     * to cross half the thinnest skin.
+     *
+     * \param floes     the floe list.
+     * \param graph     the contact graph of the step.
+     */
+    template <typename TFloeList, typename TContactGraph>
+    real_type stable_time_step(TFloeList const& floes, TContactGraph const& graph, real_type dt_default) const;
+
+private:
+    using key_type = std::pair<floe_type const*, floe_type const*>;
+
+    real_type m_stiffness; //!< Normal stiffness of a contact point
+    real_type m_damping_ratio; //!< Normal damping / critical damping
+    real_type m_tangential_ratio; //!< Tangential stiffness / normal stiffness
+    real_type m_safety_factor; //!< Time step safety factor
+    std::map<key_type, real_type> m_springs; //!< Tangential spring elongation of each ordered floe pair in contact
+    long m_nb_steps; //!< Total number of steps with contact forces
+    long m_nb_contacts; //!< Total number of loaded contact points
+    real_type m_max_compression; //!< Max compression of a skin (overlap / skin)
+
+    //! Speed of a floe at a point, given by its position relative to the floe center
+    static inline point_type point_speed(floe_type const& floe, point_type const& r)
+    {
+        auto const& state = floe.state();
+        return { state.speed.x - state.rot * r.y, state.speed.y + state.rot * r.x };
+    }
+};
+
+
+template <typename TFloe>
+template <typename TContactGraph>
+int
+DEMManager<TFloe>::solve_contacts(TContactGraph& graph, real_type dt)
+{
+    using edge_descriptor = typename boost::graph_traits<TContactGraph>::edge_descriptor;
+
+    //! Impulses of a floe pair: linear and angular impulses of each floe, total normal impulse
+    struct PairImpulse
+    {
+        point_type linear1{0, 0}, linear2{0, 0};
+        real_type angular1 = 0, angular2 = 0, normal = 0;
+        int nb_loaded = 0;
+        real_type compression = 0;
+    };
+
+    // Floe pairs in contact, ordered (lowest floe first) whatever the detection direction,
+    // with all their edges (the graph may hold one edge per detection direction)
+    std::vector<key_type> keys;
+    std::vector<std::vector<edge_descriptor>> pair_edges;
+    {
+        std::map<key_type, std::size_t> pair_ids;
+        for ( auto const& edge : boost::make_iterator_range( edges(graph) ) )
+        {
+            if ( graph[edge].empty() ) continue;
+            auto const& contact = graph[edge].front();
+            const key_type key = std::minmax(contact.floe1, contact.floe2);
+            auto const it = pair_ids.emplace(key, keys.size()).first;
+            if ( it->second == keys.size() )
+            {
+                keys.push_back(key);
+                pair_edges.emplace_back();
+            }
+            pair_edges[it->second].push_back(edge);
+        }
+    }
+    const std::size_t nb_pairs = keys.size();
+
+    // Tangential springs of the previous step, elongated along the tangent of the ordered pair
+    std::vector<real_type> elongations(nb_pairs, 0);
+    for (std::size_t i = 0; i < nb_pairs; ++i)
+    {
+        auto it = m_springs.find(keys[i]);
+        if (it != m_springs.end()) elongations[i] = it->second;
+    }
+
+    std::vector<PairImpulse> impulses(nb_pairs);
+    const real_type inf = std::numeric_limits<real_type>::max();
+
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (std::size_t i = 0; i < nb_pairs; ++i)
+    {
+        floe_type const& floe1 = *keys[i].first;
+        floe_type const& floe2 = *keys[i].second;
+        if ( floe1.is_obstacle() && floe2.is_obstacle() ) { elongations[i] = 0; continue; }
+
+        const real_type m1 = floe1.is_obstacle() ? inf : floe1.mass();
+        const real_type m2 = floe2.is_obstacle() ? inf : floe2.mass();
+        const real_type reduced_mass = floe1.is_obstacle() ? m2 : ( floe2.is_obstacle() ? m1 : m1 * m2 / (m1 + m2) );
+        const real_type damping = 2 * m_damping_ratio * std::sqrt(m_stiffness * reduced_mass);
+        const real_type skin_size = std::min(skin(floe1), skin(floe2));
+
+        // Contact points of the pair, frames and lever arms turned to the pair orientation (from floe1 to floe2)
+        struct PairContact { point_type u, v, r1, r2; real_type normal_force; };
+        std::vector<PairContact> contacts;
+        real_type total_normal = 0, tangential_speed = 0;
+        PairImpulse& impulse = impulses[i];
+        for ( auto const& edge : pair_edges[i] )
+            for ( auto const& contact : graph[edge] )
+            {
+                const real_type overlap = skin_size - contact.dist;
+                if (overlap <= 0) continue;
+                const bool same = (contact.floe1 == &floe1);
+                const real_type sign = same ? 1 : -1;
+                PairContact c{ sign * contact.frame.u(), sign * contact.frame.v(),
+                               same ? contact.r1() : contact.r2(), same ? contact.r2() : contact.r1(), 0 };
+                const point_type rel_speed = point_speed(floe2, c.r2) - point_speed(floe1, c.r1);
+                const real_type normal_speed = rel_speed.x * c.v.x + rel_speed.y * c.v.y;
+                c.normal_force = std::max(real_type(0), m_stiffness * overlap - damping * normal_speed);
+                if (c.normal_force == 0) continue;
+                total_normal += c.normal_force;
+                tangential_speed += rel_speed.x * c.u.x + rel_speed.y * c.u.y;
+                ++impulse.nb_loaded;
+                impulse.compression = std::max(impulse.compression, overlap / skin_size);
+                contacts.push_back(c);
+            }
+        if (impulse.nb_loaded == 0) { elongations[i] = 0; continue; }
+
+        // Tangential spring (Coulomb capped)
+        const real_type tangential_stiffness = m_tangential_ratio * m_stiffness * impulse.nb_loaded;
+        real_type elongation = elongations[i] + dt * tangential_speed / impulse.nb_loaded;
+        const real_type max_elongation = floe1.mu_static() * total_normal / tangential_stiffness;
+        if (std::abs(elongation) > max_elongation) elongation = std::copysign(max_elongation, elongation);
+        elongations[i] = elongation;
+        const real_type total_tangential = - tangential_stiffness * elongation;
+
+        // Impulses (forces on floe2, opposite on floe1)
+        for ( auto const& c : contacts )
+        {
+            const real_type fn = c.normal_force * dt, ft = total_tangential * dt * c.normal_force / total_normal;
+            const point_type f{fn * c.v.x + ft * c.u.x, fn * c.v.y + ft * c.u.y};
+            impulse.linear2 = impulse.linear2 + f;
+            impulse.linear1 = impulse.linear1 - f;
+            impulse.angular2 += c.r2.x * f.y - c.r2.y * f.x;
+            impulse.angular1 -= c.r1.x * f.y - c.r1.y * f.x;
+            impulse.normal += fn;
+        }
+    }
+
+    // Floe states update (pairs sharing floes: not in parallel)
+    m_springs.clear();
+    int nb_loaded = 0;
+    for (std::size_t i = 0; i < nb_pairs; ++i)
+    {
+        if (elongations[i] != 0) m_springs[keys[i]] = elongations[i];
+        PairImpulse const& impulse = impulses[i];
+        if (impulse.nb_loaded == 0) continue;
+        nb_loaded += impulse.nb_loaded;
+        m_max_compression = std::max(m_max_compression, impulse.compression);
+        floe_type const* floes[2] = {keys[i].first, keys[i].second};
+        point_type const* linear[2] = {&impulse.linear1, &impulse.linear2};
+        const real_type angular[2] = {impulse.angular1, impulse.angular2};
+        for (int k = 0; k < 2; ++k)
+        {
+            floes[k]->add_impulse(impulse.normal);
+            if (floes[k]->is_obstacle()) continue;
+            auto& state = floes[k]->state();
+            state.speed = state.speed + (*linear[k]) / floes[k]->mass();
+            state.rot += angular[k] / floes[k]->moment_cst();
+        }
+    }
+    if (nb_pairs) ++m_nb_steps;
+    m_nb_contacts += nb_loaded;
+    return nb_loaded;
+}
+
+
+template <typename TFloe>
+template <typename TFloeList, typename TContactGraph>
+typename DEMManager<TFloe>::real_type
+DEMManager<TFloe>::stable_time_step(TFloeList const& floes, TContactGraph const& graph, real_type dt_default) const
+{
+    real_type dt = dt_default;
+
+    // Stiffness: number of contact points of each floe
+    std::map<floe_type const*, std::size_t> nb_contacts;
+    for ( auto const& edge : boost::make_iterator_range( edges(graph) ) )
+        for ( auto const& contact : graph[edge] )
+        {
+            ++nb_contacts[contact.floe1];
+            ++nb_contacts[contact.floe2];
+        }
+    for ( auto const& floe_contacts : nb_contacts )
+    {
+        if ( floe_contacts.first->is_obstacle() ) continue;
+        dt = std::min(dt, m_safety_factor * std::sqrt( floe_contacts.first->mass() / (m_stiffness * floe_contacts.second) ));
+    }
+
+    // Kinematics: the fastest point crosses half of the thinnest skin
+    real_type min_skin = std::numeric_limits<real_type>::max(), max_speed = 0;
+    #pragma omp parallel for reduction(min:min_skin) reduction(max:max_speed)
+    for (std::size_t i = 0; i < floes.size(); ++i)
+    {
+        auto const& floe = floes[i];
+        min_skin = std::min(min_skin, skin(floe));
+        real_type radius = 0;
+        for ( auto const& pt : floe.static_floe().geometry().outer() )
+            radius = std::max(radius, std::sqrt(pt.x * pt.x + pt.y * pt.y));
+        auto const& state = floe.state();
+        max_speed = std::max(max_speed, std::sqrt(state.speed.x * state.speed.x + state.speed.y * state.speed.y)
+                                        + std::abs(state.rot) * radius);
+    }
+    if (max_speed > 0)
+        dt = std::min(dt, min_skin / (4 * max_speed));
+
+    return dt;
+}
+
+}} // namespace floe::collision
+
+
+#endif // FLOE_COLLISION_DEM_MANAGER_HPP
@@ -37,6 +37,8 @@ public:
     inline bool is_solved() const { return *m_solved; }
     inline std::size_t n1() const { return m_id_ifloe1; }
     inline std::size_t n2() const { return m_id_ifloe2; }
+    //! Identity of this contact, shared with its copies in the subgraphs
+    inline void const* id() const { return m_solved.get(); }
 
 private:
 
@@ -26,6 +26,7 @@
 
 #include "floe/geometry/geometry.hpp"
 #include "floe/geometry/arithmetic/point_operators.hpp"
+#include "floe/geometry/algorithms/separating_axis.hpp"
 #include <boost/geometry/algorithms/intersects.hpp>
 #include <algorithm>
 
@@ -85,7 +86,10 @@ public:
 
     //! Default constructor
     MatlabDetector()
-        : m_prox_data{}, m_detection_mode{0}, m_detection_chgt{1} {}
+        : m_prox_data{}, m_detection_mode{0}, m_detection_chgt{1}, m_manifold_max_size{0},
+          m_nb_manifold_contacts_in{0}, m_nb_manifold_contacts_out{0},
+          m_oriented_boxes{false}, m_nb_box_tests{0}, m_nb_box_rejections{0},
+          m_hull_separation{false}, m_nb_hull_tests{0}, m_nb_hull_rejections{0} {}
 
     //! Deleted copy constructor
     MatlabDetector( MatlabDetector<TFloeGroup, TContact> const& ) = delete;
@@ -94,7 +98,18 @@ public:
     MatlabDetector<TFloeGroup, TContact>& operator= (MatlabDetector const&) = delete;
 
     //! Destructor
-    ~MatlabDetector() { for ( auto& optim_ptr : m_prox_data.get_optims() ) delete optim_ptr; }
+    ~MatlabDetector() {
+        for ( auto& optim_ptr : m_prox_data.get_optims() ) delete optim_ptr;
+        if (m_manifold_max_size && m_nb_manifold_contacts_in)
+            std::cout   << "#CONTACT manifold reduction: " << m_nb_manifold_contacts_out << "/" << m_nb_manifold_contacts_in
+                        << " contacts kept (max " << m_manifold_max_size << " per cluster)\n";
+        if (m_oriented_boxes && m_nb_box_tests)
+            std::cout   << "#BROAD PHASE oriented boxes: " << m_nb_box_rejections << "/" << m_nb_box_tests
+                        << " pairs of intersecting global disks rejected\n";
+        if (m_hull_separation && m_nb_hull_tests)
+            std::cout   << "#NARROW PHASE convex hulls: " << m_nb_hull_rejections << "/" << m_nb_hull_tests
+                        << " pairs of intersecting local disks rejected\n";
+    }
 
     /*! Add a floe in the detector scope
      * It automatically creates the optimization datas associated to the new floe.
@@ -144,11 +159,63 @@ public:
 
     inline proximity_data_type const& data() { return m_prox_data; }
 
+    /*! Contact manifold reduction
+     *
+     * \param max_size Max number of contacts kept for each cluster of contacts along a boundary shared by two floes
+     *                 (0 disables the reduction, other values are raised to 3 at least: extreme points plus deepest).
+     */
+    inline void set_manifold_max_size(std::size_t max_size) {
+        m_manifold_max_size = (max_size == 0) ? 0 : std::max<std::size_t>(max_size, 3);
+    }
+    inline std::size_t get_manifold_max_size() const { return m_manifold_max_size; }
+
+    /*! Oriented box broad phase
+     *
+     * \param enabled  if true, the pairs of floes with intersecting global disks are also tested with their
+     *                 oriented boxes (separating axis test): a tighter bound for elongated floes.
+     */
+    inline void set_oriented_boxes(bool enabled) { m_oriented_boxes = enabled; }
+    inline bool get_oriented_boxes() const { return m_oriented_boxes; }
+
+    /*! Convex hull separation test before the contact search
+     *
+     * \param enabled  if true, the pairs of floes with intersecting local disks are first tested with their
+     *                 convex hulls, then with the convex hulls of their intersecting local disks (separating axis test).
+     */
+    inline void set_hull_separation(bool enabled) { m_hull_separation = enabled; }
+    inline bool get_hull_separation() const { return m_hull_separation; }
+
+    /*! Floe aggregates (see AggregateManager)
+     *
+     * \param aggregate_ids Aggregate id of each floe (or nullptr): the contacts between floes with the same id
+     *                      are kept out of the contact graph (their interpenetration is still checked).
+     */
+    inline void set_aggregate_ids(std::vector<std::size_t> const* aggregate_ids) { m_aggregate_ids = aggregate_ids; }
+
 protected:
     proximity_data_type m_prox_data;
     contact_graph_type m_contacts; //!< Contact graph
     bool m_detection_mode; //! Detection mode ('eta_min' in matlab)
     bool m_detection_chgt; //! Detection status ('eta_chgt' in matlab)
+    std::size_t m_manifold_max_size; //!< Max number of contacts per contact cluster (0 : no reduction)
+    long m_nb_manifold_contacts_in; //!< Total number of contacts detected (manifold reduction stats)
+    long m_nb_manifold_contacts_out; //!< Total number of contacts kept after manifold reduction
+    bool m_oriented_boxes; //!< Oriented box test after the global disk test (see set_oriented_boxes)
+    long m_nb_box_tests; //!< Total number of oriented box tests (broad phase stats)
+    long m_nb_box_rejections; //!< Total number of pairs rejected by the oriented box test
+    bool m_hull_separation; //!< Convex hull test before the contact search (see set_hull_separation)
+    long m_nb_hull_tests; //!< Total number of convex hull tests (narrow phase stats)
+    long m_nb_hull_rejections; //!< Total number of pairs rejected by the convex hull test
+    std::vector<std::size_t> const* m_aggregate_ids{nullptr}; //!< Aggregate id of each floe (see set_aggregate_ids)
+
+    //! Floes n1 and n2 belong to the same rigid aggregate (aggregate ids are indexed by storage index)
+    inline bool same_aggregate(std::size_t n1, std::size_t n2) const {
+        if (m_aggregate_ids == nullptr || n1 >= get_nb_floes() || n2 >= get_nb_floes()) return false;
+        n1 = m_prox_data.absolute_id(n1);
+        n2 = m_prox_data.absolute_id(n2);
+        if (n1 >= m_aggregate_ids->size() || n2 >= m_aggregate_ids->size()) return false;
+        return (*m_aggregate_ids)[n1] == (*m_aggregate_ids)[n2] && (*m_aggregate_ids)[n1] != std::numeric_limits<std::size_t>::max();
+    }
 
     inline optim_type& get_optim(std::size_t n) { return m_prox_data.get_optim(n); }
 
@@ -156,6 +223,7 @@ protected:
     //! \todo put that somewhere else !
     typedef std::pair<point_type,point_type> segment_type;
     real_type segment_pos( segment_type const& segment, point_type const& point ) const;
+    inline real_type segment_pos( segment_type const& segment, point_type const& point, real_type length ) const;
     real_type segment_dist( segment_type const& segment, point_type const& point ) const; 
     segment_type segment_from_id1( std::size_t n, std::size_t id1 ) const;
     segment_type segment_from_id2( std::size_t n, std::size_t id2 ) const;
@@ -169,12 +237,34 @@ protected:
     virtual void detect(); // initialization + detection
     //! Detects collisions in 4 main steps
     virtual void detect_step1();
+    //! Oriented box test of a pair: true (and proximity data set) if the boxes are separated by more than the contact distance
+    bool box_separation( std::size_t n1, std::size_t n2 );
     void detect_step2( std::size_t n1, std::size_t n2 );
     void detect_step3( std::size_t n1, std::size_t n2, std::vector<std::size_t> const& ldisks1, std::vector<std::size_t> const& ldisks2 );
+    template <typename TAdjacency>
+    bool hull_separation( std::size_t n1, std::size_t n2, std::vector<std::size_t> const& ldisks1, std::vector<std::size_t> const& ldisks2,
+                          TAdjacency const& adjacency, real_type dist_s );
     
     template <typename TAdjacency>
     real_type detect_step4( std::size_t n1, std::size_t n2, std::vector<std::size_t> const& ldisks1, std::vector<std::size_t> const& ldisks2, TAdjacency const& adjacency);
 
+    /*! Contact manifold reduction between two floes.
+     *
+     * Contacts found on consecutive boundary points of the first floe, with almost the same normal, form a cluster
+     * (typically a long flush edge). Each cluster bigger than m_manifold_max_size is replaced by its two extreme
+     * contacts along the tangent and its deepest one (then evenly spaced contacts, if more are allowed).
+     * The removed contacts lie between the kept ones on a straight boundary, so the set of resulting
+     * forces and moments the LCP can apply is unchanged, while its dimension (4 per contact) is reduced.
+     *
+     * A cluster may cross the seam of the boundary ring (last point to point 0).
+     *
+     * \param contact_list   Contacts from detect_step4, in boundary order.
+     * \param point_ids      Boundary point id (first floe) of each contact.
+     * \param nb_points      Number of boundary points of the first floe (point ids are taken modulo nb_points).
+     */
+    void reduce_contact_manifold( contact_list_type& contact_list, std::vector<std::size_t> const& point_ids,
+                                  std::size_t nb_points ) const;
+
     inline virtual contact_type create_contact(std::size_t n1, std::size_t n2, point_type point1, point_type point2) const {
         return { &m_prox_data.get_floe(n1), &m_prox_data.get_floe(n2), point1, point2 }; }
 
@@ -75,6 +75,10 @@ template <
 void
 MatlabDetector<TFloe, TData, TContact>::prepare_detection()
 {
+    // Boundary edges data are cached by the static floes: computed here, before the parallel detection
+    for ( auto const& floe : m_prox_data.get_floes() )
+        floe.static_floe().edge_lengths();
+
     this->prepare_optims();
     this->prepare_contact_graph();
 }
@@ -164,15 +168,51 @@ MatlabDetector<TFloe, TData, TContact>::detect_step1()
             {
                 m_prox_data.set_indic(n1, n2, 0);
             } 
+            else if ( m_oriented_boxes && box_separation(n1, n2) )
+            {
+                // No contact
+            }
             else 
             {
                 detect_step2(n1, n2);
             }
+
+            // rigidly bonded floes: checked for interpenetration but no time step constraint (rigid relative motion)
+            if ( same_aggregate(n1, n2) )
+                m_prox_data.set_dist_secu(n1, n2, std::numeric_limits<real_type>::max());
         }
     }
 
 }
 
+//! Tests oriented box separation (pairs with intersecting global disks)
+template <
+    typename TFloe,
+    typename TData,
+    typename TContact
+>
+bool
+MatlabDetector<TFloe, TData, TContact>::box_separation( std::size_t n1, std::size_t n2 )
+{
+    auto const& opt1 = get_optim_itf(n1);
+    auto const& opt2 = get_optim_itf(n2);
+
+    const real_type dist = geometry::distance_box_box( opt1.global_box(), opt2.global_box() );
+    #pragma omp atomic
+    ++m_nb_box_tests;
+    if ( dist <= std::max( opt1.cdist(), opt2.cdist() ) )
+        return false;
+
+    #pragma omp atomic
+    ++m_nb_box_rejections;
+    // No contact. The box distance is a lower bound of the floe distance but not along the line of the
+    // disk centers, used by the fast time step estimate: the pair keeps indic 1 (rotation aware estimate).
+    m_prox_data.set_indic(n1, n2, 1);
+    m_prox_data.set_dist_secu(n1, n2, dist);
+    m_prox_data.set_dist_opt(n1, n2, dist);
+    return true;
+}
+
 //! Finds local disks that are in the other floe global disk
 template <
     typename TFloe,
@@ -285,6 +325,10 @@ MatlabDetector<TFloe, TData, TContact>::detect_step3(
         m_prox_data.set_dist_secu(n1, n2, dist_s);
         m_prox_data.set_dist_opt(n1, n2, dist_o);
     } 
+    else if ( m_hull_separation && hull_separation(n1, n2, ldisks1, ldisks2, adjacency, dist_s) )
+    {
+        // No contact (distances set by hull_separation)
+    }
     else 
     {
         #pragma omp critical
@@ -295,6 +339,66 @@ MatlabDetector<TFloe, TData, TContact>::detect_step3(
     }
 }
 
+/*! Tests convex hull separation (pairs with intersecting local disks)
+ *
+ * The floes are separated if their convex hulls are, or if the convex hulls of each pair of
+ * intersecting local disks are (non-convex floes): no point-segment distance can then be lower than
+ * the collision distance.
+ *
+ * \param dist_s    Security distance from the local disks that do not intersect (see detect_step3).
+ */
+template <
+    typename TFloe,
+    typename TData,
+    typename TContact
+>
+template <typename TAdjacency>
+bool
+MatlabDetector<TFloe, TData, TContact>::hull_separation(
+    std::size_t n1, std::size_t n2,
+    std::vector<std::size_t> const& ldisks1, std::vector<std::size_t> const& ldisks2,
+    TAdjacency const& adjacency, real_type dist_s
+)
+{
+    auto const& opt1 = get_optim_itf(n1);
+    auto const& opt2 = get_optim_itf(n2);
+    auto const& ring1 = get_floe_itf(n1).geometry().outer();
+    auto const& ring2 = get_floe_itf(n2).geometry().outer();
+    const real_type min_gap = std::max( opt1.cdist(), opt2.cdist() );
+
+    #pragma omp atomic
+    ++m_nb_hull_tests;
+
+    auto const& hull1 = opt1.hull();
+    auto const& hull2 = opt2.hull();
+    real_type gap = geometry::convex_polygons_gap( ring1, hull1.ids, hull1.lengths, ring2, hull2.ids, hull2.lengths, min_gap );
+
+    if ( gap <= min_gap )
+    {
+        gap = std::numeric_limits<real_type>::max();
+        for ( auto it1 = adjacency.begin1(); it1 != adjacency.end1() && gap > min_gap; ++it1 )
+        {
+            auto const& local_hull1 = opt1.local_hulls()[ldisks1[it1.index1()]];
+            for ( auto it2 = it1.begin(); it2 != it1.end() && gap > min_gap; ++it2 )
+            {
+                auto const& local_hull2 = opt2.local_hulls()[ldisks2[it2.index2()]];
+                gap = std::min( gap, geometry::convex_polygons_gap(
+                    ring1, local_hull1.ids, local_hull1.lengths, ring2, local_hull2.ids, local_hull2.lengths, min_gap
+                ));
+            }
+        }
+        if ( gap <= min_gap )
+            return false;
+    }
+
+    #pragma omp atomic
+    ++m_nb_hull_rejections;
+    // No contact: the separation is a lower bound of the distance between the parts of the floes in the intersecting local disks.
+    m_prox_data.set_dist_secu(n1, n2, std::min(gap, dist_s));
+    m_prox_data.set_dist_opt(n1, n2, std::min(gap, dist_s));
+    return true;
+}
+
 //! Searching contacts
 template <
     typename TFloe,
@@ -315,8 +419,16 @@ detect_step4(
     auto const& opt1 = get_optim_itf(n1);
     auto const& opt2 = get_optim_itf(n2);
 
+    // Cached edges data of obj2 (floe frame) and its rotation
+    auto const& floe2 = get_floe_itf(n2);
+    auto const& edge_lengths2 = floe2.static_floe().edge_lengths();
+    auto const& edge_normals2 = floe2.static_floe().edge_normals();
+    const std::size_t nb_edges2 = edge_lengths2.size();
+    const auto rotation2 = geometry::frame::rigid_transformer( floe2.frame() );
+
     // Contact list
     contact_list_type contact_list;
+    std::vector<std::size_t> contact_point_ids; // boundary point of obj1 for each contact (manifold reduction)
 
     real_type global_min_dist = std::numeric_limits<real_type>::max(); // Minimum distance from any points of obj1 to obj2
 
@@ -356,9 +468,10 @@ detect_step4(
                     {
                         // Segment beginning with ipt2
                         const segment_type segment = segment_from_id1(n2, ipt2);
+                        const std::size_t edge2 = (ipt2 < nb_edges2) ? ipt2 : ipt2 - nb_edges2;
                         
                         // Position of the projection of the point of obj1 on the segment of obj2
-                        const real_type pos = segment_pos(segment, point1);
+                        const real_type pos = segment_pos(segment, point1, edge_lengths2[edge2]);
  
                         if (pos <= 0) // Backward position, handle only if the point is dangling
                         {
@@ -382,11 +495,15 @@ detect_step4(
                         }
                         else if (pos > 0 && pos < 1) // Middle position => point-segment contact
                         {
-                            // Contact point-segment
-                            const point_type point2 = point_from_pos(segment, pos);
-                            const real_type dist = distance(point1, point2);
+                            // Contact point-segment (distance along the rotated edge normal)
+                            point_type const& normal2 = edge_normals2[edge2];
+                            const real_type dist = std::abs(
+                                    (rotation2.c * normal2.x - rotation2.s * normal2.y) * (point1.x - segment.first.x)
+                                +   (rotation2.s * normal2.x + rotation2.c * normal2.y) * (point1.y - segment.first.y)
+                            );
                             if ( dist < min_dist )
                             {
+                                const point_type point2 = point_from_pos(segment, pos);
                                 min_contact = create_contact(n1, n2, point1, point2);
                                 // min_contact = { m_prox_data.get_floe(n2), m_prox_data.get_floe(n1), point2, point1 }; // TEST
                                 min_dist = dist;
@@ -441,6 +558,7 @@ detect_step4(
             // if (min_dist <= std::max( opt1.cdist(), opt2.cdist() ) )
             {
                 contact_list.push_back(min_contact);
+                contact_point_ids.push_back(ipt1);
             }
 
             global_min_dist = std::min( global_min_dist, min_dist );
@@ -450,8 +568,16 @@ detect_step4(
     } // Loop over disks of obj1
 
 
-    // Add edge in graph if there is any contact
-    if (contact_list.size() != 0)
+    // Reduce contact clusters (called in a critical section, see detect_step3)
+    if (m_manifold_max_size)
+    {
+        m_nb_manifold_contacts_in += contact_list.size();
+        reduce_contact_manifold( contact_list, contact_point_ids, get_floe_itf(n1).geometry().outer().size() );
+        m_nb_manifold_contacts_out += contact_list.size();
+    }
+
+    // Add edge in graph if there is any contact (not solved between floes of a same aggregate)
+    if (contact_list.size() != 0 && !same_aggregate(n1, n2))
     {
         // pragma omp critical
         {add_edge(vertex(m_prox_data.real_floe_id(n1), m_contacts), vertex(m_prox_data.real_floe_id(n2), m_contacts), {contact_list, n1, n2}, m_contacts);}
@@ -463,6 +589,95 @@ detect_step4(
 }
 
 
+template <
+    typename TFloe,
+    typename TData,
+    typename TContact
+>
+void
+MatlabDetector<TFloe, TData, TContact>::reduce_contact_manifold(
+    contact_list_type& contact_list, std::vector<std::size_t> const& point_ids, std::size_t nb_points
+) const
+{
+    using namespace floe::geometry;
+
+    const std::size_t max_size = m_manifold_max_size;
+    const std::size_t nb_contacts = contact_list.size();
+    if ( nb_contacts <= max_size ) return;
+
+    const real_type cos_tol = 0.996; // max angle of 5 degrees between normals of a same cluster
+
+    // Contact j follows contact i in a cluster: next boundary point (modulo the ring size) and aligned normals
+    auto follows = [&]( std::size_t i, std::size_t j ) {
+        const std::size_t id_i = point_ids[i] % nb_points, id_j = point_ids[j] % nb_points;
+        return ( id_j == id_i || id_j == (id_i + 1) % nb_points )
+            && dot_product( contact_list[j].frame.v(), contact_list[i].frame.v() ) >= cos_tol;
+    };
+
+    // The contacts are in boundary order, from point 0: a cluster crossing the ring seam is split between
+    // the end and the beginning of the list. The clusters are then browsed from the beginning of the last one.
+    std::size_t start = 0;
+    if ( follows(nb_contacts - 1, 0) )
+    {
+        start = nb_contacts - 1;
+        while ( start > 0 && follows(start - 1, start) ) --start; // 0 : a single cluster
+    }
+    auto at = [&]( std::size_t k ) -> contact_type const& { return contact_list[(start + k) % nb_contacts]; };
+
+    contact_list_type reduced;
+    reduced.reserve(nb_contacts);
+    std::vector<bool> keep;
+
+    std::size_t begin = 0;
+    while ( begin < nb_contacts )
+    {
+        // Cluster [begin, end) : consecutive boundary points with aligned normals
+        std::size_t end = begin + 1;
+        while ( end < nb_contacts && follows( (start + end - 1) % nb_contacts, (start + end) % nb_contacts ) )
+            ++end;
+
+        const std::size_t size = end - begin;
+        if ( size <= max_size )
+        {
+            for ( std::size_t k = begin; k < end; ++k )
+                reduced.push_back( at(k) );
+        }
+        else
+        {
+            // Extreme points along the cluster tangent, and deepest point
+            const point_type tangent = at(begin).frame.u();
+            std::size_t id_min = begin, id_max = begin, id_deep = begin;
+            real_type pos_min = std::numeric_limits<real_type>::max();
+            real_type pos_max = - pos_min;
+            for ( std::size_t k = begin; k < end; ++k )
+            {
+                const real_type pos = dot_product( at(k).frame.center(), tangent );
+                if ( pos < pos_min ) { pos_min = pos; id_min = k; }
+                if ( pos > pos_max ) { pos_max = pos; id_max = k; }
+                if ( at(k).dist < at(id_deep).dist ) id_deep = k;
+            }
+            keep.assign( size, false );
+            keep[id_min - begin] = keep[id_max - begin] = keep[id_deep - begin] = true;
+            std::size_t nb_kept = std::count( keep.begin(), keep.end(), true );
+
+            // Evenly spaced contacts to fill the remaining places
+            const std::size_t nb_free = max_size - nb_kept;
+            for ( std::size_t k = 1; k <= nb_free && nb_kept < max_size; ++k )
+            {
+                const std::size_t i = k * size / (nb_free + 1);
+                if ( !keep[i] ) { keep[i] = true; ++nb_kept; }
+            }
+
+            for ( std::size_t i = 0; i < size; ++i )
+                if ( keep[i] ) reduced.push_back( at(begin + i) );
+        }
+        begin = end;
+    }
+
+    contact_list = std::move(reduced);
+}
+
+
 template <
     typename TFloe,
     typename TData,
@@ -528,6 +743,24 @@ MatlabDetector<TFloe, TData, TContact>::segment_pos( segment_type const& segment
     return floe::geometry::dot_product( u, point - segment.first ) / sum(u*u);
 }
 
+/*! Relative position of the projection of point on the segment, with known segment length
+ *
+ * \param segment the segment
+ * \param point   point to project on the segment
+ * \param length  segment length (cached edge length, see StaticFloe::edge_lengths)
+ */
+template <
+    typename TFloe,
+    typename TData,
+    typename TContact
+>
+inline
+typename MatlabDetector<TFloe, TData, TContact>::real_type
+MatlabDetector<TFloe, TData, TContact>::segment_pos( segment_type const& segment, point_type const& point, real_type length ) const
+{
+    return floe::geometry::dot_product( segment.second - segment.first, point - segment.first ) / (length * length);
+}
+
 /*! Distance of a point to a segment
  *
  * \param segment the segment
@@ -49,6 +49,9 @@ public:
     using point_type = typename optim_type::point_type;
     using circle_type = typename optim_type::circle_type;
     using multi_circle_type = typename optim_type::multi_circle_type;
+    using box_type = typename optim_type::box_type;
+    using hull_type = typename optim_type::hull_type;
+    using multi_hull_type = typename optim_type::multi_hull_type;
     using local_points_type = typename optim_type::local_points_type;
     using real_type = typename optim_type::real_type;
     using translate_strategy_type = boost::geometry::strategy::transform::translate_transformer<real_type, 2,2>;
@@ -69,10 +72,16 @@ public:
 
     //! Global disk accessor
     circle_type const& global_disk() const;
+    //! Global oriented box accessor
+    box_type const& global_box() const;
     //! Local disks accessor
     multi_circle_type const& local_disks()   const;
     //! Local points accessor
     inline local_points_type const& local_points() const { return m_optim->local_points(); }
+    //! Convex hull accessor (boundary indices: same as the original)
+    inline hull_type const& hull() const { return m_optim->hull(); }
+    //! Local hulls accessor
+    inline multi_hull_type const& local_hulls() const { return m_optim->local_hulls(); }
 
     real_type const&         cdist() const { return m_optim->cdist(); }
     real_type const&         tau() const { return m_optim->tau(); }
@@ -85,6 +94,7 @@ private:
     translate_strategy_type m_translator; //! Translation strategy for geometry transformation
 
     mutable circle_type         m_global_disk;  //!< The surrounding disk
+    mutable box_type            m_global_box;   //!< The surrounding oriented box
     mutable multi_circle_type   m_local_disks;  //!< The local disks (surrounding the border)
 };
 
@@ -97,6 +107,15 @@ GhostOptimizedFloe<TOptim>::global_disk() const
     return m_global_disk;
 }
 
+template<typename TOptim>
+typename GhostOptimizedFloe<TOptim>::box_type const&
+GhostOptimizedFloe<TOptim>::global_box() const
+{
+    m_global_box = m_optim->global_box();
+    m_global_box.center = m_global_box.center + m_translation;
+    return m_global_box;
+}
+
 template<typename TOptim>
 typename GhostOptimizedFloe<TOptim>::multi_circle_type const&
 GhostOptimizedFloe<TOptim>::local_disks() const 
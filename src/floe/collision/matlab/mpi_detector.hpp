@@ -11,6 +11,7 @@
 #include <mpi.h>
 #include "floe/collision/matlab/detector.h"
 #include <math.h>
+#include <set>
 
 namespace floe { namespace collision { namespace matlab
 {
@@ -32,6 +33,8 @@ public:
     using optim_type = typename base_class::optim_type;
     using floe_interface_type = typename base_class::floe_interface_type;
     using optim_interface_type = typename base_class::optim_interface_type;
+    using floe_type = typename base_class::floe_type;
+    using contact_graph_type = typename base_class::contact_graph_type;
     using floe_distrib_type = std::map<int, std::vector<std::size_t>>;
     using process_list_type = std::vector<int>;
     using process_partition_type = std::map<std::string, process_list_type>;
@@ -157,6 +160,32 @@ public:
             this->get_optim(i).update();
     }
 
+    /*! Removes the collision subgraphs with more than max_contacts contacts from the contact graph
+     *
+     * They are left to the subgraph tasks shared by all workers (see MPIMasterProblem::solve_subgraph_tasks).
+     * \return Floe ids of each removed subgraph (obstacles included).
+     */
+    std::vector<std::vector<std::size_t>> extract_large_subgraphs(std::size_t max_contacts){
+        std::vector<std::vector<std::size_t>> tasks;
+        std::set<floe_type const*> task_floes; // obstacles excluded: they can be shared with small subgraphs
+        for (auto const& subgraph : collision_subgraphs(this->m_contacts)){
+            if (num_contacts(subgraph) <= max_contacts) continue;
+            tasks.push_back({});
+            for (auto const v : boost::make_iterator_range(vertices(subgraph))){
+                auto const floe = subgraph[v].floe;
+                tasks.back().push_back(floe->id());
+                if (!floe->is_obstacle()) task_floes.insert(floe);
+            }
+        }
+        if (tasks.size()){
+            auto& graph = this->m_contacts;
+            remove_edge_if([&](typename contact_graph_type::edge_descriptor e){
+                return task_floes.count(graph[source(e, graph)].floe) || task_floes.count(graph[target(e, graph)].floe);
+            }, graph);
+        }
+        return tasks;
+    }
+
 private:
     // floe_distrib_type m_floe_process_distribution;
     // floe_distrib_type m_border_floe_process_distribution;
@@ -23,9 +23,31 @@
 #include "floe/geometry/geometries/circle.hpp"
 #include "floe/geometry/geometries/multi_circle.hpp"
 
+// Oriented boxes
+#include "floe/geometry/geometries/oriented_box.hpp"
+
+#include <cstddef>
+#include <vector>
+
 namespace floe { namespace collision { namespace matlab
 {
 
+/*! Convex polygon over some points of a floe boundary
+ *
+ * Indices of its vertices in the boundary (counter-clockwise) and lengths of its edges,
+ * both invariant by the floe motion.
+ *
+ * \tparam T Real type.
+ */
+template <
+    typename T
+>
+struct BoundaryHull
+{
+    std::vector<std::size_t> ids;   //!< Boundary indices of the vertices
+    std::vector<T> lengths;         //!< Edge lengths (edge k goes from vertex k to vertex k+1)
+};
+
 /*! Minimal interface for optimized floe
  *
  *
@@ -45,13 +67,22 @@ public:
     using multi_circle_type = floe::geometry::MultiCircle<circle_type>;
     using local_points_type = std::vector<std::size_t>;
     using real_type = typename floe_type::real_type;
+    using box_type = floe::geometry::OrientedBox<point_type>;
+    using hull_type = BoundaryHull<real_type>;
+    using multi_hull_type = std::vector<hull_type>;
 
     //! Global disk accessor
     virtual circle_type const& global_disk() const = 0;
+    //! Global oriented box accessor (minimal area box of the floe convex hull)
+    virtual box_type const& global_box() const = 0;
     //! Local disks accessor
     virtual multi_circle_type const& local_disks()   const = 0;
     //! Local points accessor
     virtual local_points_type const& local_points() const = 0;
+    //! Convex hull accessor
+    virtual hull_type const& hull() const = 0;
+    //! Local hulls accessor (convex hull of the boundary points of each local disk)
+    virtual multi_hull_type const& local_hulls() const = 0;
 
     //! Contact distance accessor
     virtual real_type const&         cdist() const = 0;
@@ -23,11 +23,15 @@
 // Frames
 #include "floe/geometry/frame/uv_frame.hpp"
 #include "floe/geometry/frame/frame_transformers.hpp"
+#include "floe/geometry/frame/batch_transform.hpp"
 
 // Circles
 #include "floe/geometry/geometries/circle.hpp"
 #include "floe/geometry/geometries/multi_circle.hpp"
 
+// Oriented boxes
+#include "floe/geometry/algorithms/oriented_box.hpp"
+
 #include "floe/collision/matlab/optim_interface.hpp"
 
 namespace floe { namespace collision { namespace matlab
@@ -54,6 +58,9 @@ public:
     using point_type = typename optim_interface_type::point_type;
     using circle_type = typename optim_interface_type::circle_type;
     using multi_circle_type = typename optim_interface_type::multi_circle_type;
+    using box_type = typename optim_interface_type::box_type;
+    using hull_type = typename optim_interface_type::hull_type;
+    using multi_hull_type = typename optim_interface_type::multi_hull_type;
     using local_points_type = typename optim_interface_type::local_points_type;
     using real_type = typename optim_interface_type::real_type;
 
@@ -85,6 +92,10 @@ public:
     inline circle_type const&   global_disk()   const   { return m_global_disk; }
     inline circle_type &        global_disk()           { return m_global_disk; }
 
+    //! Global oriented box accessors
+    inline box_type const&      global_box()    const   { return m_global_box; }
+    inline box_type &           global_box()            { return m_global_box; }
+
     //! Local disks accessors
     inline multi_circle_type const& local_disks()   const   { return m_local_disks; }
     inline multi_circle_type &      local_disks()           { return m_local_disks; }
@@ -93,6 +104,11 @@ public:
     inline local_points_type const& local_points()  const   { return m_local_points; }
     inline local_points_type &      local_points()          { return m_local_points; }
 
+    //! Convex hull accessor
+    inline hull_type const&         hull()          const   { return m_hull; }
+    //! Local hulls accessor
+    inline multi_hull_type const&   local_hulls()   const   { return m_local_hulls; }
+
     real_type const&         cdist() const { return m_cdist; }
     real_type const&         tau() const { return m_tau; }
     real_type          m_cdist;        //!< Collision distance
@@ -102,8 +118,11 @@ private:
     floe_type const&    m_floe; //!< Floe
     frame_type          m_frame; //!< Current frame
     circle_type         m_global_disk;  //!< The surrounding disk
+    box_type            m_global_box;   //!< The surrounding oriented box (tighter than the disk for elongated floes)
     multi_circle_type   m_local_disks;  //!< The local disks (surrounding the border)
     local_points_type   m_local_points; //!< Index of first point of the border that is in the corresponding local disk
+    hull_type           m_hull;         //!< Convex hull of the border
+    multi_hull_type     m_local_hulls;  //!< Convex hull of the border points of each local disk
 
     /*! Optimizer initialization
      *
@@ -147,6 +166,29 @@ TCircle circle_envelope ( TMultiPoint const& points )
 }
 
 
+/*! Return convex hull of some points of a ring, as a BoundaryHull
+ *
+ * \param ring      The ring.
+ * \param point_ids Indices of the points in the ring.
+ */
+template <
+    typename THull,
+    typename TRing
+>
+THull boundary_hull ( TRing const& ring, std::vector<std::size_t> const& point_ids )
+{
+    std::vector<typename TRing::value_type> points;
+    for ( std::size_t id : point_ids )
+        points.push_back( ring[id] );
+
+    THull hull;
+    for ( std::size_t i : geometry::convex_hull_indices(points) )
+        hull.ids.push_back( point_ids[i] );
+    for ( std::size_t k = 0; k < hull.ids.size(); ++k )
+        hull.lengths.push_back( geometry::distance( ring[hull.ids[k]], ring[hull.ids[(k + 1) % hull.ids.size()]] ) );
+    return hull;
+}
+
 /*! Initializing local disks and surround disk
  */
 template< typename TFloe >
@@ -207,6 +249,24 @@ OptimizedFloe<TFloe>::init()
     m_tau = max_radius + max_radius/5; // ??? (see create_disk.m, l.16)
     //m_global_disk = return_buffer<circle_type>( circle_envelope<circle_type>(points), m_tau );
     m_global_disk = return_buffer<circle_type>( circle_envelope<circle_type>(boundary), m_tau );
+
+    //// Surrounding oriented box ////
+    m_global_box = oriented_box_envelope<point_type>(boundary);
+
+    //// Convex hulls (separating axis tests) ////
+    std::vector<std::size_t> point_ids(n_points);
+    for ( std::size_t i = 0; i < n_points; ++i )
+        point_ids[i] = i;
+    m_hull = boundary_hull<hull_type>(boundary, point_ids);
+
+    m_local_hulls.resize(0);
+    for ( std::size_t k = 0; k + 1 < m_local_points.size(); ++k )
+    {
+        point_ids.resize(0);
+        for ( std::size_t i = m_local_points[k]; i <= m_local_points[k+1]; ++i )
+            point_ids.push_back( (i < n_points) ? i : i - n_points );
+        m_local_hulls.push_back( boundary_hull<hull_type>(boundary, point_ids) );
+    }
 }
 
 //! Update optimization datas.
@@ -218,14 +278,17 @@ OptimizedFloe<TFloe>::update(bool update_local_disks)
     const auto new_frame = m_floe.frame();
 
     // Transformation from current frame to new frame
-    const auto trans = geometry::frame::itransformer( m_frame, new_frame );
+    const auto trans = geometry::frame::rigid_itransformer( m_frame, new_frame );
 
     // Transforming global disk
-    geometry::transform( m_global_disk, m_global_disk, trans );
+    geometry::frame::transform_circle( m_global_disk, m_global_disk, trans );
+
+    // Transforming global box
+    geometry::frame::transform_oriented_box( m_global_box, m_global_box, trans );
 
     if (update_local_disks){
         // Transforming local disks
-        geometry::transform( m_local_disks, m_local_disks, trans );
+        geometry::frame::transform_circles( m_local_disks, m_local_disks, trans );
     }
 
     m_frame = new_frame;
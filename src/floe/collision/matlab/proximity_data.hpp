@@ -93,6 +93,8 @@ public:
     inline floe_type const& get_floe(std::size_t n) const { return get_floes()[n]; }
     // inline optim_type& get_optim(std::size_t n) const { return *(m_optims[n]); }
     inline optim_type& get_optim(std::size_t n) const { return *(m_optims[m_floe_group->absolute_id(n)]); }
+    //! Storage index of the floe n
+    inline std::size_t absolute_id(std::size_t n) const { return m_floe_group->absolute_id(n); }
     inline virtual std::size_t real_floe_id(std::size_t n) const { return n; }
 
     //! interpenetration bool accessor (true if no interpenetration)
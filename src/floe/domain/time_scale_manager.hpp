@@ -167,15 +167,6 @@ TimeScaleManager<TDetector>::delta_t_secu(
     // calcul ceinture de points: (pour la rotation)
     auto D1 = (distance(C1, G1) + R1 - tau1);
     auto D2 = (distance(C2,G2) + R2 - tau2);
-    multi_point_type Belt_P1, Belt_P2;
-    for (int i=0; i<50; ++i)
-    {
-        auto angle = 2 * i *  M_PI / 50;
-        Belt_P1.push_back(point_type{D1 * cos(angle), D1 * sin(angle)});
-        Belt_P2.push_back(point_type{D2 * cos(angle), D2 * sin(angle)});
-    }
-
-    multi_point_type Belt_P1_be, Belt_P2_be, Belt_P1_af, Belt_P2_af;
 
     using namespace geometry::frame; // import transformer, itransformer
     /*
@@ -193,17 +184,23 @@ TimeScaleManager<TDetector>::delta_t_secu(
     // version raccourcie
     */
 
-    // Version 2
-    geometry::transform( Belt_P1, Belt_P1_be, transformer( frame_type{G1, 0} ));
-    geometry::transform( Belt_P2, Belt_P2_be, transformer( frame_type{G2, 0} ));
-    geometry::transform( Belt_P1, Belt_P1_af, transformer( mark1 ));
-    geometry::transform( Belt_P2, Belt_P2_af, transformer( mark2 ));
-    
+    // Version 2 (belt points transformed one by one: no allocation in this pairwise loop)
+    const auto trans1_be = transformer( frame_type{G1, 0} ), trans2_be = transformer( frame_type{G2, 0} );
+    const auto trans1_af = transformer( mark1 ), trans2_af = transformer( mark2 );
+
     real_type dist1 = 0, dist2 = 0;
-    for (std::size_t i = 0; i != Belt_P1.size(); ++i)
-        dist1 = std::max(dist1, distance(Belt_P1_be[i], Belt_P1_af[i]));
-    for (std::size_t i = 0; i != Belt_P2.size(); ++i)
-        dist2 = std::max(dist2, distance(Belt_P2_be[i], Belt_P2_af[i]));
+    for (int i=0; i<50; ++i)
+    {
+        auto angle = 2 * i *  M_PI / 50;
+        const point_type P1{D1 * cos(angle), D1 * sin(angle)}, P2{D2 * cos(angle), D2 * sin(angle)};
+        point_type P_be, P_af;
+        geometry::transform( P1, P_be, trans1_be );
+        geometry::transform( P1, P_af, trans1_af );
+        dist1 = std::max(dist1, distance(P_be, P_af));
+        geometry::transform( P2, P_be, trans2_be );
+        geometry::transform( P2, P_af, trans2_af );
+        dist2 = std::max(dist2, distance(P_be, P_af));
+    }
     // END Version 2
     
 
@@ -12,8 +12,11 @@
 #endif
 
  #include <iostream> // DEBUG
+#include <array>
 #include <random>
 
+#include "floe/dynamics/subgrid_ice.hpp"
+
 
 namespace floe { namespace dynamics
 {
@@ -36,6 +39,7 @@ public:
     using point_type = typename floe_type::point_type;
     using real_type = typename floe_type::real_type;
     using state_type = typename floe_type::state_type;
+    using subgrid_ice_type = SubgridIceField<point_type>;
 
     //! Constructor
     DynamicsManager(real_type const& time_ref, int OBL_status) : m_external_forces{time_ref}, m_ocean_window_area{0},
@@ -45,11 +49,25 @@ public:
     point_type move_floes(floe_group_type& floe_group, real_type delta_t);
     //! Ocean state update, returns difference speed applied
     point_type update_ocean(floe_group_type& floe_group, real_type delta_t, point_type floes_force = {0,0});
+    //! Gridded OBL state update (OBL status 2), returns the total force of the ocean on floes
+    point_type update_gridded_ocean(floe_group_type& floe_group, real_type delta_t);
+    /*! Convert the floes smaller than the sub-grid area into continuum ice (see SubgridIceField)
+     *
+     * The converted floes are desactivated: the floe group active list has to be updated afterwards.
+     * \return the number of converted floes.
+     */
+    std::size_t absorb_small_floes(floe_group_type& floe_group);
+    //! Sub-grid ice update and momentum exchange with the floes
+    void update_subgrid_ice(floe_group_type& floe_group, real_type delta_t);
 
     //! Load ocean and wind data from a topaz file
     inline void load_matlab_topaz_data(std::string const& filename) {
         m_external_forces.load_matlab_topaz_data(filename);
     }
+    //! Use ocean and wind data from a forcing series file, read by windows of hours
+    inline void load_forcing_series(std::string const& filename, std::size_t window_hours) {
+        m_external_forces.load_forcing_series(filename, window_hours);
+    }
 
     //! Load ocean window area (box surrounding floes)
     void load_matlab_ocean_window_data(std::string const& filename, floe_group_type const& floe_group);
@@ -59,12 +77,22 @@ public:
     inline void set_OBL_speed(point_type OBL_speed) { 
         return this->m_external_forces.get_physical_data().set_OBL_speed(OBL_speed); }
     inline void set_OBL_status(int status) { m_OBL_status = status; }
+    //! Number of cells of the gridded OBL along x and y
+    inline void set_OBL_grid_size(std::size_t nx, std::size_t ny) { m_OBL_grid_size = {{nx, ny}}; }
     //! Ocean window area setter
     inline void set_ocean_window_area(real_type area) { m_ocean_window_area = area; }
 
     //!< extra random velocities
     inline void set_rand_speed_add(bool rand_speed_add) {m_rand_speed_add = rand_speed_add;}
     inline void set_norm_rand_speed(real_type rand_norm) {m_rand_norm = rand_norm;}
+    inline void set_random_seed(unsigned seed) {m_random_generator.seed(seed);}
+    //! Linearised implicit drag (stable whatever the floe size and the time step)
+    inline void set_implicit_drag(bool implicit_drag) { m_implicit_drag = implicit_drag; }
+    //! Floes with an area lower than min_area become sub-grid ice, on a grid of nx * ny cells (0 disables it)
+    inline void set_subgrid(real_type min_area, std::size_t nx, std::size_t ny) {
+        m_subgrid_area = min_area; m_subgrid_grid_size = {{nx, ny}}; }
+    inline bool subgrid_enabled() const { return m_subgrid_area > 0; }
+    inline subgrid_ice_type const& get_subgrid_ice() const { return m_subgrid_ice; }
 
     //! Accessor for specific use
     external_forces_type& get_external_forces() { return m_external_forces; }
@@ -73,11 +101,19 @@ protected:
 
     external_forces_type m_external_forces; //! External forces manager
     real_type m_ocean_window_area; //! Ocean window area (for OBL computing)
-    int m_OBL_status; //! OBL (Oceanic Boundary Layer) status : 0 = no coupling, 1 = coupling
+    int m_OBL_status; //! OBL (Oceanic Boundary Layer) status : 0 = no coupling, 1 = coupling, 2 = gridded coupling
+    std::array<std::size_t, 2> m_OBL_grid_size{{8, 8}}; //! Number of cells of the gridded OBL along x and y
     std::default_random_engine m_random_generator;
 
     bool m_rand_speed_add; //!< extra random velocities 
     real_type m_rand_norm; //!< norm of these extra random velocities
+    bool m_implicit_drag{false}; //!< linearised implicit drag instead of explicit one
+    real_type m_subgrid_area{0}; //!< floes under this area are converted into sub-grid ice
+    std::array<std::size_t, 2> m_subgrid_grid_size{{16, 16}}; //!< number of cells of the sub-grid ice along x and y
+    subgrid_ice_type m_subgrid_ice; //!< continuum ice made of the small floes
+
+    //! Speed and rotation increments due to drag and Coriolis effect, by a linearised backward Euler step
+    void implicit_drag_update(floe_type& floe, real_type delta_t, state_type& new_state);
 
     //! Move one floe
     virtual void move_floe(floe_type& floe, real_type delta_t);
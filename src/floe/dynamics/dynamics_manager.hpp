@@ -34,10 +34,13 @@ DynamicsManager<TExternalForces, TFloeGroup>::move_floes(floe_group_type& floe_g
     // for (auto& floe : floe_group.get_floes())
     //     move_floe(floe, delta_t);
 
+    m_external_forces.update_forcing(); // forcing window loaded before the parallel reads
     #pragma omp parallel for
     for (std::size_t i=0; i < floe_group.get_floes().size(); ++i){
         this->move_floe(floe_group.get_floes()[i], delta_t);
     }
+    if (m_subgrid_ice.is_initialized())
+        this->update_subgrid_ice(floe_group, delta_t);
     return this->update_ocean(floe_group, delta_t);
 }
 
@@ -52,22 +55,26 @@ DynamicsManager<TExternalForces, TFloeGroup>::move_floe(floe_type& floe, real_ty
     new_state.theta += delta_t * floe.state().rot;
 
     if (!floe.is_obstacle()) { // Obstacles do not react to external forces
-        // Translation part
-        auto drag_force = floe::integration::integrate(
-            m_external_forces.total_drag(floe),
-            floe.mesh(),
-            integration_strategy<real_type>()
-        );
-        new_state.speed += ( delta_t / floe.mass() ) * drag_force
-                            + delta_t * m_external_forces.coriolis_effect(floe);
-
-        // Rotation part
-        auto rot_drag_force = floe::integration::integrate(
-            m_external_forces.total_rot_drag(floe),
-            floe.mesh(),
-            integration_strategy<real_type>()
-        );
-        new_state.rot += ( delta_t / floe.moment_cst() ) * rot_drag_force;
+        if (m_implicit_drag) {
+            implicit_drag_update(floe, delta_t, new_state);
+        } else {
+            // Translation part
+            auto drag_force = floe::integration::integrate(
+                m_external_forces.total_drag(floe),
+                floe.mesh(),
+                integration_strategy<real_type>()
+            );
+            new_state.speed += ( delta_t / floe.mass() ) * drag_force
+                                + delta_t * m_external_forces.coriolis_effect(floe);
+
+            // Rotation part
+            auto rot_drag_force = floe::integration::integrate(
+                m_external_forces.total_rot_drag(floe),
+                floe.mesh(),
+                integration_strategy<real_type>()
+            );
+            new_state.rot += ( delta_t / floe.moment_cst() ) * rot_drag_force;
+        }
 
         /* Adding random perturbation to speed and rot
         (improve collision computing, physically justifiable) */
@@ -93,6 +100,43 @@ DynamicsManager<TExternalForces, TFloeGroup>::move_floe(floe_type& floe, real_ty
 }
 
 
+template <typename TExternalForces, typename TFloeGroup>
+void
+DynamicsManager<TExternalForces, TFloeGroup>::implicit_drag_update(floe_type& floe, real_type delta_t, state_type& new_state)
+{
+    // Drag and its Jacobian at the current speed, in one pass over the mesh
+    auto drag = floe::integration::integrate(
+        m_external_forces.total_generalized_drag(floe),
+        floe.mesh(),
+        integration_strategy<real_type>()
+    );
+    auto const& P = drag.jacobian;
+    const point_type coriolis = floe.mass() * m_external_forces.coriolis_effect(floe);
+
+    // (M + delta_t P) dX = delta_t (F + coriolis): symmetric positive definite, solved by cofactors
+    const real_type a00 = floe.mass() + delta_t * P[0], a01 = delta_t * P[1], a02 = delta_t * P[2];
+    const real_type a11 = floe.mass() + delta_t * P[3], a12 = delta_t * P[4];
+    const real_type a22 = floe.moment_cst() + delta_t * P[5];
+    const real_type b0 = delta_t * (drag.force[0] + coriolis.x);
+    const real_type b1 = delta_t * (drag.force[1] + coriolis.y);
+    const real_type b2 = delta_t * drag.force[2];
+
+    const real_type c00 = a11 * a22 - a12 * a12;
+    const real_type c01 = a02 * a12 - a01 * a22;
+    const real_type c02 = a01 * a12 - a02 * a11;
+    const real_type c11 = a00 * a22 - a02 * a02;
+    const real_type c12 = a01 * a02 - a00 * a12;
+    const real_type c22 = a00 * a11 - a01 * a01;
+    const real_type det = a00 * c00 + a01 * c01 + a02 * c02;
+
+    new_state.speed += point_type{
+        (c00 * b0 + c01 * b1 + c02 * b2) / det,
+        (c01 * b0 + c11 * b1 + c12 * b2) / det
+    };
+    new_state.rot += (c02 * b0 + c12 * b1 + c22 * b2) / det;
+}
+
+
 template <typename TExternalForces, typename TFloeGroup>
 typename TFloeGroup::floe_type::point_type
 DynamicsManager<TExternalForces, TFloeGroup>::update_ocean(
@@ -100,6 +144,10 @@ DynamicsManager<TExternalForces, TFloeGroup>::update_ocean(
     real_type delta_t,
     point_type floes_force
 ){
+    // The gridded OBL needs the floes (not a precomputed total force, as given by the MPI master)
+    if (m_OBL_status == 2 && floes_force == point_type{0,0})
+        return update_gridded_ocean(floe_group, delta_t);
+
     point_type diff_speed{0,0};
     if (m_OBL_status)
     {
@@ -128,6 +176,106 @@ DynamicsManager<TExternalForces, TFloeGroup>::update_ocean(
     return floes_force;
 }
 
+template <typename TExternalForces, typename TFloeGroup>
+typename TFloeGroup::floe_type::point_type
+DynamicsManager<TExternalForces, TFloeGroup>::update_gridded_ocean(floe_group_type& floe_group, real_type delta_t)
+{
+    namespace fg = floe::geometry;
+    auto& grid = m_external_forces.get_physical_data().get_OBL_grid();
+    if (!grid.is_initialized())
+        grid.init(floe_group.bounding_window(0), m_OBL_grid_size[0], m_OBL_grid_size[1], m_external_forces.OBL_speed());
+
+    // Floes action on ocean, scattered per mesh triangle into the cell of its centroid
+    auto& floes = floe_group.get_floes();
+    #pragma omp parallel
+    {
+        // one accumulator per thread of the actual team (a single one when nested in an ensemble member)
+        #pragma omp single
+        {
+            #ifdef _OPENMP
+            grid.reset_accumulators(omp_get_num_threads());
+            #else
+            grid.reset_accumulators(1);
+            #endif
+        }
+        #pragma omp for
+        for (std::size_t i = 0; i < floes.size(); ++i)
+        {
+            #ifdef _OPENMP
+            const std::size_t thread = omp_get_thread_num();
+            #else
+            const std::size_t thread = 0;
+            #endif
+            auto& floe = floes[i];
+            auto const strategy = integration_strategy<real_type>();
+            auto const drag = m_external_forces.ocean_drag_2(floe);
+            for (auto const& triangle : fg::cells(floe.mesh()))
+            {
+                const point_type centroid{
+                    (fg::get<0,0>(triangle) + fg::get<1,0>(triangle) + fg::get<2,0>(triangle)) / 3,
+                    (fg::get<0,1>(triangle) + fg::get<1,1>(triangle) + fg::get<2,1>(triangle)) / 3
+                };
+                grid.add_contribution(
+                    thread, centroid,
+                    floe::integration::integrate(drag, triangle, strategy),
+                    floe::integration::integrate([](real_type, real_type) { return real_type(1); }, triangle, strategy)
+                );
+            }
+        }
+    }
+    grid.reduce();
+
+    // Water speed update, per cell
+    const real_type OBL_mass = grid.cell_area() * m_external_forces.OBL_surface_mass();
+    const point_type air_drag = m_external_forces.air_drag_ocean();
+    point_type floes_force{0, 0};
+    for (std::size_t c = 0; c < grid.nb_cells(); ++c)
+    {
+        const point_type center = grid.cell_center(c);
+        const real_type water_area = std::max(real_type(0), grid.cell_area() - grid.cell_floe_area(c));
+        grid.cell_speed(c) += delta_t * (
+            ( 1 / OBL_mass ) * ( - grid.cell_force(c) + water_area * air_drag )
+            + m_external_forces.local_ocean_coriolis(center)
+            + m_external_forces.local_deep_ocean_friction(center)
+        );
+        floes_force += grid.cell_force(c);
+    }
+    return floes_force;
+}
+
+template <typename TExternalForces, typename TFloeGroup>
+std::size_t
+DynamicsManager<TExternalForces, TFloeGroup>::absorb_small_floes(floe_group_type& floe_group)
+{
+    std::size_t nb_absorbed = 0;
+    for (auto& floe : floe_group.get_floes())
+    {
+        if (floe.is_obstacle() || !floe.state().is_active() || !(floe.area() < m_subgrid_area)) continue;
+        if (!m_subgrid_ice.is_initialized())
+            m_subgrid_ice.init(floe_group.bounding_window(0), m_subgrid_grid_size[0], m_subgrid_grid_size[1]);
+        m_subgrid_ice.absorb(floe.state().pos, floe.area(), floe.mass(), floe.state().speed);
+        floe.state().desactivate();
+        ++nb_absorbed;
+    }
+    return nb_absorbed;
+}
+
+template <typename TExternalForces, typename TFloeGroup>
+void
+DynamicsManager<TExternalForces, TFloeGroup>::update_subgrid_ice(floe_group_type& floe_group, real_type delta_t)
+{
+    m_subgrid_ice.step(delta_t, [this](point_type p, point_type v, real_type m) {
+        return m_external_forces.ice_field_forcing(p, v, m);
+    });
+    // drag and pressure exchange with the floes (sequential: floes of a same cell share its momentum)
+    for (auto& floe : floe_group.get_floes())
+    {
+        if (floe.is_obstacle()) continue;
+        auto& state = floe.state();
+        state.speed += m_subgrid_ice.exchange(state.pos, floe.area(), floe.mass(), state.speed, delta_t) / floe.mass();
+    }
+}
+
 template <typename TExternalForces, typename TFloeGroup>
 void
 DynamicsManager<TExternalForces, TFloeGroup>::load_matlab_ocean_window_data(std::string const& filename, floe_group_type const& floe_group)
@@ -10,7 +10,10 @@
 
 #include "floe/geometry/arithmetic/arithmetic.hpp"
 #include "floe/geometry/arithmetic/point_operators.hpp"
+#include <array>
 #include <cmath>
+#include <functional>
+#include <utility>
 
 
 namespace floe { namespace dynamics
@@ -24,6 +27,33 @@ namespace floe { namespace dynamics
 
 namespace fg = floe::geometry;
 
+/*! GeneralizedDrag
+ *
+ * Drag acting on the floe's degrees of freedom (speed x, speed y, rotation) and its Jacobian.
+ * Integrable over a floe mesh (zero default value, sum and product by a scalar).
+ *
+ */
+template <typename T>
+struct GeneralizedDrag
+{
+    std::array<T, 3> force{{0, 0, 0}};                //!< drag force (x, y) and torque
+    std::array<T, 6> jacobian{{0, 0, 0, 0, 0, 0}};    //!< opposite of the force Jacobian (symmetric: xx, xy, xr, yy, yr, rr)
+
+    GeneralizedDrag& operator+=(GeneralizedDrag const& other)
+    {
+        for (std::size_t i = 0; i < 3; ++i) force[i] += other.force[i];
+        for (std::size_t i = 0; i < 6; ++i) jacobian[i] += other.jacobian[i];
+        return *this;
+    }
+    friend GeneralizedDrag operator+(GeneralizedDrag lhs, GeneralizedDrag const& rhs) { return lhs += rhs; }
+    friend GeneralizedDrag operator*(T a, GeneralizedDrag rhs)
+    {
+        for (auto& v : rhs.force) v *= a;
+        for (auto& v : rhs.jacobian) v *= a;
+        return rhs;
+    }
+};
+
 template <typename TFloe, typename TPhysicalData>
 class ExternalForces
 {
@@ -41,6 +71,8 @@ public:
     std::function<point_type (real_type, real_type)> total_drag(floe_type& floe);
     //! Sum of different rotational drag effects on a floe
     std::function<real_type (real_type, real_type)> total_rot_drag(floe_type& floe);
+    //! Sum of drag effects on the floe's degrees of freedom, with the Jacobian of the ocean drag (see GeneralizedDrag)
+    std::function<GeneralizedDrag<real_type> (real_type, real_type)> total_generalized_drag(floe_type& floe);
     //! Coriolis effect on a floe
     point_type coriolis_effect(floe_type& floe);
 
@@ -48,6 +80,12 @@ public:
     inline void load_matlab_topaz_data(std::string const& filename) {
         m_physical_data.load_matlab_topaz_data(filename);
     }
+    //! Use ocean and wind data from a forcing series file, read by windows of hours
+    inline void load_forcing_series(std::string const& filename, std::size_t window_hours) {
+        m_physical_data.load_forcing_series(filename, window_hours);
+    }
+    //! Prepare the forcing data of the current time
+    inline void update_forcing() { m_physical_data.update_forcing(); }
 
     //! Surface mass of Oceaninc Boundary Layer
     inline real_type OBL_surface_mass() const { return h_w * rho_w; }
@@ -67,6 +105,17 @@ public:
     point_type ocean_coriolis(point_type p);
     //! Deep ocean friction effect on ocean
     point_type deep_ocean_friction();
+    //! Coriolis effect on the ocean column at p (gridded OBL)
+    point_type local_ocean_coriolis(point_type p);
+    //! Deep ocean friction effect on the ocean column at p (gridded OBL)
+    point_type local_deep_ocean_friction(point_type p);
+
+    // SUB-GRID ICE
+    /*! Forcing on a unit area of continuum ice of surface mass m moving at speed v at p (see SubgridIceField::step)
+     *
+     * Air drag, Coriolis effect and ocean drag linearised at v: returns (F, K) with force ~ F - K v.
+     */
+    std::pair<point_type, real_type> ice_field_forcing(point_type p, point_type v, real_type m);
 
     //! Accessor for specific use
     physical_data_type& get_physical_data() { return m_physical_data; }
@@ -191,6 +240,41 @@ ExternalForces<TFloe, TPhysicalData>::total_rot_drag(floe_type& floe)
 }
 
 
+template <typename TFloe, typename TPhysicalData>
+std::function<GeneralizedDrag<value<TFloe>> (
+    value<TFloe>, value<TFloe>)>
+ExternalForces<TFloe, TPhysicalData>::total_generalized_drag(floe_type& floe)
+{
+    return [&](real_type x, real_type y)
+    {
+        auto& state = floe.state();
+        point_type p{x,y};
+        // Speed at p is B (speed, rot) with B = [Id | r_orth]
+        const point_type r_orth = fg::direct_orthogonal(p - state.pos);
+        const point_type V = water_speed(p) - state.speed - state.rot * r_orth;
+        const real_type coef = rho_w * floe.static_floe().C_w();
+        const real_type nV = norm2(V);
+        const point_type F = coef * nV * V + air_drag()(p);
+
+        GeneralizedDrag<real_type> drag;
+        drag.force = {{ F.x, F.y, r_orth.x * F.x + r_orth.y * F.y }};
+        if (nV > 0)
+        {
+            // d(|V| V)/dV = |V| Id + V V^T / |V| = K, and the Jacobian is - B^T coef K B
+            const real_type a = coef * (nV + V.x * V.x / nV);
+            const real_type b = coef * V.x * V.y / nV;
+            const real_type c = coef * (nV + V.y * V.y / nV);
+            drag.jacobian = {{
+                a, b, a * r_orth.x + b * r_orth.y,
+                c, b * r_orth.x + c * r_orth.y,
+                a * r_orth.x * r_orth.x + 2 * b * r_orth.x * r_orth.y + c * r_orth.y * r_orth.y
+            }};
+        }
+        return drag;
+    };
+}
+
+
 template <typename TFloe, typename TPhysicalData>
 typename ExternalForces<TFloe, TPhysicalData>::point_type
 ExternalForces<TFloe, TPhysicalData>::air_drag_ocean()
@@ -213,6 +297,32 @@ ExternalForces<TFloe, TPhysicalData>::deep_ocean_friction()
     return - ( gamma / h_w ) * m_physical_data.water_speed();
 }
 
+template <typename TFloe, typename TPhysicalData>
+typename ExternalForces<TFloe, TPhysicalData>::point_type
+ExternalForces<TFloe, TPhysicalData>::local_ocean_coriolis(point_type p)
+{   
+    return - coriolis_coeff(p) * fg::direct_orthogonal(m_physical_data.water_speed(p));
+}
+
+template <typename TFloe, typename TPhysicalData>
+typename ExternalForces<TFloe, TPhysicalData>::point_type
+ExternalForces<TFloe, TPhysicalData>::local_deep_ocean_friction(point_type p)
+{   
+    return - ( gamma / h_w ) * m_physical_data.water_speed(p);
+}
+
+template <typename TFloe, typename TPhysicalData>
+std::pair<typename TFloe::point_type, typename TFloe::real_type>
+ExternalForces<TFloe, TPhysicalData>::ice_field_forcing(point_type p, point_type v, real_type m)
+{
+    const point_type water = water_speed(p), air = air_speed(p);
+    const real_type K = rho_w * C_w * norm2(water - v);
+    return {
+        K * water + rho_a * C_a * norm2(air) * air - m * coriolis_coeff(p) * fg::direct_orthogonal(v),
+        K
+    };
+}
+
 
 }} // namespace floe::dynamics
 
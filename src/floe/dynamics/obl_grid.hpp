@@ -0,0 +1,149 @@
+/*!
+ * \file dynamics/obl_grid.hpp
+ * \brief Coupling grid for a spatially resolved Oceanic Boundary Layer
+ */
+
+#ifndef OPE_OBL_GRID_HPP
+#define OPE_OBL_GRID_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+namespace floe { namespace dynamics
+{
+
+/*! OBLGrid
+ *
+ * Regular grid over the ocean window, storing the OBL speed correction (compared to geostrophic data) of each cell.
+ * Floes' drag is scattered into the cells through one accumulator per thread, summed by reduce().
+ * Points outside the grid belong to the nearest border cell.
+ *
+ */
+template <typename TPoint>
+class OBLGrid
+{
+
+public:
+    using point_type = TPoint;
+    using real_type = decltype(TPoint::x);
+    using window_type = std::array<real_type, 4>; //!< min x, max x, min y, max y
+
+    OBLGrid() : m_window{{0, 0, 0, 0}}, m_nx{0}, m_ny{0}, m_dx{1}, m_dy{1} {}
+
+    /*! Grid initialization
+     *
+     * \param window    grid extent (min x, max x, min y, max y).
+     * \param nx, ny    number of cells along x and y.
+     * \param speed     initial OBL speed correction of every cell.
+     */
+    void init(window_type const& window, std::size_t nx, std::size_t ny, point_type speed)
+    {
+        m_window = window;
+        m_nx = std::max(nx, std::size_t(1));
+        m_ny = std::max(ny, std::size_t(1));
+        m_dx = (window[1] > window[0]) ? (window[1] - window[0]) / m_nx : 1;
+        m_dy = (window[3] > window[2]) ? (window[3] - window[2]) / m_ny : 1;
+        m_speed.assign(nb_cells(), speed);
+        m_force.assign(nb_cells(), point_type{0, 0});
+        m_floe_area.assign(nb_cells(), 0);
+    }
+
+    inline bool is_initialized() const { return !m_speed.empty(); }
+    inline std::size_t nb_cells() const { return m_nx * m_ny; }
+    inline real_type cell_area() const { return m_dx * m_dy; }
+
+    //! Index of the cell containing p
+    inline std::size_t cell_index(point_type const& p) const
+    {
+        const std::size_t i = clamp_index((p.x - m_window[0]) / m_dx, m_nx);
+        const std::size_t j = clamp_index((p.y - m_window[2]) / m_dy, m_ny);
+        return j * m_nx + i;
+    }
+    inline point_type cell_center(std::size_t c) const
+    {
+        return { m_window[0] + (c % m_nx + real_type(0.5)) * m_dx, m_window[2] + (c / m_nx + real_type(0.5)) * m_dy };
+    }
+
+    //! OBL speed correction at p
+    inline point_type const& speed(point_type const& p) const { return m_speed[cell_index(p)]; }
+    inline point_type& cell_speed(std::size_t c) { return m_speed[c]; }
+    //! Mean OBL speed correction (for output)
+    point_type mean_speed() const
+    {
+        point_type sum{0, 0};
+        for (auto const& s : m_speed) sum += s;
+        return (nb_cells() != 0) ? sum / real_type(nb_cells()) : sum;
+    }
+    //! Set every cell speed correction
+    void set_speed(point_type speed) { std::fill(m_speed.begin(), m_speed.end(), speed); }
+
+    //! Clear the accumulators (one per thread)
+    void reset_accumulators(std::size_t nb_threads)
+    {
+        m_thread_force.resize(nb_threads);
+        m_thread_area.resize(nb_threads);
+        for (std::size_t t = 0; t < nb_threads; ++t)
+        {
+            m_thread_force[t].assign(nb_cells(), point_type{0, 0});
+            m_thread_area[t].assign(nb_cells(), 0);
+        }
+    }
+    //! Accumulate the force applied by the ocean on a floe part of area "area" located at p
+    inline void add_contribution(std::size_t thread, point_type const& p, point_type const& force, real_type area)
+    {
+        const std::size_t c = cell_index(p);
+        m_thread_force[thread][c] += force;
+        m_thread_area[thread][c] += area;
+    }
+    //! Sum the accumulators of every thread
+    void reduce()
+    {
+        const std::size_t nb_threads = m_thread_force.size();
+        #pragma omp parallel for
+        for (std::size_t c = 0; c < nb_cells(); ++c)
+        {
+            point_type force{0, 0};
+            real_type area = 0;
+            for (std::size_t t = 0; t < nb_threads; ++t)
+            {
+                force += m_thread_force[t][c];
+                area += m_thread_area[t][c];
+            }
+            m_force[c] = force;
+            m_floe_area[c] = area;
+        }
+    }
+    //! Force applied by the ocean on the floes of a cell (after reduce)
+    inline point_type const& cell_force(std::size_t c) const { return m_force[c]; }
+    //! Floes' area inside a cell (after reduce)
+    inline real_type cell_floe_area(std::size_t c) const { return m_floe_area[c]; }
+
+private:
+    window_type m_window; //!< Grid extent
+    std::size_t m_nx, m_ny; //!< Number of cells along x and y
+    real_type m_dx, m_dy; //!< Cell size
+    std::vector<point_type> m_speed; //!< OBL speed correction per cell
+    std::vector<point_type> m_force; //!< Ocean force on floes per cell
+    std::vector<real_type> m_floe_area; //!< Floes' area per cell
+    std::vector<std::vector<point_type>> m_thread_force; //!< Per thread accumulators of m_force
+    std::vector<std::vector<real_type>> m_thread_area; //!< Per thread accumulators of m_floe_area
+
+    static inline std::size_t clamp_index(real_type x, std::size_t n)
+    {
+        if (!(x > 0)) return 0;
+        return std::min(static_cast<std::size_t>(x), n - 1);
+    }
+};
+
+
+}} // namespace floe::dynamics
+
+
+#endif // OPE_OBL_GRID_HPP
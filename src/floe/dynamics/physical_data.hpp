@@ -9,6 +9,8 @@
 
 #include "floe/geometry/arithmetic/point_operators.hpp"
 #include "floe/io/matlab/topaz_import.hpp"
+#include "floe/io/forcing_series.hpp"
+#include "floe/dynamics/obl_grid.hpp"
 #include <cmath>
 #include <vector>
 #include <iostream> // DEBUG
@@ -38,7 +40,7 @@ public:
     //! Constructor
     PhysicalData(real_type const& time_ref) :
         m_ocean_data_hours{}, m_air_data_hours{},
-        m_ocean_data_minutes{}, m_air_data_minutes{},
+        m_ocean_data_minutes{}, m_air_data_minutes{}, m_forcing_series{},
         m_time_ref{time_ref},
         m_geo_relative_water_speed{0, 0},
         m_window_width{1}, m_window_height{1},
@@ -52,11 +54,31 @@ public:
     point_type air_speed(point_type pt = {0,0});
     //! OBL update speed (m/s)
     void update_water_speed(point_type diff_speed);
-    //! OBL speed accessor for output (m/s)
-    inline point_type OBL_speed() const { return m_geo_relative_water_speed; }
-    void set_OBL_speed(point_type speed) { m_geo_relative_water_speed = speed; }
+    //! OBL speed accessor for output (m/s), mean of the coupling grid when the OBL is gridded
+    inline point_type OBL_speed() const {
+        return m_OBL_grid.is_initialized() ? m_OBL_grid.mean_speed() : m_geo_relative_water_speed; }
+    void set_OBL_speed(point_type speed) { m_geo_relative_water_speed = speed; m_OBL_grid.set_speed(speed); }
+    //! Coupling grid of the gridded OBL (used by water_speed once initialized)
+    inline OBLGrid<point_type>& get_OBL_grid() { return m_OBL_grid; }
     //! Load ocean and wind data from a topaz file
     void load_matlab_topaz_data(std::string const& filename);
+    //! Use the ocean and wind data loaded from a topaz file by another one (ensemble members: read once)
+    void copy_topaz_data(PhysicalData const& physical_data) {
+        m_ocean_data_hours = physical_data.m_ocean_data_hours;
+        m_air_data_hours = physical_data.m_air_data_hours;
+        m_ocean_data_minutes = physical_data.m_ocean_data_minutes;
+        m_air_data_minutes = physical_data.m_air_data_minutes;
+    }
+    /*! Use ocean and wind data from a forcing series file, keeping only a window of hours in memory
+     *
+     * \param filename     forcing series file (see floe::io::matlab::convert_topaz_to_forcing_series).
+     * \param window_hours number of hours per window.
+     */
+    void load_forcing_series(std::string const& filename, std::size_t window_hours) {
+        m_forcing_series.open(filename, window_hours);
+    }
+    //! Load the forcing series window of the current time (to be called before a parallel use of the speeds)
+    void update_forcing() { m_forcing_series.prepare(m_time_ref); }
     //! For modes depending on an artificial ocean window (generator)
     void set_window_size(real_type width, real_type height) {
         m_window_width = width;
@@ -124,9 +146,11 @@ private:
     point_vector m_air_data_hours; //!< Geostrophic datas
     point_vector m_ocean_data_minutes; //!< Geostrophic datas
     point_vector m_air_data_minutes; //!< Geostrophic datas
+    floe::io::ForcingSeries<point_type> m_forcing_series; //!< Geostrophic datas read by windows (if open)
     real_type const& m_time_ref; //!< reference to time variable in second
 
     point_type m_geo_relative_water_speed; //!< Water speed correction compared to geostrophic data
+    OBLGrid<point_type> m_OBL_grid; //!< Water speed correction per cell (gridded OBL)
 
     // window dimension (for generator)
     real_type m_window_width;
@@ -277,6 +301,8 @@ PhysicalData<TPoint>::water_speed(point_type pt) {
     } else {
         resp = get_speed(pt, m_water_mode, m_water_speed);
     }
+    if (m_OBL_grid.is_initialized())
+        return resp + m_OBL_grid.speed(pt);
     return resp + m_geo_relative_water_speed;
 }
 
@@ -354,6 +380,8 @@ PhysicalData<TPoint>::interpolate_hour_to_minute(point_vector const& data_hours,
 template <typename TPoint>
 TPoint
 PhysicalData<TPoint>::geostrophic_water_speed(point_type p){
+    if (m_forcing_series.is_open())
+        return m_forcing_series.ocean(m_time_ref);
     return minute_value(m_time_ref, m_ocean_data_minutes);
 }
 
@@ -361,6 +389,8 @@ PhysicalData<TPoint>::geostrophic_water_speed(point_type p){
 template <typename TPoint>
 TPoint
 PhysicalData<TPoint>::topaz_air_speed(point_type p){
+    if (m_forcing_series.is_open())
+        return m_forcing_series.air(m_time_ref);
     return minute_value(m_time_ref, m_air_data_minutes);
 }
 
@@ -372,7 +402,7 @@ PhysicalData<TPoint>::minute_value(real_type t, point_vector const& data_minutes
     if (minutes < data_minutes.size())
         return data_minutes[minutes];
     else
-        return data_minutes[-1];
+        return data_minutes.back();
 }
 
 
@@ -0,0 +1,241 @@
+/*!
+ * \file dynamics/subgrid_ice.hpp
+ * \brief Sub-grid continuum representation of the floes too small to be resolved
+ */
+
+#ifndef OPE_SUBGRID_ICE_HPP
+#define OPE_SUBGRID_ICE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+
+namespace floe { namespace dynamics
+{
+
+/*! SubgridIceField
+ *
+ * Regular grid storing, for each cell, the area, the mass and the momentum of the ice absorbed from small floes.
+ * Concentration, thickness and velocity of the continuum are deduced from them.
+ * Each step, the momentum is updated by the external forcing (semi-implicit drag) and by the internal pressure
+ * P = P* h exp(-C* (1 - A)) (Hibler), then area, mass and momentum are advected by a donor-cell scheme.
+ * The domain is closed: no ice leaves the grid window, and the total mass is conserved.
+ * Discrete floes exchange momentum with the continuum of their cell (see exchange).
+ *
+ */
+template <typename TPoint>
+class SubgridIceField
+{
+
+public:
+    using point_type = TPoint;
+    using real_type = decltype(TPoint::x);
+    using window_type = std::array<real_type, 4>; //!< min x, max x, min y, max y
+
+    SubgridIceField() : m_window{{0, 0, 0, 0}}, m_nx{0}, m_ny{0}, m_dx{1}, m_dy{1},
+                        m_density{917}, m_P_star{27.5e3}, m_C_star{20}, m_exchange_coef{1} {}
+
+    /*! Grid initialization
+     *
+     * \param window    grid extent (min x, max x, min y, max y).
+     * \param nx, ny    number of cells along x and y.
+     */
+    void init(window_type const& window, std::size_t nx, std::size_t ny)
+    {
+        m_window = window;
+        m_nx = std::max(nx, std::size_t(1));
+        m_ny = std::max(ny, std::size_t(1));
+        m_dx = (window[1] > window[0]) ? (window[1] - window[0]) / m_nx : 1;
+        m_dy = (window[3] > window[2]) ? (window[3] - window[2]) / m_ny : 1;
+        m_area.assign(nb_cells(), 0);
+        m_mass.assign(nb_cells(), 0);
+        m_momentum.assign(nb_cells(), point_type{0, 0});
+    }
+
+    inline bool is_initialized() const { return !m_area.empty(); }
+    inline std::size_t nb_cells() const { return m_nx * m_ny; }
+    inline real_type cell_area() const { return m_dx * m_dy; }
+    //! Linear drag coefficient (kg/m^2/s) of the momentum exchange with the discrete floes
+    inline void set_exchange_coef(real_type coef) { m_exchange_coef = coef; }
+
+    //! Index of the cell containing p (points outside the grid belong to the nearest border cell)
+    inline std::size_t cell_index(point_type const& p) const
+    {
+        const std::size_t i = clamp_index((p.x - m_window[0]) / m_dx, m_nx);
+        const std::size_t j = clamp_index((p.y - m_window[2]) / m_dy, m_ny);
+        return j * m_nx + i;
+    }
+    inline point_type cell_center(std::size_t c) const
+    {
+        return { m_window[0] + (c % m_nx + real_type(0.5)) * m_dx, m_window[2] + (c / m_nx + real_type(0.5)) * m_dy };
+    }
+
+    //! Continuum fields of a cell
+    inline real_type concentration(std::size_t c) const { return std::min(m_area[c] / cell_area(), real_type(1)); }
+    inline real_type thickness(std::size_t c) const { return (m_area[c] > 0) ? m_mass[c] / (m_density * m_area[c]) : 0; }
+    inline point_type velocity(std::size_t c) const { return (m_mass[c] > 0) ? m_momentum[c] / m_mass[c] : point_type{0, 0}; }
+    inline real_type cell_mass(std::size_t c) const { return m_mass[c]; }
+    //! Ice pressure (N/m) of a cell
+    inline real_type pressure(std::size_t c) const
+    {
+        return m_P_star * m_mass[c] / (m_density * cell_area()) * std::exp(-m_C_star * (1 - concentration(c)));
+    }
+    //! Total ice area, mass and momentum of the continuum
+    real_type total_area() const { return sum(m_area, real_type(0)); }
+    real_type total_mass() const { return sum(m_mass, real_type(0)); }
+    point_type total_momentum() const { return sum(m_momentum, point_type{0, 0}); }
+
+    //! Add the area, mass and momentum of a floe located at p
+    inline void absorb(point_type const& p, real_type area, real_type mass, point_type const& speed)
+    {
+        const std::size_t c = cell_index(p);
+        m_area[c] += area;
+        m_mass[c] += mass;
+        m_momentum[c] += speed * mass;
+    }
+
+    /*! Momentum exchange with a discrete floe (drag toward the continuum velocity and pressure)
+     *
+     * The drag k (v_c - v_f), with k = exchange_coef * concentration * area, is integrated exactly on delta_t
+     * for the pair (floe, cell continuum). The opposite impulse is applied to the continuum.
+     *
+     * \return the impulse received by the floe.
+     */
+    point_type exchange(point_type const& p, real_type area, real_type mass, point_type const& speed, real_type delta_t)
+    {
+        const std::size_t c = cell_index(p);
+        if (m_mass[c] <= 0) return {0, 0};
+        const real_type k = m_exchange_coef * concentration(c) * area;
+        const real_type inv_mass = 1 / mass + 1 / m_mass[c];
+        point_type impulse = (velocity(c) - speed) * ((1 - std::exp(-k * inv_mass * delta_t)) / inv_mass);
+        impulse -= pressure_gradient(c) * (delta_t * area);
+        m_momentum[c] -= impulse;
+        return impulse;
+    }
+
+    /*! Move the continuum forward in time
+     *
+     * \param delta_t   time step.
+     * \param forcing   forcing(p, v, surface_mass) returns a pair (F, K): the external force per unit area of ice moving
+     *                  at speed v at p is approximated by F - K v (K >= 0 is treated implicitly).
+     */
+    template <typename TForcing>
+    void step(real_type delta_t, TForcing&& forcing);
+
+private:
+    window_type m_window; //!< Grid extent
+    std::size_t m_nx, m_ny; //!< Number of cells along x and y
+    real_type m_dx, m_dy; //!< Cell size
+    real_type m_density; //!< (kg/m^3) Ice density
+    real_type m_P_star; //!< (N/m^2) Ice strength
+    real_type m_C_star; //!< Ice strength concentration dependence
+    real_type m_exchange_coef; //!< (kg/m^2/s) Drag coefficient between discrete floes and continuum
+    std::vector<real_type> m_area; //!< Ice area per cell
+    std::vector<real_type> m_mass; //!< Ice mass per cell
+    std::vector<point_type> m_momentum; //!< Ice momentum per cell
+
+    static inline std::size_t clamp_index(real_type x, std::size_t n)
+    {
+        if (!(x > 0)) return 0;
+        return std::min(static_cast<std::size_t>(x), n - 1);
+    }
+
+    template <typename TValue>
+    static TValue sum(std::vector<TValue> const& values, TValue init)
+    {
+        for (auto const& v : values) init += v;
+        return init;
+    }
+
+    //! Pressure gradient in a cell (centered differences, one-sided on the borders)
+    point_type pressure_gradient(std::size_t c) const
+    {
+        const std::size_t i = c % m_nx, j = c / m_nx;
+        const std::size_t ip = std::min(i + 1, m_nx - 1), im = (i > 0) ? i - 1 : 0;
+        const std::size_t jp = std::min(j + 1, m_ny - 1), jm = (j > 0) ? j - 1 : 0;
+        return {
+            (ip != im) ? (pressure(j * m_nx + ip) - pressure(j * m_nx + im)) / ((ip - im) * m_dx) : 0,
+            (jp != jm) ? (pressure(jp * m_nx + i) - pressure(jm * m_nx + i)) / ((jp - jm) * m_dy) : 0
+        };
+    }
+
+    //! Normal speed on the face between cells c1 and c2, along direction d (0 : x, 1 : y)
+    real_type face_speed(std::size_t c1, std::size_t c2, int d) const
+    {
+        const point_type v1 = velocity(c1), v2 = velocity(c2);
+        const real_type s1 = d ? v1.y : v1.x, s2 = d ? v2.y : v2.x;
+        if (m_mass[c1] > 0 && m_mass[c2] > 0) return (s1 + s2) / 2;
+        return (m_mass[c1] > 0) ? s1 : s2;
+    }
+};
+
+
+template <typename TPoint>
+template <typename TForcing>
+void
+SubgridIceField<TPoint>::step(real_type delta_t, TForcing&& forcing)
+{
+    const std::size_t N = nb_cells();
+
+    // Momentum update: external forcing (semi-implicit) and internal pressure
+    std::vector<point_type> pressure_force(N);
+    for (std::size_t c = 0; c < N; ++c)
+        pressure_force[c] = - cell_area() * pressure_gradient(c);
+    for (std::size_t c = 0; c < N; ++c)
+    {
+        if (m_mass[c] <= 0) continue;
+        const auto F_K = forcing(cell_center(c), velocity(c), m_mass[c] / m_area[c]);
+        m_momentum[c] = (m_momentum[c] + delta_t * (m_area[c] * F_K.first + pressure_force[c]))
+                        * (m_mass[c] / (m_mass[c] + delta_t * m_area[c] * F_K.second));
+    }
+
+    // Donor-cell advection: fraction of the donor cell content going through each face
+    // faces[d][c] is the face between c and its neighbour along +x (d = 0) or +y (d = 1)
+    std::array<std::vector<real_type>, 2> faces{{std::vector<real_type>(N, 0), std::vector<real_type>(N, 0)}};
+    std::vector<real_type> outflow(N, 0);
+    for (std::size_t c = 0; c < N; ++c)
+    {
+        const std::size_t i = c % m_nx, j = c / m_nx;
+        if (i + 1 < m_nx) faces[0][c] = face_speed(c, c + 1, 0) * delta_t / m_dx;
+        if (j + 1 < m_ny) faces[1][c] = face_speed(c, c + m_nx, 1) * delta_t / m_dy;
+        for (int d = 0; d < 2; ++d)
+        {
+            const std::size_t c2 = c + (d ? m_nx : 1);
+            if (faces[d][c] > 0) outflow[c] += faces[d][c];
+            else if (faces[d][c] < 0) outflow[c2] -= faces[d][c];
+        }
+    }
+    // no cell gives more than its content (positivity)
+    std::vector<real_type> limiter(N);
+    for (std::size_t c = 0; c < N; ++c)
+        limiter[c] = (outflow[c] > 1) ? 1 / outflow[c] : 1;
+
+    auto area = m_area;
+    auto mass = m_mass;
+    auto momentum = m_momentum;
+    for (std::size_t c = 0; c < N; ++c)
+        for (int d = 0; d < 2; ++d)
+        {
+            const real_type f = faces[d][c];
+            if (f == 0) continue;
+            const std::size_t c2 = c + (d ? m_nx : 1);
+            const std::size_t donor = (f > 0) ? c : c2, receiver = (f > 0) ? c2 : c;
+            const real_type frac = std::abs(f) * limiter[donor];
+            area[donor] -= frac * m_area[donor];        area[receiver] += frac * m_area[donor];
+            mass[donor] -= frac * m_mass[donor];        mass[receiver] += frac * m_mass[donor];
+            momentum[donor] -= frac * m_momentum[donor]; momentum[receiver] += frac * m_momentum[donor];
+        }
+    m_area = std::move(area);
+    m_mass = std::move(mass);
+    m_momentum = std::move(momentum);
+}
+
+
+}} // namespace floe::dynamics
+
+
+#endif // OPE_SUBGRID_ICE_HPP
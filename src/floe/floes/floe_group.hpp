@@ -15,8 +15,14 @@
 #include "floe/io/matlab/list_so_import.hpp"
 #include "floe/io/matlab/list_so.hpp"
 
+#include "floe/geometry/algorithms/simplify.hpp"
+
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
 #include <random>
+#include <stdexcept>
 
 namespace floe { namespace floes
 {
@@ -51,10 +57,26 @@ public:
     //! Load floes and initial states from matlab file
     void load_matlab_config(std::string filename);
     //! Load floes and initial states from hdf5 file
-    void load_h5_config(std::string filename);
+    void load_h5_config(std::string filename, bool generate_meshes = true);
     bool h5_contains_floes_characs(std::string filename);
     virtual void post_load_floe(){;}
 
+    /*! Simplify the high resolution floe boundaries and mesh them again (at load time)
+     *
+     * \param factor   max distance between the removed boundary points and the new boundary,
+     *                  in units of the floe contact distance (sqrt(area) / 100).
+     * \param slice, nb_slices  only the floes n with n % nb_slices == slice are simplified (e.g. one slice per process).
+     * \return  the number of removed boundary points.
+     */
+    std::size_t simplify_floe_shapes(real_type factor, std::size_t slice = 0, std::size_t nb_slices = 1);
+    /*! Uses the boundaries and meshes of the same floes in another floe group (no meshing)
+     *
+     * The meshes are not copied: the other floe group must outlive this one, and the floes must not be fractured.
+     */
+    void share_static_floes(FloeGroup& floe_group);
+    //! Keeps the storage the static floe geometries are attached to, until the floes are destroyed (see io::share_static_floes)
+    inline void keep_static_storage(std::shared_ptr<void> storage) { m_static_storage = std::move(storage); }
+
     // Accessors
     inline floe_group_h_type const& get_floe_group_h() const { return m_floe_group_h; }
     inline floe_group_h_type& get_floe_group_h() { return m_floe_group_h; }
@@ -122,15 +144,16 @@ public:
     //! Load saved previous time step floe states
     virtual void recover_previous_step_states();
     //! Set floes thickness to normal distributed random values around default
-    void randomize_floes_thickness(real_type coeff);
+    void randomize_floes_thickness(real_type coeff, unsigned seed = std::default_random_engine::default_seed);
 
     /*! random oceanic drag coefficient
      *  Set floes oceanic skin drag coeff to normal distributed random values around default.
      *  This is for simulating the heterogeneity of the floe bottom surface.  
      *
      * \param coeff     coefficient corresponding to the absolute max of the random values     
+     * \param seed      seed of the random values
      */
-    void randomize_floes_oceanic_skin_drag(real_type coeff);
+    void randomize_floes_oceanic_skin_drag(real_type coeff, unsigned seed = 1);
 
     virtual inline int absolute_id(int id) const { return id; }
     void set_min_thickness(real_type val) { m_min_thickness = val; }
@@ -142,6 +165,7 @@ public:
 
 protected:
 
+    std::shared_ptr<void> m_static_storage; //!< Storage of the static floe geometries, if not owned by the floes (destroyed after them)
     floe_list_type m_list_floe; //!< List of floes
     floe_group_h_type m_floe_group_h; //!< Discrete floe group (access to floes discretisation)
     //! initial reference window (min_x, max_x, min_y, max_y)
@@ -169,12 +193,77 @@ void FloeGroup<TFloe, TFloeList>::load_matlab_config(std::string filename) {
 };
 
 template <typename TFloe, typename TFloeList>
-void FloeGroup<TFloe, TFloeList>::load_h5_config(std::string filename) {
+void FloeGroup<TFloe, TFloeList>::load_h5_config(std::string filename, bool generate_meshes) {
     std::cout << "Reading \"" << filename << "\" ... " << std::endl;
-    floe::io::import_floes_from_hdf5(filename, *this);
+    floe::io::import_floes_from_hdf5(filename, *this, generate_meshes);
     this->post_load_floe();
 };
 
+template <typename TFloe, typename TFloeList>
+std::size_t FloeGroup<TFloe, TFloeList>::simplify_floe_shapes(real_type factor, std::size_t slice, std::size_t nb_slices) {
+    using geometry_type = typename floe_type::geometry_type;
+    using mesh_type = typename floe_type::mesh_type;
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t nb_points_before = 0, nb_points_after = 0, nb_simplified = 0;
+    real_type max_area_err = 0, max_moment_err = 0;
+    auto& floes = get_floes();
+    std::vector<std::size_t> simplified_ids;
+    std::vector<geometry_type> simplified_shapes;
+    for (std::size_t i = slice; i < floes.size(); i += nb_slices) {
+        auto const& static_floe = floes[i].static_floe();
+        geometry_type const& shape = static_floe.get_geometry();
+        nb_points_before += shape.outer().size();
+        geometry_type simplified;
+        const real_type cdist = std::sqrt(static_floe.area()) / 100;
+        if (!floe::geometry::simplify_polygon(shape, simplified, factor * cdist)) {
+            nb_points_after += shape.outer().size();
+            continue;
+        }
+        nb_points_after += simplified.outer().size();
+        simplified_ids.push_back(i);
+        simplified_shapes.push_back(std::move(simplified));
+    }
+    nb_simplified = simplified_ids.size();
+    // new meshes of the simplified shapes, in a batch
+    auto meshes = floe::generator::generate_meshes_for_shapes<geometry_type, mesh_type>(simplified_shapes);
+    for (std::size_t k = 0; k < nb_simplified; ++k) {
+        auto& floe = floes[simplified_ids[k]];
+        auto& static_floe = floe.static_floe();
+        const real_type area = static_floe.area(), moment = static_floe.moment_cst();
+        static_floe.geometry() = std::move(simplified_shapes[k]);
+        // new mesh, and reset of the cached moment constant
+        mesh_type& floe_mesh = floe.get_floe_h().m_static_mesh;
+        floe_mesh = std::move(meshes[k]);
+        static_floe.attach_mesh_ptr(&floe_mesh);
+        static_floe.set_density(static_floe.get_density());
+        floe.update();
+        max_area_err = std::max(max_area_err, std::abs(static_floe.area() - area) / area);
+        if (moment > 0)
+            max_moment_err = std::max(max_moment_err, std::abs(static_floe.moment_cst() - moment) / moment);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Simplified " << nb_simplified << " floe boundaries: " << nb_points_before << " -> "
+              << nb_points_after << " points in " << elapsed.count() << "s (max relative error: area "
+              << max_area_err << ", inertia " << max_moment_err << ")" << std::endl;
+    return nb_points_before - nb_points_after;
+}
+
+template <typename TFloe, typename TFloeList>
+void FloeGroup<TFloe, TFloeList>::share_static_floes(FloeGroup& floe_group) {
+    auto& floes = get_floes();
+    auto& shared_floes = floe_group.get_floes();
+    if (floes.size() != shared_floes.size())
+        throw std::runtime_error("Shared floes: floe groups of different sizes");
+    for (std::size_t n = 0; n < floes.size(); ++n) {
+        auto& static_floe = floes[n].static_floe();
+        auto& shared_static_floe = shared_floes[n].static_floe();
+        static_floe.geometry() = shared_static_floe.geometry();
+        static_floe.attach_mesh_ptr(&shared_static_floe.mesh());
+        static_floe.set_density(static_floe.get_density()); // resets the cached moment constant
+        floes[n].update();
+    }
+}
+
 template <typename TFloe, typename TFloeList>
 bool FloeGroup<TFloe, TFloeList>::h5_contains_floes_characs(std::string filename) {
     return floe::io::floes_characs_in_hdf5(filename, *this);
@@ -324,10 +413,10 @@ FloeGroup<TFloe, TFloeList>::recover_previous_step_states()
 
 template <typename TFloe, typename TFloeList>
 void
-FloeGroup<TFloe, TFloeList>::randomize_floes_thickness(real_type coeff)
+FloeGroup<TFloe, TFloeList>::randomize_floes_thickness(real_type coeff, unsigned seed)
 {
     auto dist = std::normal_distribution<real_type>{1, coeff};
-    auto gen = std::default_random_engine{};
+    auto gen = std::default_random_engine{seed};
     for (auto& floe : get_floes()){
         auto& static_floe = floe.static_floe();
         static_floe.set_thickness(static_floe.thickness() * dist(gen));
@@ -336,11 +425,11 @@ FloeGroup<TFloe, TFloeList>::randomize_floes_thickness(real_type coeff)
 
 template <typename TFloe, typename TFloeList>
 void
-FloeGroup<TFloe, TFloeList>::randomize_floes_oceanic_skin_drag(real_type coeff)
+FloeGroup<TFloe, TFloeList>::randomize_floes_oceanic_skin_drag(real_type coeff, unsigned seed)
 {
     auto dist = std::normal_distribution<real_type>{1, coeff};
     auto gen = std::default_random_engine{};
-    gen.seed(1); // to get a different set of values than for floes thickness
+    gen.seed(seed); // to get a different set of values than for floes thickness
     for (auto& floe : get_floes()) {
         auto& static_floe = floe.static_floe();
         static_floe.set_C_w(static_floe.C_w() * dist(gen));
@@ -28,6 +28,8 @@ public:
     virtual geometry_type const& geometry() const = 0;
     //! State accessor
     virtual state_type const& state() const = 0;
+    //! Static floe accessor (geometry in the floe frame)
+    virtual floe_type const& static_floe() const = 0;
 
 };
 
@@ -54,6 +54,9 @@ public:
     //! State accessor
     state_type& state() const;
 
+    //! Static floe accessor (the original one: same geometry in the floe frame)
+    typename TFloe::static_floe_type const& static_floe() const { return m_floe->static_floe(); }
+
     floe_type const& original() const { return *m_floe; }
     point_type translation() const { return m_translation; }
 
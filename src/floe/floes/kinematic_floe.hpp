@@ -13,6 +13,7 @@
 
 #include "floe/state/space_time_state.hpp"
 #include "floe/geometry/frame/frame_transformers.hpp"
+#include "floe/geometry/frame/batch_transform.hpp"
 
 #include "floe/floes/floe_h.hpp"
 #include "floe/geometry/arithmetic/dot_product.hpp"
@@ -190,19 +191,19 @@ KinematicFloe<TStaticFloe,TState>::update()
     m_floe->set_frame( { m_state.pos, m_state.theta } );
     
     // Transformation from this new frame to absolute frame
-    const auto trans = geometry::frame::transformer( m_floe->get_frame() ); 
+    const auto trans = geometry::frame::rigid_transformer( m_floe->get_frame() );
 
     // Update Geometry (if any)
     if ( m_floe->has_geometry() )
     {
         if ( ! has_geometry() ) { m_geometry.reset(new geometry_type()); }
-        geometry::transform( m_floe->get_geometry(), *m_geometry, trans );
+        geometry::frame::transform_polygon( m_floe->get_geometry(), *m_geometry, trans );
     }
 
     // Update Mesh (if any)
     if ( m_floe->has_mesh() )
     {
-        geometry::transform( m_floe->get_mesh(), mesh(), trans );
+        geometry::frame::transform_mesh( m_floe->get_mesh(), mesh(), trans );
     }
 }
 
@@ -10,7 +10,12 @@
 #include "floe/floes/floe_group.hpp"
 #include "floe/arithmetic/filtered_container.hpp"
 #include "floe/io/inter_process_message.hpp"
-#include "floe/generator/mesh_generator.hpp"
+#include "floe/generator/mesh_service.hpp"
+#include "floe/utils/hilbert_curve.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
  
 namespace floe { namespace floes
 {
@@ -53,9 +58,17 @@ public:
     // fracture !
     // void apply_fracture_from_max_area(const real_type max_area_for_fracture);//{std::cout<<"test"<<std::endl;}
     void add_floe(geometry_type geometry, std::size_t parent_floe_idx);
+    //! Adds a floe of a given shape and mesh (see generator::generate_meshes_for_shapes)
+    void add_floe(geometry_type geometry, mesh_type mesh, std::size_t parent_floe_idx);
     void fracture_biggest_floe();
     void melt_floes();
     void update_list_ids_active();//{std::cout<<"test"<<std::endl;}
+    /*! Sorts the active floes along a Hilbert curve of their positions (cache locality of the pairwise loops)
+     *
+     * Only the working order (filtered indices) is changed: the floes are not moved in memory,
+     * so that their storage index (output order) stays the same.
+     */
+    void sort_along_hilbert_curve();
     
 private:
     std::vector<int> m_states_origin;
@@ -98,8 +111,9 @@ PartialFloeGroup<TFloe, TFloeList>::fracture_biggest_floe()
     }
 
     auto new_geometries = base_class::get_floes()[biggest_floe_idx].fracture_floe();
+    auto new_meshes = floe::generator::generate_meshes_for_shapes<geometry_type, mesh_type>(new_geometries);
     for (std::size_t i = 0; i < new_geometries.size(); ++i){
-    	this->add_floe(new_geometries[i], biggest_floe_idx);
+    	this->add_floe(new_geometries[i], std::move(new_meshes[i]), biggest_floe_idx);
     }
     
     // Desactivate cracked floe
@@ -137,6 +151,14 @@ PartialFloeGroup<TFloe, TFloeList>::melt_floes()
 template <typename TFloe, typename TFloeList>
 void 
 PartialFloeGroup<TFloe, TFloeList>::add_floe(geometry_type shape, std::size_t parent_floe_idx)
+{
+    auto mesh = floe::generator::generate_meshes_for_shapes<geometry_type, mesh_type>(std::vector<geometry_type>{shape});
+    this->add_floe(std::move(shape), std::move(mesh.front()), parent_floe_idx);
+}
+
+template <typename TFloe, typename TFloeList>
+void 
+PartialFloeGroup<TFloe, TFloeList>::add_floe(geometry_type shape, mesh_type mesh, std::size_t parent_floe_idx)
 {
 	// Resize floe group, set all floe properties
     auto& list_floes = base_class::get_floes();
@@ -151,9 +173,6 @@ PartialFloeGroup<TFloe, TFloeList>::add_floe(geometry_type shape, std::size_t pa
     floe.attach_static_floe_ptr(std::unique_ptr<static_floe_type>(new static_floe_type()));
     auto& static_floe = floe.static_floe();
     
-    // Create mesh
-    auto mesh = floe::generator::generate_mesh_for_shape<geometry_type, mesh_type>(shape);
-
     // Center mesh and shape on new floe's center of mass
      using integration_strategy = floe::integration::RefGaussLegendre<real_type,2,2>;
      auto mass_center = floe::integration::integrate(
@@ -232,6 +251,36 @@ PartialFloeGroup<TFloe, TFloeList>::update_list_ids_active()
 } 
 
 
+template <typename TFloe, typename TFloeList>
+void
+PartialFloeGroup<TFloe, TFloeList>::sort_along_hilbert_curve()
+{
+    auto& list_floes = base_class::get_floes();
+    const std::size_t nb_floes = list_floes.size();
+    typename base_class::window_type window{{
+        std::numeric_limits<real_type>::max(), std::numeric_limits<real_type>::lowest(),
+        std::numeric_limits<real_type>::max(), std::numeric_limits<real_type>::lowest()
+    }};
+    for (std::size_t i = 0; i < nb_floes; ++i)
+    {
+        auto const& pos = list_floes[i].state().pos;
+        window[0] = std::min(window[0], pos.x);
+        window[1] = std::max(window[1], pos.x);
+        window[2] = std::min(window[2], pos.y);
+        window[3] = std::max(window[3], pos.y);
+    }
+    // (hilbert index, storage index), the storage index breaking ties
+    std::vector<std::pair<std::uint32_t, std::size_t>> keys(nb_floes);
+    for (std::size_t i = 0; i < nb_floes; ++i)
+        keys[i] = {utils::hilbert_index(list_floes[i].state().pos, window), list_floes.absolute_id(i)};
+    std::sort(keys.begin(), keys.end());
+    std::vector<std::size_t> ids(nb_floes);
+    for (std::size_t i = 0; i < nb_floes; ++i)
+        ids[i] = keys[i].second;
+    this->update_partial_list(ids);
+}
+
+
 }} // namespace floe::floes
 
 
@@ -85,15 +85,16 @@ public:
     inline  frame_type &            frame()                                         { return m_frame; }
 
     //! Geometry accessors
-    inline  void                    attach_geometry_ptr( Uptr_geometry_type geometry )  { m_geometry = std::move(geometry); }
+    inline  void                    attach_geometry_ptr( Uptr_geometry_type geometry )  { m_geometry = std::move(geometry); reset_edges(); }
     inline  geometry_type const&    geometry()                              const   { return *m_geometry; }
-    inline  geometry_type &         geometry()                                      { this->reset_area(); return *m_geometry; }
+    inline  geometry_type &         geometry()                                      { this->reset_area(); this->reset_edges(); return *m_geometry; }
     inline  bool                    has_geometry()                          const   { return m_geometry != nullptr; }
     inline  geometry_type const&    get_geometry()                          const   { return *m_geometry; }
     inline  void                    set_geometry( geometry_type const& geometry )
     { 
         if (! has_geometry() ) m_geometry = new geometry_type();
         *m_geometry = geometry;
+        reset_edges();
     }
 
     //! Mesh accessors
@@ -124,6 +125,15 @@ public:
     //! Area
     inline real_type area() const { return (m_area >= 0) ? m_area : calc_area(); }
 
+    /*! Boundary edges data (cached, in the floe frame)
+     *
+     * Edge i goes from point i to point i+1 of the (open) outer ring, the last one closing the ring.
+     * Lengths are invariant by the floe motion, and unit normals (outward for a counter-clockwise ring)
+     * only need to be rotated.
+     */
+    inline std::vector<real_type> const&  edge_lengths() const { calc_edges(); return m_edge_lengths; }
+    inline std::vector<point_type> const& edge_normals() const { calc_edges(); return m_edge_normals; }
+
     //! Mass
     inline density_type mass() const { return m_density * m_thickness * area(); }
 
@@ -155,6 +165,8 @@ private:
     mutable real_type m_area;  //!< Area (cached)
     // mutable density_type m_mass; //!< Mass (cached)
     mutable real_type m_moment_cst; //!< Momentum constant (cached)
+    mutable std::vector<real_type> m_edge_lengths;  //!< Length of the boundary edges (cached)
+    mutable std::vector<point_type> m_edge_normals; //!< Unit normal of the boundary edges (cached)
 
     //! Calculate area, if not already done.
     inline
@@ -164,6 +176,26 @@ private:
     }
     inline void reset_area() { m_area = -1; }
 
+    //! Calculate boundary edges data, if not already done.
+    inline
+    void calc_edges() const
+    {
+        if ( ! m_edge_lengths.empty() || ! has_geometry() ) return;
+        auto const& ring = m_geometry->outer();
+        const std::size_t n = ring.size();
+        std::vector<point_type> normals(n);
+        std::vector<real_type> lengths(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const point_type u = ring[(i + 1 == n) ? 0 : i + 1] - ring[i];
+            lengths[i] = norm2(u);
+            normals[i] = (lengths[i] > 0) ? point_type{u.y / lengths[i], - u.x / lengths[i]} : point_type{0, 0};
+        }
+        m_edge_normals = std::move(normals);
+        m_edge_lengths = std::move(lengths);
+    }
+    inline void reset_edges() { m_edge_lengths.clear(); m_edge_normals.clear(); }
+
     //! Calculate momentum constant, if not already done.
     inline
     real_type calc_moment_cst() const
@@ -8,7 +8,7 @@
 #define GENERATOR_GENERATOR_DEF_HPP
 
 #include "floe/generator/generator.h"
-#include "floe/generator/mesh_generator.hpp"
+#include "floe/generator/mesh_service.hpp"
 
 // Boost geometry
 #include "floe/geometry/frame/frame_transformers.hpp"
@@ -349,9 +349,11 @@ void Generator<TProblem>::discretize_biblio_floe(std::size_t n)
 template<typename TProblem>
 void Generator<TProblem>::generate_meshes()
 {
-    for (auto& shape : m_biblio_floe_h)
+    auto meshes = generate_meshes_for_shapes<polygon_type, mesh_type>(m_biblio_floe_h);
+    for (std::size_t i = 0; i < m_biblio_floe_h.size(); ++i)
     {
-        auto mesh = generate_mesh_for_shape<polygon_type, mesh_type>(shape);
+        auto& shape = m_biblio_floe_h[i];
+        auto& mesh = meshes[i];
         // Center mesh and shape on floe's center of mass
         using integration_strategy = floe::integration::RefGaussLegendre<real_type,2,2>;
         auto mass_center = floe::integration::integrate(
@@ -0,0 +1,139 @@
+/*!
+ * \file generator/mesh_service.hpp
+ * \brief Batched meshing of floe shapes (parallel, shared between similar shapes)
+ */
+
+#ifndef GENERATOR_MESH_SERVICE_HPP
+#define GENERATOR_MESH_SERVICE_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "floe/generator/mesh_generator.hpp"
+
+
+namespace floe { namespace generator {
+
+/*! Similarity of a shape to a representative shape of the batch
+ *
+ * The shape points are p = center + scale * (q - rep_center) / rep_scale, q being the representative points.
+ */
+template <typename TPoint>
+struct ShapeSimilarity
+{
+    using real_type = typename TPoint::value_type;
+    std::size_t rep; //!< Index of the representative shape (itself for a representative)
+    TPoint center; //!< Mean of the shape points
+    real_type scale; //!< Root mean square distance of the shape points to their mean
+};
+
+/*! Groups the shapes of a batch identical up to a scaling and a translation (e.g. floes of a same library shape)
+ *
+ * Two shapes are similar when their normalized points (translated to their mean, divided by their
+ * root mean square radius) are equal up to tolerance, in the same order.
+ *
+ * \param shapes    shapes of the batch.
+ * \param tolerance max distance between two normalized points.
+ * \return  the similarity of each shape to its representative, the first similar shape of the batch.
+ */
+template <typename TShape>
+std::vector<ShapeSimilarity<typename TShape::point_type>>
+similar_shapes(std::vector<TShape> const& shapes, typename TShape::point_type::value_type tolerance = 1e-9)
+{
+    using point_type = typename TShape::point_type;
+    using real_type = typename point_type::value_type;
+    std::vector<ShapeSimilarity<point_type>> similarities(shapes.size());
+
+    // hash of the normalized points, rounded much coarser than the tolerance
+    std::unordered_map<std::size_t, std::vector<std::size_t>> buckets;
+    auto normalized = [&](std::size_t i, std::size_t k) {
+        auto const& pt = shapes[i].outer()[k];
+        auto const& sim = similarities[i];
+        return point_type{(pt.x - sim.center.x) / sim.scale, (pt.y - sim.center.y) / sim.scale};
+    };
+    for (std::size_t i = 0; i < shapes.size(); ++i)
+    {
+        auto const& points = shapes[i].outer();
+        auto& sim = similarities[i];
+        sim.rep = i;
+        sim.center = point_type{0, 0};
+        sim.scale = 0;
+        if (points.empty()) continue;
+        for (auto const& pt : points) { sim.center.x += pt.x; sim.center.y += pt.y; }
+        sim.center.x /= points.size();
+        sim.center.y /= points.size();
+        for (auto const& pt : points)
+            sim.scale += (pt.x - sim.center.x) * (pt.x - sim.center.x) + (pt.y - sim.center.y) * (pt.y - sim.center.y);
+        sim.scale = std::sqrt(sim.scale / points.size());
+        if (sim.scale == 0) continue;
+
+        std::size_t hash = points.size();
+        for (std::size_t k = 0; k < points.size(); ++k)
+        {
+            const point_type pt = normalized(i, k);
+            for (real_type x : {pt.x, pt.y})
+                hash ^= std::hash<long long>()(std::llround(x * 1e4)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        }
+        auto& bucket = buckets[hash];
+        for (std::size_t j : bucket)
+        {
+            if (shapes[j].outer().size() != points.size()) continue;
+            bool same = true;
+            for (std::size_t k = 0; k < points.size() && same; ++k)
+            {
+                const point_type a = normalized(i, k), b = normalized(j, k);
+                same = std::abs(a.x - b.x) <= tolerance && std::abs(a.y - b.y) <= tolerance;
+            }
+            if (same) { sim.rep = j; break; }
+        }
+        if (sim.rep == i) bucket.push_back(i);
+    }
+    return similarities;
+}
+
+/*! Meshes of a batch of shapes
+ *
+ * Each distinct shape is meshed with generate_mesh_for_shape, in parallel (each thread with its own CGAL
+ * triangulation). The mesh size criteria being relative to the shape size, the mesh of a shape similar
+ * to an already meshed one (see similar_shapes) is this mesh, scaled and translated.
+ *
+ * \return  the meshes, in the shapes order.
+ */
+template <typename TShape, typename TMesh>
+std::vector<TMesh> generate_meshes_for_shapes(std::vector<TShape> const& shapes)
+{
+    const auto similarities = similar_shapes(shapes);
+    std::vector<std::size_t> reps, copies;
+    for (std::size_t i = 0; i < shapes.size(); ++i)
+        (similarities[i].rep == i ? reps : copies).push_back(i);
+
+    std::vector<TMesh> meshes(shapes.size());
+    #pragma omp parallel for schedule(dynamic)
+    for (std::size_t r = 0; r < reps.size(); ++r)
+        meshes[reps[r]] = generate_mesh_for_shape<TShape, TMesh>(shapes[reps[r]]);
+
+    #pragma omp parallel for
+    for (std::size_t c = 0; c < copies.size(); ++c)
+    {
+        auto const& sim = similarities[copies[c]];
+        auto const& rep_sim = similarities[sim.rep];
+        const auto ratio = sim.scale / rep_sim.scale;
+        TMesh& mesh = meshes[copies[c]];
+        mesh = meshes[sim.rep];
+        for (auto& pt : mesh.points())
+        {
+            pt.x = sim.center.x + ratio * (pt.x - rep_sim.center.x);
+            pt.y = sim.center.y + ratio * (pt.y - rep_sim.center.y);
+        }
+    }
+    return meshes;
+}
+
+
+}} // namespace floe::generator
+
+
+#endif // GENERATOR_MESH_SERVICE_HPP
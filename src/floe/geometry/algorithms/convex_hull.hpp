@@ -0,0 +1,78 @@
+/*!
+ * \file floe/geometry/algorithms/convex_hull.hpp
+ * \brief Convex hull of a point range (monotone chain).
+ */
+
+#ifndef FLOE_GEOMETRY_ALGORITHMS_CONVEX_HULL_HPP
+#define FLOE_GEOMETRY_ALGORITHMS_CONVEX_HULL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace floe { namespace geometry
+{
+
+/*! Convex hull of a point range (Andrew's monotone chain), as point indices
+ *
+ * \param points    Point range (a ring, closed or not).
+ * \return  the indices in the range of the hull vertices, in counter-clockwise order, not closed,
+ *          without (exactly) collinear points. A duplicated point is referred to by its first index.
+ */
+template <typename TPointRange>
+std::vector<std::size_t>
+convex_hull_indices(TPointRange const& points)
+{
+    using point_type = typename std::decay<decltype(*std::begin(points))>::type;
+    const std::vector<point_type> pts(std::begin(points), std::end(points));
+    std::vector<std::size_t> ids(pts.size());
+    for (std::size_t i = 0; i < ids.size(); ++i) ids[i] = i;
+    std::stable_sort(ids.begin(), ids.end(), [&pts](std::size_t a, std::size_t b) {
+        return pts[a].x < pts[b].x || (pts[a].x == pts[b].x && pts[a].y < pts[b].y);
+    });
+    ids.erase(std::unique(ids.begin(), ids.end(), [&pts](std::size_t a, std::size_t b) {
+        return pts[a].x == pts[b].x && pts[a].y == pts[b].y;
+    }), ids.end());
+    if (ids.size() < 3) return ids;
+
+    auto cross = [&pts](std::size_t o, std::size_t a, std::size_t b) {
+        return (pts[a].x - pts[o].x) * (pts[b].y - pts[o].y) - (pts[a].y - pts[o].y) * (pts[b].x - pts[o].x);
+    };
+    std::vector<std::size_t> hull(2 * ids.size());
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < ids.size(); ++i) // lower hull
+    {
+        while (k >= 2 && cross(hull[k - 2], hull[k - 1], ids[i]) <= 0) --k;
+        hull[k++] = ids[i];
+    }
+    for (std::size_t i = ids.size() - 1, t = k + 1; i > 0; --i) // upper hull
+    {
+        while (k >= t && cross(hull[k - 2], hull[k - 1], ids[i - 1]) <= 0) --k;
+        hull[k++] = ids[i - 1];
+    }
+    hull.resize(k - 1); // last point is the first one
+    return hull;
+}
+
+/*! Convex hull of a point range (Andrew's monotone chain)
+ *
+ * \param points    Point range (a ring, closed or not).
+ * \return  the hull vertices in counter-clockwise order, not closed, without (exactly) collinear points.
+ */
+template <typename TPointRange>
+std::vector<typename std::decay<decltype(*std::begin(std::declval<TPointRange const&>()))>::type>
+convex_hull_points(TPointRange const& points)
+{
+    using point_type = typename std::decay<decltype(*std::begin(points))>::type;
+    const std::vector<point_type> pts(std::begin(points), std::end(points));
+    std::vector<point_type> hull;
+    for (std::size_t i : convex_hull_indices(pts)) hull.push_back(pts[i]);
+    return hull;
+}
+
+}} // namespace floe::geometry
+
+#endif // FLOE_GEOMETRY_ALGORITHMS_CONVEX_HULL_HPP
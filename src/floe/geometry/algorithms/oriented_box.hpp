@@ -0,0 +1,94 @@
+/*!
+ * \file floe/geometry/algorithms/oriented_box.hpp
+ * \brief Minimal area oriented box of a shape, and separating axis distance between oriented boxes.
+ */
+
+#ifndef FLOE_GEOMETRY_ALGORITHMS_ORIENTED_BOX_HPP
+#define FLOE_GEOMETRY_ALGORITHMS_ORIENTED_BOX_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "floe/geometry/algorithms/convex_hull.hpp"
+#include "floe/geometry/geometries/oriented_box.hpp"
+
+namespace floe { namespace geometry
+{
+
+/*! Minimal area oriented box containing a point range
+ *
+ * One side of the minimal area rectangle is collinear with an edge of the convex hull:
+ * every hull edge direction is tried (quadratic in the number of hull vertices, for a one-time setup).
+ *
+ * \param points    Point range (a ring, closed or not).
+ */
+template <typename TPoint, typename TPointRange>
+OrientedBox<TPoint> oriented_box_envelope(TPointRange const& points)
+{
+    using real_type = typename OrientedBox<TPoint>::coordinate_type;
+    const auto hull = convex_hull_points(points);
+    OrientedBox<TPoint> best;
+    if (hull.empty()) return best;
+    if (hull.size() == 1) { best.center = {hull[0].x, hull[0].y}; return best; }
+
+    real_type best_area = std::numeric_limits<real_type>::max();
+    for (std::size_t i = 0; i < hull.size(); ++i)
+    {
+        auto const& a = hull[i];
+        auto const& b = hull[(i + 1) % hull.size()];
+        const real_type len = std::sqrt((b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y));
+        if (len == 0) continue;
+        const TPoint u{(b.x - a.x) / len, (b.y - a.y) / len};
+        real_type min_u = std::numeric_limits<real_type>::max(), max_u = std::numeric_limits<real_type>::lowest();
+        real_type min_v = min_u, max_v = max_u;
+        for (auto const& p : hull)
+        {
+            const real_type pu = p.x * u.x + p.y * u.y, pv = - p.x * u.y + p.y * u.x;
+            min_u = std::min(min_u, pu); max_u = std::max(max_u, pu);
+            min_v = std::min(min_v, pv); max_v = std::max(max_v, pv);
+        }
+        const real_type area = (max_u - min_u) * (max_v - min_v);
+        if (area < best_area)
+        {
+            best_area = area;
+            const real_type cu = (min_u + max_u) / 2, cv = (min_v + max_v) / 2;
+            best = {{cu * u.x - cv * u.y, cu * u.y + cv * u.x}, u, (max_u - min_u) / 2, (max_v - min_v) / 2};
+        }
+    }
+    return best;
+}
+
+//! Half extent of an oriented box along a unit direction
+template <typename TPoint>
+inline typename OrientedBox<TPoint>::coordinate_type
+oriented_box_radius(OrientedBox<TPoint> const& box, TPoint const& dir)
+{
+    return box.half_length * std::abs(box.axis.x * dir.x + box.axis.y * dir.y)
+         + box.half_width * std::abs(- box.axis.y * dir.x + box.axis.x * dir.y);
+}
+
+/*! Separating axis distance between two oriented boxes
+ *
+ * Largest gap between the projections of the boxes on the 4 box axes.
+ * When positive, the boxes are separated and it is a lower bound of their distance.
+ */
+template <typename TPoint>
+typename OrientedBox<TPoint>::coordinate_type
+distance_box_box(OrientedBox<TPoint> const& box1, OrientedBox<TPoint> const& box2)
+{
+    using real_type = typename OrientedBox<TPoint>::coordinate_type;
+    const TPoint d{box2.center.x - box1.center.x, box2.center.y - box1.center.y};
+    const TPoint axes[4] = {box1.axis, box1.normal(), box2.axis, box2.normal()};
+    real_type gap = std::numeric_limits<real_type>::lowest();
+    for (auto const& axis : axes)
+        gap = std::max(gap, std::abs(d.x * axis.x + d.y * axis.y)
+                            - oriented_box_radius(box1, axis) - oriented_box_radius(box2, axis));
+    return gap;
+}
+
+}} // namespace floe::geometry
+
+#endif // FLOE_GEOMETRY_ALGORITHMS_ORIENTED_BOX_HPP
@@ -0,0 +1,69 @@
+/*!
+ * \file floe/geometry/algorithms/separating_axis.hpp
+ * \brief Separating axis test between two convex polygons given by point indices.
+ */
+
+#ifndef FLOE_GEOMETRY_ALGORITHMS_SEPARATING_AXIS_HPP
+#define FLOE_GEOMETRY_ALGORITHMS_SEPARATING_AXIS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+namespace floe { namespace geometry
+{
+
+namespace detail
+{
+
+//! Largest gap of polygon 2 beyond the edges of polygon 1 (see convex_polygons_gap)
+template <typename TRing1, typename TIds1, typename TLengths1, typename TRing2, typename TIds2, typename T>
+T edges_gap(TRing1 const& ring1, TIds1 const& ids1, TLengths1 const& lengths1, TRing2 const& ring2, TIds2 const& ids2, T min_gap)
+{
+    T gap = std::numeric_limits<T>::lowest();
+    const std::size_t m = ids1.size();
+    for (std::size_t k = 0; k < m; ++k)
+    {
+        if (lengths1[k] <= 0) continue;
+        auto const& a = ring1[ids1[k]];
+        auto const& b = ring1[ids1[(k + 1 == m) ? 0 : k + 1]];
+        // outward normal of a counter-clockwise edge
+        const T nx = (b.y - a.y) / lengths1[k], ny = - (b.x - a.x) / lengths1[k];
+        T axis_gap = std::numeric_limits<T>::max();
+        for (std::size_t id2 : ids2)
+        {
+            axis_gap = std::min(axis_gap, nx * (ring2[id2].x - a.x) + ny * (ring2[id2].y - a.y));
+            if (axis_gap <= min_gap) break;
+        }
+        if (axis_gap > min_gap) return axis_gap;
+        gap = std::max(gap, axis_gap);
+    }
+    return gap;
+}
+
+} // namespace detail
+
+/*! Separating axis gap between two convex polygons
+ *
+ * Each polygon is given by the indices of its vertices (counter-clockwise, not closed) in a point range,
+ * and by the lengths of its edges (edge k goes from vertex k to vertex k+1).
+ * The tested axes are the outward edge normals of both polygons; a polygon of 2 vertices is a segment.
+ *
+ * \param min_gap   Required gap: the test stops at the first axis that separates the polygons by more than min_gap.
+ * \return  a gap greater than min_gap if there is such an axis (it is then a lower bound of the polygons distance),
+ *          otherwise a value lower or equal to min_gap.
+ */
+template <typename TRing1, typename TIds1, typename TLengths1, typename TRing2, typename TIds2, typename TLengths2, typename T>
+T convex_polygons_gap(
+    TRing1 const& ring1, TIds1 const& ids1, TLengths1 const& lengths1,
+    TRing2 const& ring2, TIds2 const& ids2, TLengths2 const& lengths2,
+    T min_gap)
+{
+    const T gap1 = detail::edges_gap(ring1, ids1, lengths1, ring2, ids2, min_gap);
+    if (gap1 > min_gap) return gap1;
+    return std::max(gap1, detail::edges_gap(ring2, ids2, lengths2, ring1, ids1, min_gap));
+}
+
+}} // namespace floe::geometry
+
+#endif // FLOE_GEOMETRY_ALGORITHMS_SEPARATING_AXIS_HPP
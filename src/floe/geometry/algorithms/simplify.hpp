@@ -0,0 +1,216 @@
+/*!
+ * \file floe/geometry/algorithms/simplify.hpp
+ * \brief Topology preserving simplification of polygon boundaries.
+ *
+ * \namespace floe::geometry::detail::simplify
+ * \brief Implementation details for the boundary simplification.
+ */
+
+#ifndef FLOE_GEOMETRY_ALGORITHMS_SIMPLIFY_HPP
+#define FLOE_GEOMETRY_ALGORITHMS_SIMPLIFY_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace floe { namespace geometry
+{
+
+namespace detail { namespace simplify
+{
+
+template <typename TPoint>
+inline auto cross(TPoint const& o, TPoint const& a, TPoint const& b) -> decltype(a.x * b.y)
+{
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+//! Distance from p to the segment [a, b]
+template <typename TPoint>
+inline auto segment_distance(TPoint const& p, TPoint const& a, TPoint const& b) -> decltype(p.x * p.y)
+{
+    using real_type = decltype(p.x * p.y);
+    const real_type dx = b.x - a.x, dy = b.y - a.y;
+    const real_type l2 = dx * dx + dy * dy;
+    real_type t = (l2 > 0) ? ((p.x - a.x) * dx + (p.y - a.y) * dy) / l2 : 0;
+    t = std::min(std::max(t, real_type(0)), real_type(1));
+    const real_type ex = a.x + t * dx - p.x, ey = a.y + t * dy - p.y;
+    return std::sqrt(ex * ex + ey * ey);
+}
+
+//! Point in the closed triangle (a, b, c), whatever its orientation
+template <typename TPoint>
+inline bool in_triangle(TPoint const& p, TPoint const& a, TPoint const& b, TPoint const& c)
+{
+    const auto d1 = cross(a, b, p), d2 = cross(b, c, p), d3 = cross(c, a, p);
+    const bool has_neg = (d1 < 0) || (d2 < 0) || (d3 < 0);
+    const bool has_pos = (d1 > 0) || (d2 > 0) || (d3 > 0);
+    return !(has_neg && has_pos);
+}
+
+}} // namespace detail::simplify
+
+
+/*! Topology preserving simplification of a ring (Visvalingam-Whyatt)
+ *
+ * Vertices are removed by increasing effective area (area of the triangle formed with their neighbours).
+ * A removal is accepted only if:
+ * - every original vertex replaced by the new edge is at most at max_error from it (Hausdorff bound,
+ *   as in the Douglas-Peucker algorithm),
+ * - no other vertex of the current ring lies in the removed triangle, so that the new edge does not cross
+ *   the ring (the simplified ring stays simple).
+ * The other vertices are found with a uniform grid, so that the cost is nearly linear in the number of vertices.
+ *
+ * \param ring      Input ring (open or closed, i.e. with the first point repeated at the end).
+ * \param out       Simplified ring (same closure as the input).
+ * \param max_error Maximal distance between removed vertices and the simplified boundary.
+ * \param min_size  Minimal number of distinct vertices kept.
+ */
+template <typename TRing, typename T>
+void simplify_ring(TRing const& ring, TRing& out, T max_error, std::size_t min_size = 3)
+{
+    using namespace detail::simplify;
+    using point_type = typename std::decay<decltype(*ring.begin())>::type;
+
+    std::vector<point_type> pts(ring.begin(), ring.end());
+    const bool closed = pts.size() > 1 && pts.front().x == pts.back().x && pts.front().y == pts.back().y;
+    if (closed) pts.pop_back();
+    const std::size_t n = pts.size();
+    min_size = std::max<std::size_t>(min_size, 3);
+    if (n <= min_size || !(max_error > 0))
+    {
+        out = ring;
+        return;
+    }
+
+    std::vector<std::size_t> prev(n), next(n);
+    std::vector<unsigned> version(n, 0);
+    std::vector<bool> removed(n, false);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        prev[i] = (i + n - 1) % n;
+        next[i] = (i + 1) % n;
+    }
+
+    // uniform grid of the vertices
+    T min_x = std::numeric_limits<T>::max(), min_y = min_x;
+    T max_x = std::numeric_limits<T>::lowest(), max_y = max_x;
+    for (auto const& p : pts)
+    {
+        min_x = std::min<T>(min_x, p.x); max_x = std::max<T>(max_x, p.x);
+        min_y = std::min<T>(min_y, p.y); max_y = std::max<T>(max_y, p.y);
+    }
+    const std::size_t nb_cells = static_cast<std::size_t>(std::sqrt(T(n))) + 1;
+    const T dx = std::max<T>((max_x - min_x) / nb_cells, std::numeric_limits<T>::min());
+    const T dy = std::max<T>((max_y - min_y) / nb_cells, std::numeric_limits<T>::min());
+    auto cell_x = [&](T x) { return std::min(static_cast<std::size_t>(std::max<T>(x - min_x, 0) / dx), nb_cells - 1); };
+    auto cell_y = [&](T y) { return std::min(static_cast<std::size_t>(std::max<T>(y - min_y, 0) / dy), nb_cells - 1); };
+    std::vector<std::vector<std::size_t>> cells(nb_cells * nb_cells);
+    for (std::size_t i = 0; i < n; ++i)
+        cells[cell_y(pts[i].y) * nb_cells + cell_x(pts[i].x)].push_back(i);
+
+    auto effective_area = [&](std::size_t i) { return std::abs(cross(pts[prev[i]], pts[i], pts[next[i]])) / 2; };
+
+    auto removable = [&](std::size_t i) {
+        const std::size_t a = prev[i], b = next[i];
+        // Hausdorff bound on the original vertices between a and b
+        for (std::size_t k = (a + 1) % n; k != b; k = (k + 1) % n)
+            if (segment_distance(pts[k], pts[a], pts[b]) > max_error)
+                return false;
+        // no remaining vertex in the removed triangle
+        const T x0 = std::min({pts[a].x, pts[i].x, pts[b].x}), x1 = std::max({pts[a].x, pts[i].x, pts[b].x});
+        const T y0 = std::min({pts[a].y, pts[i].y, pts[b].y}), y1 = std::max({pts[a].y, pts[i].y, pts[b].y});
+        for (std::size_t cy = cell_y(y0); cy <= cell_y(y1); ++cy)
+            for (std::size_t cx = cell_x(x0); cx <= cell_x(x1); ++cx)
+                for (std::size_t k : cells[cy * nb_cells + cx])
+                    if (!removed[k] && k != a && k != i && k != b && in_triangle(pts[k], pts[a], pts[i], pts[b]))
+                        return false;
+        return true;
+    };
+
+    using entry_type = std::tuple<T, std::size_t, unsigned>; //!< effective area, vertex, version
+    std::priority_queue<entry_type, std::vector<entry_type>, std::greater<entry_type>> queue;
+    for (std::size_t i = 0; i < n; ++i)
+        queue.emplace(effective_area(i), i, 0);
+
+    std::size_t size = n;
+    while (size > min_size && !queue.empty())
+    {
+        const std::size_t i = std::get<1>(queue.top());
+        const unsigned v = std::get<2>(queue.top());
+        queue.pop();
+        if (removed[i] || v != version[i] || !removable(i))
+            continue; // a rejected vertex is tried again when one of its neighbours is removed
+        removed[i] = true;
+        --size;
+        const std::size_t a = prev[i], b = next[i];
+        next[a] = b;
+        prev[b] = a;
+        queue.emplace(effective_area(a), a, ++version[a]);
+        queue.emplace(effective_area(b), b, ++version[b]);
+    }
+
+    TRing result;
+    for (std::size_t i = 0; i < n; ++i)
+        if (!removed[i]) result.push_back(pts[i]);
+    if (closed) result.push_back(result.front());
+    out = std::move(result);
+}
+
+/*! Simplification of the outer ring of a polygon, preserving its area
+ *
+ * The outer ring is simplified with simplify_ring, then scaled about its centroid to recover the initial area
+ * (and thus the mass of a floe). The inner rings are kept unchanged.
+ *
+ * \return  the number of removed vertices.
+ */
+template <typename TPolygon, typename T>
+std::size_t simplify_polygon(TPolygon const& polygon, TPolygon& out, T max_error, bool preserve_area = true)
+{
+    // signed area and centroid of a ring (shoelace formula)
+    auto ring_moments = [](decltype(polygon.outer()) ring, T& area, T& cx, T& cy) {
+        area = cx = cy = 0;
+        const std::size_t n = ring.size();
+        for (std::size_t i = 0, j = n - 1; i < n; j = i++)
+        {
+            const T c = ring[j].x * ring[i].y - ring[i].x * ring[j].y;
+            area += c;
+            cx += (ring[j].x + ring[i].x) * c;
+            cy += (ring[j].y + ring[i].y) * c;
+        }
+        if (area != 0) { cx /= 3 * area; cy /= 3 * area; }
+        area /= 2;
+    };
+
+    TPolygon result = polygon;
+    simplify_ring(polygon.outer(), result.outer(), max_error);
+    const std::size_t nb_removed = polygon.outer().size() - result.outer().size();
+
+    if (preserve_area && nb_removed)
+    {
+        T a0, a1, cx, cy, cx1, cy1;
+        ring_moments(polygon.outer(), a0, cx, cy);
+        ring_moments(result.outer(), a1, cx1, cy1);
+        if (a1 != 0 && a0 / a1 > 0)
+        {
+            const T ratio = std::sqrt(a0 / a1);
+            for (auto& p : result.outer())
+            {
+                p.x = cx1 + ratio * (p.x - cx1);
+                p.y = cy1 + ratio * (p.y - cy1);
+            }
+        }
+    }
+    out = std::move(result);
+    return nb_removed;
+}
+
+}} // namespace floe::geometry
+
+#endif // FLOE_GEOMETRY_ALGORITHMS_SIMPLIFY_HPP
@@ -36,18 +36,21 @@ struct transform_TriangleMesh
 
     template <
         typename TPoint1,
+        template <typename> class TAllocator1,
         typename TPoint2,
+        template <typename> class TAllocator2,
         typename Strategy
     >
     static inline 
     bool apply(
-        TriangleMesh<TPoint1> const& triangle_mesh1,
-        TriangleMesh<TPoint2> & triangle_mesh2,
+        TriangleMesh<TPoint1, TAllocator1> const& triangle_mesh1,
+        TriangleMesh<TPoint2, TAllocator2> & triangle_mesh2,
         Strategy const& strategy
     )
     {
-        // Copy of the connectivity
-        triangle_mesh2.connectivity() = triangle_mesh1.connectivity();
+        // Copy of the connectivity (allocators may differ)
+        auto const& connectivity1 = triangle_mesh1.connectivity();
+        triangle_mesh2.connectivity().assign( connectivity1.begin(), connectivity1.end() );
         
         // Transformation of the points
         return boost::geometry::transform( triangle_mesh1.points(), triangle_mesh2.points(), strategy );
@@ -86,9 +89,11 @@ namespace dispatch
 {
     template <
         typename TPoint1,
-        typename TPoint2
+        template <typename> class TAllocator1,
+        typename TPoint2,
+        template <typename> class TAllocator2
     >
-    struct transform< TriangleMesh<TPoint1>, TriangleMesh<TPoint2>, mesh_tag, mesh_tag >
+    struct transform< TriangleMesh<TPoint1, TAllocator1>, TriangleMesh<TPoint2, TAllocator2>, mesh_tag, mesh_tag >
         : detail::transform::transform_TriangleMesh
     {};
 
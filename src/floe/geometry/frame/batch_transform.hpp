@@ -0,0 +1,167 @@
+/*!
+ * \file floe/geometry/frame/batch_transform.hpp
+ * \brief Batch rigid transformations (rotation + translation) of coordinate arrays.
+ *
+ * Same transformations as frame_transformers.hpp, without going through a generic homogeneous matrix per point:
+ * the loops only involve (cos theta, sin theta, tx, ty) and can be vectorized by the compiler.
+ */
+
+#ifndef FLOE_GEOMETRY_FRAME_BATCH_TRANSFORM_HPP
+#define FLOE_GEOMETRY_FRAME_BATCH_TRANSFORM_HPP
+
+#include <cmath>
+#include <cstddef>
+
+#include "floe/geometry/core/access.hpp"
+
+namespace floe { namespace geometry { namespace frame
+{
+
+/*! Rigid transformation p -> R(theta) p + t
+ *
+ * \tparam T    Coordinate type.
+ */
+template <typename T>
+struct RigidTransform
+{
+    T c, s;     //!< cos(theta), sin(theta)
+    T tx, ty;   //!< translation
+};
+
+/*! Rigid transformation from a frame to the canonical frame (same as transformer(frame))
+ *
+ * \return  translate(center)*rotate(theta)
+ */
+template <
+    typename TFrame,
+    typename T = typename TFrame::coordinate_type
+>
+inline
+RigidTransform<T> rigid_transformer( TFrame const& frame )
+{
+    using floe::geometry::get;
+    return { std::cos(frame.theta()), std::sin(frame.theta()), get<0>(frame.center()), get<1>(frame.center()) };
+}
+
+/*! Rigid transformation from a frame to an another frame for objects in canonical frame (same as itransformer(frame1, frame2))
+ *
+ * \return  translate(center2)*rotate(theta2-theta1)*translate(-center1)
+ */
+template <
+    typename TFrame1,
+    typename TFrame2,
+    typename T = typename TFrame1::coordinate_type
+>
+inline
+RigidTransform<T> rigid_itransformer( TFrame1 const& frame1, TFrame2 const& frame2 )
+{
+    using floe::geometry::get;
+    const T c = std::cos(frame2.theta() - frame1.theta()), s = std::sin(frame2.theta() - frame1.theta());
+    const T x1 = get<0>(frame1.center()), y1 = get<1>(frame1.center());
+    return { c, s, get<0>(frame2.center()) - (c * x1 - s * y1), get<1>(frame2.center()) - (s * x1 + c * y1) };
+}
+
+/*! Batch kernel on coordinate arrays (structure of arrays)
+ *
+ * Output arrays may be the input ones (in place transformation).
+ */
+template <typename T>
+inline
+void batch_transform( std::size_t n, T const* x, T const* y, T* out_x, T* out_y, RigidTransform<T> const& t )
+{
+    const T c = t.c, s = t.s, tx = t.tx, ty = t.ty;
+    #pragma omp simd
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const T xi = x[i], yi = y[i];
+        out_x[i] = c * xi - s * yi + tx;
+        out_y[i] = s * xi + c * yi + ty;
+    }
+}
+
+/*! Batch transformation of a points container (floe points store x and y contiguously)
+ *
+ * The output container is resized if needed. In place transformation is allowed.
+ */
+template <typename TPoints, typename T>
+inline
+void transform_points( TPoints const& in, TPoints& out, RigidTransform<T> const& t )
+{
+    const std::size_t n = in.size();
+    if (out.size() != n) out.resize(n);
+    const T c = t.c, s = t.s, tx = t.tx, ty = t.ty;
+    #pragma omp simd
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const T xi = in[i].x, yi = in[i].y;
+        out[i].x = c * xi - s * yi + tx;
+        out[i].y = s * xi + c * yi + ty;
+    }
+}
+
+//! Batch transformation of a polygon (outer and inner rings)
+template <typename TPolygon, typename T>
+inline
+void transform_polygon( TPolygon const& in, TPolygon& out, RigidTransform<T> const& t )
+{
+    transform_points(in.outer(), out.outer(), t);
+    if (out.inners().size() != in.inners().size()) out.inners().resize(in.inners().size());
+    for (std::size_t i = 0; i < in.inners().size(); ++i)
+        transform_points(in.inners()[i], out.inners()[i], t);
+}
+
+//! Batch transformation of a triangle mesh (points, and copy of the connectivity)
+template <typename TMesh, typename T>
+inline
+void transform_mesh( TMesh const& in, TMesh& out, RigidTransform<T> const& t )
+{
+    if (&in != &out) out.connectivity().assign(in.connectivity().begin(), in.connectivity().end());
+    transform_points(in.points(), out.points(), t);
+}
+
+//! Transformation of a circle (the radius is kept)
+template <typename TCircle, typename T>
+inline
+void transform_circle( TCircle const& in, TCircle& out, RigidTransform<T> const& t )
+{
+    const T x = in.center.x, y = in.center.y;
+    out.center.x = t.c * x - t.s * y + t.tx;
+    out.center.y = t.s * x + t.c * y + t.ty;
+    out.radius = in.radius;
+}
+
+//! Rigid transformation of an oriented box (center and axis, the half sizes are kept)
+template <typename TBox, typename T>
+inline
+void transform_oriented_box( TBox const& in, TBox& out, RigidTransform<T> const& t )
+{
+    const T x = in.center.x, y = in.center.y, ux = in.axis.x, uy = in.axis.y;
+    out.center.x = t.c * x - t.s * y + t.tx;
+    out.center.y = t.s * x + t.c * y + t.ty;
+    out.axis.x = t.c * ux - t.s * uy;
+    out.axis.y = t.s * ux + t.c * uy;
+    out.half_length = in.half_length;
+    out.half_width = in.half_width;
+}
+
+//! Batch transformation of a collection of circles (the radii are kept)
+template <typename TMultiCircle, typename T>
+inline
+void transform_circles( TMultiCircle const& in, TMultiCircle& out, RigidTransform<T> const& t )
+{
+    const std::size_t n = in.size();
+    if (out.size() != n) out.resize(n);
+    const T c = t.c, s = t.s, tx = t.tx, ty = t.ty;
+    #pragma omp simd
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const T xi = in[i].center.x, yi = in[i].center.y;
+        out[i].center.x = c * xi - s * yi + tx;
+        out[i].center.y = s * xi + c * yi + ty;
+        out[i].radius = in[i].radius;
+    }
+}
+
+}}} // namespace floe::geometry::frame
+
+#endif // FLOE_GEOMETRY_FRAME_BATCH_TRANSFORM_HPP
@@ -0,0 +1,45 @@
+/*!
+ * \file floe/geometry/geometries/oriented_box.hpp
+ * \brief Oriented (rotated) rectangle.
+ */
+
+#ifndef FLOE_GEOMETRY_GEOMETRIES_ORIENTED_BOX_HPP
+#define FLOE_GEOMETRY_GEOMETRIES_ORIENTED_BOX_HPP
+
+namespace floe { namespace geometry {
+
+/*! Oriented box type
+ *
+ * Rectangle of half sizes (half_length, half_width) along (axis, normal to axis), centered on center.
+ *
+ * \tparam TPoint   Point type
+ */
+template <
+    typename TPoint
+>
+class OrientedBox
+{
+
+public:
+
+    // Member types
+    using point_type = TPoint;
+    using coordinate_type = decltype(TPoint::x);
+
+    OrientedBox() : center{0,0}, axis{1,0}, half_length{0}, half_width{0} {}
+    OrientedBox(point_type const& c, point_type const& u, coordinate_type l, coordinate_type w)
+        : center{c}, axis{u}, half_length{l}, half_width{w} {}
+
+    //! Unit vector normal to the axis
+    inline point_type normal() const { return {-axis.y, axis.x}; }
+
+    point_type      center;
+    point_type      axis;           //!< Unit vector
+    coordinate_type half_length;    //!< Half size along the axis
+    coordinate_type half_width;     //!< Half size along the normal
+
+}; // class OrientedBox
+
+}} // namespace floe::geometry
+
+#endif // FLOE_GEOMETRY_GEOMETRIES_ORIENTED_BOX_HPP
@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <vector>
 #include <array>
+#include <memory>
 
 #include "floe/geometry/core/tag.hpp"
 
@@ -22,13 +23,15 @@ namespace floe { namespace geometry {
  *
  * It is a points list with a connectivity list.
  *
- * \tparam TPoint   Point type
+ * \tparam TPoint       Point type
+ * \tparam TAllocator   Allocator template of the points and connectivity lists
  *
  * \todo new triangles must be tested for clockwise orientation
  * \todo mutable cells list that autorize to modify underlying points
  */
 template <
-    typename TPoint
+    typename TPoint,
+    template <typename> class TAllocator = std::allocator
 >
 struct TriangleMesh
 {
@@ -36,9 +39,9 @@ public:
    
     //! Type traits
     using point_type       = TPoint;
-    using multi_point_type = typename boost::geometry::model::multi_point<point_type>;
+    using multi_point_type = typename boost::geometry::model::multi_point<point_type, std::vector, TAllocator>;
     using cell_type        = typename floe::geometry::Triangle<point_type, true>;
-    using connectivity_type = std::vector< std::array<std::size_t,3> >;
+    using connectivity_type = std::vector< std::array<std::size_t,3>, TAllocator<std::array<std::size_t,3>> >;
     using multi_cell_type  = typename floe::geometry::MultiSSPPointCloud<cell_type, multi_point_type const*, connectivity_type const*>;
 
     TriangleMesh() : m_points{}, m_connect{}, m_cells{nullptr, nullptr} {}
@@ -59,7 +62,7 @@ public:
 
     //! Add a triangle (no orientation check)
     inline
-    TriangleMesh<TPoint> &
+    TriangleMesh &
         add_triangle( std::size_t i, std::size_t j, std::size_t k )
     {
         m_connect.push_back( {{i, j, k}} );
@@ -87,32 +90,32 @@ namespace {
 namespace boost { namespace geometry { namespace traits
 {
 
-template <typename TPoint>
-struct tag< TriangleMesh<TPoint> >
+template <typename TPoint, template <typename> class TAllocator>
+struct tag< TriangleMesh<TPoint, TAllocator> >
 {
     typedef mesh_tag type;
 };
 
-template <typename TPoint>
-struct cells_const_type< TriangleMesh<TPoint> >
+template <typename TPoint, template <typename> class TAllocator>
+struct cells_const_type< TriangleMesh<TPoint, TAllocator> >
 {
     typedef 
-        typename TriangleMesh<TPoint>::multi_cell_type const& 
+        typename TriangleMesh<TPoint, TAllocator>::multi_cell_type const& 
         type;
 };
 
-template <typename TPoint>
-struct cells_mutable_type< TriangleMesh<TPoint> >
+template <typename TPoint, template <typename> class TAllocator>
+struct cells_mutable_type< TriangleMesh<TPoint, TAllocator> >
 {
     typedef
-        typename TriangleMesh<TPoint>::multi_cell_type const&
+        typename TriangleMesh<TPoint, TAllocator>::multi_cell_type const&
         type;
 };
 
-template <typename TPoint>
-struct cells< TriangleMesh<TPoint> >
+template <typename TPoint, template <typename> class TAllocator>
+struct cells< TriangleMesh<TPoint, TAllocator> >
 {
-    typedef TriangleMesh<TPoint> mesh_type;
+    typedef TriangleMesh<TPoint, TAllocator> mesh_type;
 
     static inline
     typename mesh_type::multi_cell_type const& get ( mesh_type& mesh )
@@ -128,8 +131,8 @@ struct cells< TriangleMesh<TPoint> >
     }
 };
 
-template <typename TPoint>
-struct point_type< TriangleMesh<TPoint> >
+template <typename TPoint, template <typename> class TAllocator>
+struct point_type< TriangleMesh<TPoint, TAllocator> >
 {
     typedef TPoint type;
 };
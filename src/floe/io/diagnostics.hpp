@@ -0,0 +1,439 @@
+/*!
+ * \file floe/io/diagnostics.hpp
+ * \brief In-situ diagnostics: reductions over the floes written as small datasets.
+ */
+
+#ifndef FLOE_IO_DIAGNOSTICS_HPP
+#define FLOE_IO_DIAGNOSTICS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace floe { namespace io
+{
+
+/*! DiagnosticReducer
+ *
+ * Reduction over the floes giving a fixed number of values per diagnostic step.
+ * Each floe adds its contribution to an accumulator (one accumulator per thread, summed afterwards),
+ * then the sum is turned into the output values.
+ *
+ * \tparam TFloeGroup   Type of floe group.
+ */
+template <typename TFloeGroup>
+class DiagnosticReducer
+{
+
+public:
+    using floe_group_type = TFloeGroup;
+    using floe_type = typename TFloeGroup::floe_type;
+    using real_type = typename TFloeGroup::real_type;
+    using point_type = typename TFloeGroup::point_type;
+    using value_vector = std::vector<real_type>;
+
+    virtual ~DiagnosticReducer() {}
+
+    //! Dataset name
+    virtual std::string name() const = 0;
+    //! Number of output values per step
+    virtual std::size_t size() const = 0;
+    //! Number of accumulated values
+    virtual std::size_t accumulator_size() const { return size(); }
+    //! Called sequentially before each reduction (the floe ids are the indexes in the floe list)
+    virtual void prepare(floe_group_type const&) {}
+    //! Contribution of an active floe (called concurrently, each thread having its own accumulator)
+    virtual void accumulate(floe_type const& floe, std::size_t id, value_vector& acc) const = 0;
+    //! Output values from the summed accumulator (same vector, resized to size())
+    virtual void finalize(value_vector& values) const { (void)values; }
+};
+
+
+/*! GridReducer
+ *
+ * Base of the gridded diagnostics: regular grid over the floes bounding window of the first reduction.
+ */
+template <typename TFloeGroup>
+class GridReducer : public DiagnosticReducer<TFloeGroup>
+{
+
+public:
+    using base_type = DiagnosticReducer<TFloeGroup>;
+    using typename base_type::real_type;
+    using typename base_type::point_type;
+    using window_type = std::array<real_type, 4>; //!< min x, max x, min y, max y
+
+    GridReducer(std::size_t nx, std::size_t ny) :
+        m_window{{0, 0, 0, 0}}, m_nx{std::max(nx, std::size_t(1))}, m_ny{std::max(ny, std::size_t(1))},
+        m_dx{1}, m_dy{1}, m_initialized{false} {}
+
+    inline std::size_t nb_cells() const { return m_nx * m_ny; }
+    inline real_type cell_area() const { return m_dx * m_dy; }
+    inline window_type const& window() const { return m_window; }
+
+    virtual void prepare(TFloeGroup const& floe_group) override
+    {
+        if (m_initialized) return;
+        m_window = floe_group.bounding_window(0);
+        m_dx = (m_window[1] > m_window[0]) ? (m_window[1] - m_window[0]) / m_nx : 1;
+        m_dy = (m_window[3] > m_window[2]) ? (m_window[3] - m_window[2]) / m_ny : 1;
+        m_initialized = true;
+    }
+
+protected:
+    window_type m_window; //!< Grid extent
+    std::size_t m_nx, m_ny; //!< Number of cells along x and y
+    real_type m_dx, m_dy; //!< Cell size
+    bool m_initialized;
+
+    //! Index of the cell containing p (points outside the grid belong to the nearest border cell)
+    inline std::size_t cell_index(point_type const& p) const
+    {
+        const std::size_t i = clamp_index((p.x - m_window[0]) / m_dx, m_nx);
+        const std::size_t j = clamp_index((p.y - m_window[2]) / m_dy, m_ny);
+        return j * m_nx + i;
+    }
+
+    static inline std::size_t clamp_index(real_type x, std::size_t n)
+    {
+        if (!(x > 0)) return 0;
+        return std::min(static_cast<std::size_t>(x), n - 1);
+    }
+};
+
+
+/*! GriddedFieldsReducer
+ *
+ * Per cell (floes assigned to the cell of their mass center): concentration, mean velocity (mass weighted)
+ * and kinetic energy. Values are stored field by field: [concentration, u, v, kinetic energy] x nb_cells.
+ */
+template <typename TFloeGroup>
+class GriddedFieldsReducer : public GridReducer<TFloeGroup>
+{
+
+public:
+    using base_type = GridReducer<TFloeGroup>;
+    using typename base_type::floe_type;
+    using typename base_type::real_type;
+    using typename base_type::value_vector;
+
+    GriddedFieldsReducer(std::size_t nx, std::size_t ny) : base_type(nx, ny) {}
+
+    virtual std::string name() const override { return "gridded_fields"; }
+    virtual std::size_t size() const override { return 4 * this->nb_cells(); }
+    virtual std::size_t accumulator_size() const override { return 5 * this->nb_cells(); }
+
+    virtual void accumulate(floe_type const& floe, std::size_t, value_vector& acc) const override
+    {
+        auto const& state = floe.state();
+        const std::size_t N = this->nb_cells(), c = this->cell_index(state.pos);
+        acc[c] += floe.area();
+        acc[N + c] += floe.mass();
+        acc[2 * N + c] += floe.mass() * state.speed.x;
+        acc[3 * N + c] += floe.mass() * state.speed.y;
+        acc[4 * N + c] += floe.kinetic_energy();
+    }
+
+    virtual void finalize(value_vector& values) const override
+    {
+        const std::size_t N = this->nb_cells();
+        for (std::size_t c = 0; c < N; ++c)
+        {
+            const real_type mass = values[N + c];
+            values[c] = std::min(values[c] / this->cell_area(), real_type(1));
+            values[N + c] = (mass > 0) ? values[2 * N + c] / mass : 0;
+            values[2 * N + c] = (mass > 0) ? values[3 * N + c] / mass : 0;
+            values[3 * N + c] = values[4 * N + c];
+        }
+        values.resize(size());
+    }
+};
+
+
+/*! KineticEnergySpectrumReducer
+ *
+ * Isotropic spectrum of the gridded velocity: the mass weighted velocity per cell is Fourier transformed
+ * and 1/2 |u_k|^2 is summed per shell of wave number |k| (in grid units, k = 0 .. min(nx, ny) / 2).
+ */
+template <typename TFloeGroup>
+class KineticEnergySpectrumReducer : public GridReducer<TFloeGroup>
+{
+
+public:
+    using base_type = GridReducer<TFloeGroup>;
+    using typename base_type::floe_type;
+    using typename base_type::real_type;
+    using typename base_type::value_vector;
+
+    KineticEnergySpectrumReducer(std::size_t nx, std::size_t ny) : base_type(nx, ny) {}
+
+    virtual std::string name() const override { return "kinetic_energy_spectrum"; }
+    virtual std::size_t size() const override { return std::min(this->m_nx, this->m_ny) / 2 + 1; }
+    virtual std::size_t accumulator_size() const override { return 3 * this->nb_cells(); }
+
+    virtual void accumulate(floe_type const& floe, std::size_t, value_vector& acc) const override
+    {
+        auto const& state = floe.state();
+        const std::size_t N = this->nb_cells(), c = this->cell_index(state.pos);
+        acc[c] += floe.mass();
+        acc[N + c] += floe.mass() * state.speed.x;
+        acc[2 * N + c] += floe.mass() * state.speed.y;
+    }
+
+    virtual void finalize(value_vector& values) const override;
+};
+
+template <typename TFloeGroup>
+void
+KineticEnergySpectrumReducer<TFloeGroup>::finalize(value_vector& values) const
+{
+    using complex_type = std::complex<real_type>;
+    const std::size_t nx = this->m_nx, ny = this->m_ny, N = this->nb_cells();
+    value_vector spectrum(size(), 0);
+    for (std::size_t d = 0; d < 2; ++d)
+    {
+        // velocity component d (0 in empty cells), then separable discrete Fourier transform
+        std::vector<complex_type> field(N), tmp(N);
+        for (std::size_t c = 0; c < N; ++c)
+            field[c] = (values[c] > 0) ? values[(d + 1) * N + c] / values[c] : 0;
+        const real_type two_pi = 2 * std::acos(real_type(-1));
+        for (std::size_t j = 0; j < ny; ++j)
+            for (std::size_t k = 0; k < nx; ++k)
+            {
+                complex_type sum = 0;
+                for (std::size_t i = 0; i < nx; ++i)
+                    sum += field[j * nx + i] * std::polar(real_type(1), - two_pi * real_type(i * k % nx) / nx);
+                tmp[j * nx + k] = sum;
+            }
+        for (std::size_t l = 0; l < ny; ++l)
+            for (std::size_t k = 0; k < nx; ++k)
+            {
+                complex_type sum = 0;
+                for (std::size_t j = 0; j < ny; ++j)
+                    sum += tmp[j * nx + k] * std::polar(real_type(1), - two_pi * real_type(j * l % ny) / ny);
+                // shell of the wave number (aliased wave numbers above n/2 are negative ones)
+                const real_type kx = real_type(std::min(k, nx - k)), ky = real_type(std::min(l, ny - l));
+                const std::size_t shell = static_cast<std::size_t>(std::round(std::sqrt(kx * kx + ky * ky)));
+                if (shell < spectrum.size())
+                    spectrum[shell] += std::norm(sum) / (2 * real_type(N) * N);
+            }
+    }
+    values = std::move(spectrum);
+}
+
+
+/*! FloeSizeDistributionReducer
+ *
+ * Number of floes per area class, the classes being logarithmically spaced between min_area and max_area
+ * (floes outside the range are counted in the first or last class).
+ */
+template <typename TFloeGroup>
+class FloeSizeDistributionReducer : public DiagnosticReducer<TFloeGroup>
+{
+
+public:
+    using base_type = DiagnosticReducer<TFloeGroup>;
+    using typename base_type::floe_type;
+    using typename base_type::real_type;
+    using typename base_type::value_vector;
+
+    FloeSizeDistributionReducer(std::size_t nb_classes, real_type min_area, real_type max_area) :
+        m_nb_classes{std::max(nb_classes, std::size_t(1))},
+        m_log_min{std::log(min_area)}, m_log_max{std::log(std::max(max_area, min_area * 2))} {}
+
+    virtual std::string name() const override { return "floe_size_distribution"; }
+    virtual std::size_t size() const override { return m_nb_classes; }
+
+    virtual void accumulate(floe_type const& floe, std::size_t, value_vector& acc) const override
+    {
+        if (floe.is_obstacle()) return;
+        const real_type x = (std::log(floe.area()) - m_log_min) / (m_log_max - m_log_min) * m_nb_classes;
+        acc[(x > 0) ? std::min(static_cast<std::size_t>(x), m_nb_classes - 1) : 0] += 1;
+    }
+
+private:
+    std::size_t m_nb_classes; //!< Number of area classes
+    real_type m_log_min, m_log_max; //!< Log of the area range
+};
+
+
+/*! DispersionReducer
+ *
+ * Absolute dispersion of the floes from their positions at the first reduction:
+ * [nb of floes, mean displacement x, y, displacement variance x, y, covariance xy].
+ */
+template <typename TFloeGroup>
+class DispersionReducer : public DiagnosticReducer<TFloeGroup>
+{
+
+public:
+    using base_type = DiagnosticReducer<TFloeGroup>;
+    using typename base_type::floe_type;
+    using typename base_type::real_type;
+    using typename base_type::point_type;
+    using typename base_type::value_vector;
+
+    virtual std::string name() const override { return "dispersion"; }
+    virtual std::size_t size() const override { return 6; }
+
+    virtual void prepare(TFloeGroup const& floe_group) override
+    {
+        if (!m_origins.empty()) return;
+        for (auto const& floe : floe_group.get_floes())
+            m_origins.push_back(floe.state().real_position());
+    }
+
+    //! Floes created afterwards (fracture) are not considered
+    virtual void accumulate(floe_type const& floe, std::size_t id, value_vector& acc) const override
+    {
+        if (id >= m_origins.size() || floe.is_obstacle()) return;
+        const point_type d = floe.state().real_position() - m_origins[id];
+        acc[0] += 1;
+        acc[1] += d.x;
+        acc[2] += d.y;
+        acc[3] += d.x * d.x;
+        acc[4] += d.y * d.y;
+        acc[5] += d.x * d.y;
+    }
+
+    virtual void finalize(value_vector& values) const override
+    {
+        const real_type n = values[0];
+        if (n == 0) return;
+        const real_type mx = values[1] / n, my = values[2] / n;
+        values = {n, mx, my, values[3] / n - mx * mx, values[4] / n - my * my, values[5] / n - mx * my};
+    }
+
+private:
+    std::vector<point_type> m_origins; //!< Floe positions at the first reduction
+};
+
+
+/*! DiagnosticsManager
+ *
+ * Runs the registered reducers every out_step (in s) and keeps the resulting lines (time, values...)
+ * per dataset name until they are given to the output manager.
+ */
+template <typename TFloeGroup>
+class DiagnosticsManager
+{
+
+public:
+    using floe_group_type = TFloeGroup;
+    using real_type = typename TFloeGroup::real_type;
+    using reducer_type = DiagnosticReducer<TFloeGroup>;
+    using record_type = std::pair<std::string, std::vector<real_type>>; //!< dataset name, line (time first)
+
+    DiagnosticsManager() : m_out_step{0}, m_next_out_limit{-1} {}
+
+    //! Time step between diagnostics (0 disables them), the first ones being computed at the next call
+    inline void set_out_step(real_type out_step) { m_out_step = out_step; m_next_out_limit = -1; }
+    inline bool is_enabled() const { return m_out_step > 0 && !m_reducers.empty(); }
+    inline void add_reducer(std::unique_ptr<reducer_type> reducer) { m_reducers.push_back(std::move(reducer)); }
+    inline std::size_t nb_reducers() const { return m_reducers.size(); }
+    /*! Register the gridded fields, kinetic energy spectrum, floe size distribution and dispersion reducers
+     *
+     * \param grid_size            number of cells along each direction of the diagnostic grids.
+     * \param min_area, max_area   area range of the floe size distribution (40 classes).
+     */
+    void add_default_reducers(std::size_t grid_size, real_type min_area, real_type max_area)
+    {
+        using floe_group_type = TFloeGroup;
+        add_reducer(std::unique_ptr<reducer_type>(new GriddedFieldsReducer<floe_group_type>(grid_size, grid_size)));
+        add_reducer(std::unique_ptr<reducer_type>(new KineticEnergySpectrumReducer<floe_group_type>(grid_size, grid_size)));
+        add_reducer(std::unique_ptr<reducer_type>(new FloeSizeDistributionReducer<floe_group_type>(40, min_area, max_area)));
+        add_reducer(std::unique_ptr<reducer_type>(new DispersionReducer<floe_group_type>()));
+    }
+
+    /*! Run the reducers if time has reached the next diagnostic time
+     *
+     * \return true if new records are available.
+     */
+    bool reduce_if_needed(real_type time, floe_group_type const& floe_group);
+    //! Run the reducers and record their values
+    void reduce(real_type time, floe_group_type const& floe_group);
+
+    inline std::vector<record_type> const& records() const { return m_records; }
+    inline void clear() { m_records.clear(); }
+
+private:
+    std::vector<std::unique_ptr<reducer_type>> m_reducers; //!< Registered reducers
+    std::vector<record_type> m_records; //!< Lines not given to the output manager yet
+    real_type m_out_step; //!< Time step between diagnostics
+    real_type m_next_out_limit; //!< Next diagnostic time (negative before the first diagnostics)
+};
+
+
+template <typename TFloeGroup>
+bool
+DiagnosticsManager<TFloeGroup>::reduce_if_needed(real_type time, floe_group_type const& floe_group)
+{
+    if (!is_enabled())
+        return false;
+    if (m_next_out_limit < 0)
+        m_next_out_limit = time;
+    if (time < m_next_out_limit)
+        return false;
+    reduce(time, floe_group);
+    m_next_out_limit += m_out_step;
+    return true;
+}
+
+template <typename TFloeGroup>
+void
+DiagnosticsManager<TFloeGroup>::reduce(real_type time, floe_group_type const& floe_group)
+{
+    auto const& floes = floe_group.get_floes();
+    for (auto& reducer : m_reducers)
+    {
+        reducer->prepare(floe_group);
+        std::vector<std::vector<real_type>> acc;
+        reducer_type const& r = *reducer;
+        #pragma omp parallel
+        {
+            // one accumulator per thread of the actual team (a single one when nested in an ensemble member)
+            #pragma omp single
+            {
+                #ifdef _OPENMP
+                acc.assign(omp_get_num_threads(), std::vector<real_type>(r.accumulator_size(), 0));
+                #else
+                acc.assign(1, std::vector<real_type>(r.accumulator_size(), 0));
+                #endif
+            }
+            #pragma omp for
+            for (std::size_t i = 0; i < floes.size(); ++i)
+            {
+                #ifdef _OPENMP
+                const std::size_t thread = omp_get_thread_num();
+                #else
+                const std::size_t thread = 0;
+                #endif
+                if (floes[i].is_active())
+                    r.accumulate(floes[i], i, acc[thread]);
+            }
+        }
+        for (std::size_t t = 1; t < acc.size(); ++t)
+            for (std::size_t k = 0; k < acc[0].size(); ++k)
+                acc[0][k] += acc[t][k];
+        r.finalize(acc[0]);
+
+        std::vector<real_type> line{time};
+        line.insert(line.end(), acc[0].begin(), acc[0].end());
+        m_records.emplace_back(r.name(), std::move(line));
+    }
+}
+
+
+}} // namespace floe::io
+
+#endif // FLOE_IO_DIAGNOSTICS_HPP
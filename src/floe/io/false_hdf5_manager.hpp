@@ -38,6 +38,10 @@ public:
 
     void save_step(real_type time, const dynamics_mgr_type&){}
     void flush(){}
+    template <typename TContactImpulses>
+    void add_contact_impulses(TContactImpulses const&){}
+    template <typename TRecords>
+    void add_diagnostics(TRecords const&){}
     double recover_states(std::string filename, real_type time, floe_group_type&, dynamics_mgr_type&){ return 0; }
     inline void set_floe_group(floe_group_type const& floe_group) { }
     std::string const& out_file_name(){}
@@ -0,0 +1,259 @@
+/*!
+ * \file floe/io/forcing_series.hpp
+ * \brief Chunked access to hourly ocean/wind time series stored in an indexed binary file.
+ */
+
+#ifndef FLOE_IO_FORCING_SERIES_HPP
+#define FLOE_IO_FORCING_SERIES_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <ios>
+#include <string>
+#include <vector>
+
+namespace floe { namespace io
+{
+
+//! File signature of the forcing series files
+static constexpr char forcing_series_magic[8] = {'F', 'L', 'O', 'E', 'F', 'R', 'C', '1'};
+
+/*! Write hourly ocean and air data into a forcing series file
+ *
+ * Layout: signature (8 bytes), number of hours (uint64), then per hour the record
+ * (ocean x, ocean y, air x, air y) as doubles. The record of hour i is at a fixed offset.
+ */
+template <typename TPoint>
+void write_forcing_series(std::string const& file_name,
+                          std::vector<TPoint> const& ocean_data,
+                          std::vector<TPoint> const& air_data)
+{
+    std::ofstream file(file_name, std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw std::ios_base::failure("Error creating forcing series file \"" + file_name + "\"");
+    const std::uint64_t nb_hours = std::min(ocean_data.size(), air_data.size());
+    file.write(forcing_series_magic, sizeof(forcing_series_magic));
+    file.write(reinterpret_cast<char const*>(&nb_hours), sizeof(nb_hours));
+    for (std::size_t i = 0; i < nb_hours; ++i)
+    {
+        const double record[4] = {double(ocean_data[i].x), double(ocean_data[i].y),
+                                  double(air_data[i].x), double(air_data[i].y)};
+        file.write(reinterpret_cast<char const*>(record), sizeof(record));
+    }
+    if (!file)
+        throw std::ios_base::failure("Error writing forcing series file \"" + file_name + "\"");
+}
+
+
+/*! ForcingSeries
+ *
+ * Ocean and air speeds from an hourly forcing series file, without loading the whole series:
+ * only a window of hours around the current time is kept in memory, and the following window is read
+ * in the background when the current time passes the middle of the window.
+ * Values are given per minute with the same interpolation as PhysicalData for in-memory data:
+ * linear ramp in polar coordinates from rest during the first 12 hours, then between consecutive hours.
+ *
+ * prepare(t) must be called sequentially (at the beginning of a time step) so that the concurrent
+ * calls to ocean(t) and air(t) during the step only read the current window.
+ *
+ * \tparam TPoint   Type of point.
+ */
+template <typename TPoint>
+class ForcingSeries
+{
+
+public:
+    using point_type = TPoint;
+    using real_type = decltype(TPoint::x);
+
+    ForcingSeries() : m_nb_hours{0}, m_window_size{0}, m_first{0}, m_next_first{0} {}
+    ForcingSeries(ForcingSeries const&) = delete;
+    ForcingSeries& operator=(ForcingSeries const&) = delete;
+    ~ForcingSeries() { if (m_next.valid()) m_next.wait(); }
+
+    /*! Open a forcing series file
+     *
+     * \param file_name     forcing series file (see write_forcing_series).
+     * \param window_size   number of hours kept in memory (at least 2).
+     */
+    void open(std::string const& file_name, std::size_t window_size);
+
+    inline bool is_open() const { return m_nb_hours != 0; }
+    inline std::size_t nb_hours() const { return m_nb_hours; }
+    //! First hour and number of hours of the window in memory
+    inline std::size_t window_first() const { return m_first; }
+    inline std::size_t window_size() const { return m_records.size(); }
+
+    //! Load the window containing time t (in s) if needed, and prefetch the next one
+    void prepare(real_type t);
+
+    //! Ocean and air speeds at time t (in s)
+    inline point_type ocean(real_type t) { return value(t, 0); }
+    inline point_type air(real_type t) { return value(t, 2); }
+
+private:
+    using record_type = std::array<real_type, 4>; //!< ocean x, ocean y, air x, air y
+    using window_type = std::vector<record_type>;
+
+    static constexpr std::size_t init_minutes = 12 * 60; //!< Duration of the initial ramp from rest
+
+    std::string m_file_name;
+    std::size_t m_nb_hours; //!< Number of hours in the file
+    std::size_t m_window_size; //!< Number of hours per window
+    std::size_t m_first; //!< First hour of the window in memory
+    window_type m_records; //!< Records of the window in memory
+    std::size_t m_next_first; //!< First hour of the prefetched window
+    std::future<window_type> m_next; //!< Prefetched window
+
+    //! Read the records of hours [first, first + size) from the file
+    static window_type read_window(std::string file_name, std::size_t first, std::size_t size);
+    //! Hour index of the upper bound of the interpolation at time t (the lower bound is the hour before)
+    std::size_t hour_index(real_type t, real_type& frac) const;
+    //! Interpolated value at time t of the record components (k, k + 1)
+    point_type value(real_type t, std::size_t k);
+    //! Make the window containing hours [hour - 1, hour] current
+    void load(std::size_t hour);
+    //! Polar interpolation between p0 and p1
+    static point_type polar_interpolation(point_type const& p0, point_type const& p1, real_type frac);
+};
+
+template <typename TPoint>
+constexpr std::size_t ForcingSeries<TPoint>::init_minutes;
+
+
+template <typename TPoint>
+void
+ForcingSeries<TPoint>::open(std::string const& file_name, std::size_t window_size)
+{
+    std::ifstream file(file_name, std::ios::binary);
+    if (!file)
+        throw std::ios_base::failure("Error opening forcing series file \"" + file_name + "\"");
+    char magic[sizeof(forcing_series_magic)];
+    std::uint64_t nb_hours = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&nb_hours), sizeof(nb_hours));
+    if (!file || std::memcmp(magic, forcing_series_magic, sizeof(magic)) != 0 || nb_hours == 0)
+        throw std::ios_base::failure("Invalid forcing series file \"" + file_name + "\"");
+
+    if (m_next.valid()) m_next.wait();
+    m_next = std::future<window_type>{};
+    m_file_name = file_name;
+    m_nb_hours = nb_hours;
+    m_window_size = std::max(window_size, std::size_t(2));
+    m_first = 0;
+    m_records = read_window(m_file_name, 0, m_window_size);
+}
+
+template <typename TPoint>
+typename ForcingSeries<TPoint>::window_type
+ForcingSeries<TPoint>::read_window(std::string file_name, std::size_t first, std::size_t size)
+{
+    std::ifstream file(file_name, std::ios::binary);
+    std::uint64_t nb_hours = 0;
+    file.seekg(sizeof(forcing_series_magic));
+    file.read(reinterpret_cast<char*>(&nb_hours), sizeof(nb_hours));
+    size = (first < nb_hours) ? std::min<std::size_t>(size, nb_hours - first) : 0;
+    std::vector<double> buffer(4 * size);
+    file.seekg(sizeof(forcing_series_magic) + sizeof(nb_hours) + first * 4 * sizeof(double));
+    file.read(reinterpret_cast<char*>(buffer.data()), buffer.size() * sizeof(double));
+    if (!file)
+        throw std::ios_base::failure("Error reading forcing series file \"" + file_name + "\"");
+    window_type records(size);
+    for (std::size_t i = 0; i < size; ++i)
+        for (std::size_t k = 0; k < 4; ++k)
+            records[i][k] = buffer[4 * i + k];
+    return records;
+}
+
+template <typename TPoint>
+std::size_t
+ForcingSeries<TPoint>::hour_index(real_type t, real_type& frac) const
+{
+    // same minute discretization as PhysicalData, the last minute being kept after the end of the series
+    const std::size_t nb_minutes = init_minutes + 60 * (m_nb_hours - 1);
+    const std::size_t minute = std::min(static_cast<std::size_t>(std::max(t, real_type(0)) / 60), nb_minutes - 1);
+    if (minute < init_minutes)
+    {
+        frac = real_type(minute) / init_minutes;
+        return 0;
+    }
+    frac = real_type((minute - init_minutes) % 60) / 60;
+    return (minute - init_minutes) / 60 + 1;
+}
+
+template <typename TPoint>
+void
+ForcingSeries<TPoint>::prepare(real_type t)
+{
+    if (!is_open()) return;
+    real_type frac;
+    const std::size_t hour = hour_index(t, frac);
+    if (hour < m_first + (hour > 0) || hour >= m_first + m_records.size())
+        load(hour);
+
+    // prefetch the next window (overlapping the current one by an hour) once the middle is passed
+    const std::size_t next_first = m_first + m_records.size() - 1;
+    if (!m_next.valid() && hour >= m_first + m_records.size() / 2 && next_first + 1 < m_nb_hours)
+    {
+        m_next_first = next_first;
+        m_next = std::async(std::launch::async, &ForcingSeries::read_window, m_file_name, next_first, m_window_size);
+    }
+}
+
+template <typename TPoint>
+void
+ForcingSeries<TPoint>::load(std::size_t hour)
+{
+    const std::size_t first = (hour > 0) ? hour - 1 : 0;
+    if (m_next.valid())
+    {
+        window_type next = m_next.get();
+        if (first >= m_next_first && hour < m_next_first + next.size())
+        {
+            m_first = m_next_first;
+            m_records = std::move(next);
+            return;
+        }
+    }
+    m_first = first;
+    m_records = read_window(m_file_name, first, m_window_size);
+}
+
+template <typename TPoint>
+TPoint
+ForcingSeries<TPoint>::value(real_type t, std::size_t k)
+{
+    real_type frac;
+    const std::size_t hour = hour_index(t, frac);
+    if (hour < m_first + (hour > 0) || hour >= m_first + m_records.size())
+        load(hour); // not prepared (sequential use only)
+    const record_type& r1 = m_records[hour - m_first];
+    const point_type p1{r1[k], r1[k + 1]};
+    if (hour == 0)
+        return polar_interpolation(point_type{0, 0}, p1, frac);
+    const record_type& r0 = m_records[hour - 1 - m_first];
+    return polar_interpolation(point_type{r0[k], r0[k + 1]}, p1, frac);
+}
+
+template <typename TPoint>
+TPoint
+ForcingSeries<TPoint>::polar_interpolation(point_type const& p0, point_type const& p1, real_type frac)
+{
+    const real_type r0 = std::sqrt(p0.x * p0.x + p0.y * p0.y), r1 = std::sqrt(p1.x * p1.x + p1.y * p1.y);
+    real_type a0 = std::atan2(p0.y, p0.x);
+    const real_type a1 = std::atan2(p1.y, p1.x);
+    if (std::abs(a1 - a0) > M_PI) // to avoid doing more than a U turn
+        a0 += std::copysign(2 * M_PI, a1 - a0);
+    const real_type r = (1 - frac) * r0 + frac * r1, a = (1 - frac) * a0 + frac * a1;
+    return {r * std::cos(a), r * std::sin(a)};
+}
+
+
+}} // namespace floe::io
+
+#endif // FLOE_IO_FORCING_SERIES_HPP
@@ -8,7 +8,9 @@
 #define FLOE_IO_HDF5_FLOE_GROUP_IMPORT_HPP
 
 #include <iostream>
-#include "floe/generator/mesh_generator.hpp"
+#include <utility>
+#include <vector>
+#include "floe/generator/mesh_service.hpp"
 #include "boost/multi_array.hpp"
 
 #include "H5Cpp.h"
@@ -21,8 +23,12 @@ namespace floe { namespace io
 {
 
 
+/*! Imports floe shapes and initial states
+ *
+ * \param generate_meshes  false to leave the floe meshes empty (set afterwards, see io::mesh_node_slice).
+ */
 template <typename TFloeGroup>
-void import_floes_from_hdf5(H5std_string filename, TFloeGroup& floe_group)
+void import_floes_from_hdf5(H5std_string filename, TFloeGroup& floe_group, bool generate_meshes = true)
 {
     using namespace H5;
     
@@ -88,6 +94,10 @@ void import_floes_from_hdf5(H5std_string filename, TFloeGroup& floe_group)
     std::size_t previous_nb_floes = floe_list.size();
     floe_list.resize(previous_nb_floes + nb_floes);
 
+    // read the shapes (and optional oceanic skin drags) first, to mesh them in a batch
+    std::vector<geometry_type> shapes;
+    std::vector<std::pair<bool, real_type>> skin_drags;
+    shapes.reserve(nb_floes);
     for (std::size_t floe_id = 0; floe_id < nb_floes; ++floe_id)
     {
         try
@@ -112,37 +122,15 @@ void import_floes_from_hdf5(H5std_string filename, TFloeGroup& floe_group)
             {
                 boundary.push_back(point_type{data_out[j][0], data_out[j][1]});
             }
-            // create mesh
-            auto mesh = floe::generator::generate_mesh_for_shape<geometry_type, mesh_type>(shape);
-            floe_type& floe = floe_list[previous_nb_floes + floe_id];
-            // link static floe
-            floe.attach_static_floe_ptr(std::unique_ptr<static_floe_type>(new static_floe_type()));
-            auto& static_floe = floe.static_floe();
-            // Attach boundary
-            std::unique_ptr<geometry_type> geometry(new geometry_type(shape));
-            static_floe.attach_geometry_ptr(std::move(geometry));
-            // Attach mesh
-            mesh_type& floe_mesh = floe.get_floe_h().m_static_mesh;
-            floe_mesh = mesh;
-            floe.static_floe().attach_mesh_ptr(&floe_mesh);
-
-            floe_group.get_floe_group_h().add_floe(floe.get_floe_h());
-
-            floe.set_state({
-                {states_data_out[floe_id][0], states_data_out[floe_id][1]}, states_data_out[floe_id][2],
-                {states_data_out[floe_id][3], states_data_out[floe_id][4]}, states_data_out[floe_id][5],
-                {0,0}
-            });
-            if (states_data_out[floe_id].size() >= 11) { // thickness (11th value) was not present before 2023
-                floe.static_floe().set_thickness(states_data_out[floe_id][10]);
-            }
+            shapes.push_back(std::move(shape));
+            skin_drags.emplace_back(false, 0);
             try {
                 // read oceanic skin drag attributes
                 Attribute attr = dataset.openAttribute("C_w");
                 DataType type = attr.getDataType();
                 real_type val;
                 attr.read(type, &val);
-                floe.static_floe().set_C_w(val);
+                skin_drags.back() = {true, val};
             }
             catch(AttributeIException) {
                 // do nothing, thickness and oceanic skin drag attributes will be set randomly
@@ -154,6 +142,39 @@ void import_floes_from_hdf5(H5std_string filename, TFloeGroup& floe_group)
         }
     }
 
+    // create meshes (in parallel, once per similar shapes)
+    std::vector<mesh_type> meshes = generate_meshes
+        ? floe::generator::generate_meshes_for_shapes<geometry_type, mesh_type>(shapes)
+        : std::vector<mesh_type>(shapes.size());
+
+    for (std::size_t floe_id = 0; floe_id < shapes.size(); ++floe_id)
+    {
+        floe_type& floe = floe_list[previous_nb_floes + floe_id];
+        // link static floe
+        floe.attach_static_floe_ptr(std::unique_ptr<static_floe_type>(new static_floe_type()));
+        auto& static_floe = floe.static_floe();
+        // Attach boundary
+        std::unique_ptr<geometry_type> geometry(new geometry_type(std::move(shapes[floe_id])));
+        static_floe.attach_geometry_ptr(std::move(geometry));
+        // Attach mesh
+        mesh_type& floe_mesh = floe.get_floe_h().m_static_mesh;
+        floe_mesh = std::move(meshes[floe_id]);
+        floe.static_floe().attach_mesh_ptr(&floe_mesh);
+
+        floe_group.get_floe_group_h().add_floe(floe.get_floe_h());
+
+        floe.set_state({
+            {states_data_out[floe_id][0], states_data_out[floe_id][1]}, states_data_out[floe_id][2],
+            {states_data_out[floe_id][3], states_data_out[floe_id][4]}, states_data_out[floe_id][5],
+            {0,0}
+        });
+        if (states_data_out[floe_id].size() >= 11) { // thickness (11th value) was not present before 2023
+            floe.static_floe().set_thickness(states_data_out[floe_id][10]);
+        }
+        if (skin_drags[floe_id].first)
+            floe.static_floe().set_C_w(skin_drags[floe_id].second);
+    }
+
     // Import states
     DataSet window_dataset = file.openDataSet( "window" );
     real_type win_data[4];
@@ -12,7 +12,10 @@
 #include <algorithm>
 #include <ctime>
 #include <math.h>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 #include "boost/multi_array.hpp"
 #include "floe/floes/floe_group.hpp"
 
@@ -36,6 +39,17 @@ namespace floe { namespace io
  *
  */
 
+/*! Lock of the HDF5 file accesses made during a simulation
+ *
+ * The HDF5 library is usually not built thread-safe: problems run by several threads (ensemble members)
+ * write their out files one at a time.
+ */
+inline std::mutex& hdf5_mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
 // Get array size at compile time
 template<typename>
 struct array_size;
@@ -58,6 +72,7 @@ public:
     using real_type = typename TFloeGroup::real_type;
     using point_type = typename TFloeGroup::point_type; 
     using saved_state_type = std::array<real_type, 11>; //!< state dataset chunk size for each floe / time step
+    using contact_impulse_type = std::array<real_type, 7>; //!< contact impulses dataset line (see lcp::ContactImpulseRecord)
 
     //! Default constructor.
     HDF5Manager(floe_group_type const& floe_group);
@@ -70,6 +85,40 @@ public:
     void save_step_if_needed(real_type time, const dynamics_mgr_type&);
     //! Save the current simulation state for output
     void save_step(real_type time, const dynamics_mgr_type&);
+    /*! Temporarily saves contact impulses lines, written at the next flush
+     *
+     * The lines are flushed as soon as they fill a chunk of the dataset (the pending states with them, as after
+     * a fracture), the contacts of many steps being recorded between two state outputs.
+     */
+    void add_contact_impulses(std::vector<contact_impulse_type> const& contact_impulses) {
+        m_data_chunk_contacts.insert(m_data_chunk_contacts.end(), contact_impulses.begin(), contact_impulses.end());
+        if (m_data_chunk_contacts.size() >= m_contacts_chunk_size && m_step_count != 0)
+        {
+            flush();
+            m_chunk_step_count = 0;
+        }
+    }
+    /*! Temporarily saves diagnostic lines (dataset name, line), written at the next flush
+     *
+     * Each dataset of the "diagnostics" group has one line (time, values...) per diagnostic step.
+     * The lines are flushed as soon as one dataset fills a chunk (see add_contact_impulses).
+     */
+    template <typename TRecords>
+    void add_diagnostics(TRecords const& records) {
+        bool is_full = false;
+        for (auto const& record : records)
+        {
+            auto& chunk = m_data_chunk_diagnostics[record.first];
+            chunk.first = record.second.size();
+            chunk.second.insert(chunk.second.end(), record.second.begin(), record.second.end());
+            if (chunk.first != 0 && chunk.second.size() >= m_diagnostics_chunk_size * chunk.first) is_full = true;
+        }
+        if (is_full && m_step_count != 0)
+        {
+            flush();
+            m_chunk_step_count = 0;
+        }
+    }
     //! Flush temporarily saved data
     void flush();
     //! Recover simulation state from file
@@ -120,6 +169,10 @@ private:
     boost::multi_array<real_type, 2> m_data_chunk_mass_center; //!< Temp saved floe group mass centers
     boost::multi_array<real_type, 2> m_data_chunk_OBL_speed; //!< Temp saved ocean datas
     real_type* m_data_chunk_kinE; //!< Temp saved Kinetic Energy
+    std::vector<contact_impulse_type> m_data_chunk_contacts; //!< Temp saved contact impulses
+    const hsize_t m_contacts_chunk_size; //!< Chunk size (lines) of the contact impulses dataset
+    std::map<std::string, std::pair<hsize_t, vector<real_type>>> m_data_chunk_diagnostics; //!< Temp saved diagnostics (line size, lines)
+    const hsize_t m_diagnostics_chunk_size; //!< Chunk size (lines) of the diagnostics datasets
 
     // output
     real_type m_out_step; //!< Time step between simulation state outputs
@@ -137,6 +190,8 @@ private:
     void write_OBL_speed();
     void write_window();
     void write_kinE();
+    void write_contact_impulses();
+    void write_diagnostics();
 
     inline std::size_t nb_considered_floes() const { return m_floe_ids.size() ? m_floe_ids.size() : m_floe_group->get_floes().size(); }
     inline typename floe_group_type::floe_type const& get_floe(std::size_t id) const {
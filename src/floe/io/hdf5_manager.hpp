@@ -25,6 +25,8 @@ HDF5Manager<TFloeGroup, TDynamicsMgr>::HDF5Manager(floe_group_type const& floe_g
     m_data_chunk_mass_center(boost::extents[m_flush_max_step][2]),
     m_data_chunk_OBL_speed(boost::extents[m_flush_max_step][2]),
     m_data_chunk_kinE{new real_type[m_flush_max_step]},
+    m_data_chunk_contacts{}, m_contacts_chunk_size{1024}, m_data_chunk_diagnostics{},
+    m_diagnostics_chunk_size{256},
     m_out_step{0}, m_next_out_limit{0}, m_nb_floe_shapes_written{0}, m_shapes_group{nullptr}
     {}
 
@@ -113,8 +115,10 @@ void HDF5Manager<TFloeGroup, TDynamicsMgr>::save_step(real_type time, const dyna
 
 template <typename TFloeGroup, typename TDynamicsMgr>
 void HDF5Manager<TFloeGroup, TDynamicsMgr>::flush() {
-    if (m_chunk_step_count == 0)
+    // contact impulses and diagnostics alone are only appended to an existing out file
+    if (m_chunk_step_count == 0 && ((m_data_chunk_contacts.empty() && m_data_chunk_diagnostics.empty()) || m_step_count == 0))
         return;
+    std::lock_guard<std::mutex> lock(hdf5_mutex());
     try
     {   
         /*
@@ -149,12 +153,19 @@ void HDF5Manager<TFloeGroup, TDynamicsMgr>::flush() {
         try { m_out_file->openDataSet("window"); }
         catch (...) { write_window(); }
 
-        // write_boundaries();
-        write_states();
-        write_time();
-        write_mass_center();
-        write_OBL_speed();
-        write_kinE();
+        if (m_chunk_step_count != 0)
+        {
+            // write_boundaries();
+            write_states();
+            write_time();
+            write_mass_center();
+            write_OBL_speed();
+            write_kinE();
+        }
+        if (!m_data_chunk_contacts.empty())
+            write_contact_impulses();
+        if (!m_data_chunk_diagnostics.empty())
+            write_diagnostics();
 
         // Close the file after each flush to keep a valid ouput even if program crashes
         delete m_out_file;
@@ -425,12 +436,104 @@ void HDF5Manager<TFloeGroup, TDynamicsMgr>::write_kinE() {
     kinE_dataset.write(m_data_chunk_kinE, PredType::NATIVE_DOUBLE, memspace, filespace);
 };
 
+template <typename TFloeGroup, typename TDynamicsMgr>
+void HDF5Manager<TFloeGroup, TDynamicsMgr>::write_contact_impulses() {
+
+    H5File& file( *m_out_file );
+    const int   RANK = 2;
+    const hsize_t line_size = array_size<contact_impulse_type>::size;
+
+    /* saving contact impulses (time, floe1, floe2, x, y, normal, tangential) */
+    DataSet dataset;
+    hsize_t     dims[RANK] = {0, line_size};
+    const hsize_t     new_dims[RANK] = {m_data_chunk_contacts.size(), line_size};
+    try {
+        dataset = file.openDataSet("contact_impulses");
+        dataset.getSpace().getSimpleExtentDims(dims);
+    } catch (...) {
+        FloatType datatype( PredType::NATIVE_DOUBLE );
+        datatype.setOrder( H5T_ORDER_LE );
+        hsize_t maxdims[RANK] = {H5S_UNLIMITED, line_size};
+        DataSpace dataspace( RANK, dims, maxdims );
+        // Modify dataset creation property to enable chunking
+        DSetCreatPropList prop;
+        const hsize_t chunk_dims[RANK] = {m_contacts_chunk_size, line_size};
+        prop.setChunk(RANK, chunk_dims);
+
+        dataset = file.createDataSet("contact_impulses", datatype, dataspace, prop);
+    }
+    // Extend the dataset.
+    const hsize_t offset[RANK] = {dims[0], 0};
+    dims[0] += new_dims[0];
+    dataset.extend(dims);
+
+    DataSpace filespace = dataset.getSpace();
+    filespace.selectHyperslab(H5S_SELECT_SET, new_dims, offset);
+    // Define memory space.
+    DataSpace memspace{RANK, new_dims, NULL};
+
+    dataset.write(m_data_chunk_contacts.data(), PredType::NATIVE_DOUBLE, memspace, filespace);
+
+    // clearing buffer (keeping its capacity)
+    m_data_chunk_contacts.clear();
+};
+
+template <typename TFloeGroup, typename TDynamicsMgr>
+void HDF5Manager<TFloeGroup, TDynamicsMgr>::write_diagnostics() {
+
+    H5File& file( *m_out_file );
+    const int   RANK = 2;
+
+    Group diagnostics_group;
+    try { diagnostics_group = file.openGroup("diagnostics"); }
+    catch (...) { diagnostics_group = file.createGroup("diagnostics"); }
+
+    /* saving diagnostic lines (time, values...), one dataset per diagnostic */
+    for (auto const& chunk : m_data_chunk_diagnostics)
+    {
+        const hsize_t line_size = chunk.second.first;
+        if (line_size == 0 || chunk.second.second.empty()) continue;
+        DataSet dataset;
+        hsize_t     dims[RANK] = {0, line_size};
+        const hsize_t     new_dims[RANK] = {chunk.second.second.size() / line_size, line_size};
+        try {
+            dataset = diagnostics_group.openDataSet(chunk.first);
+            dataset.getSpace().getSimpleExtentDims(dims);
+        } catch (...) {
+            FloatType datatype( PredType::NATIVE_DOUBLE );
+            datatype.setOrder( H5T_ORDER_LE );
+            hsize_t maxdims[RANK] = {H5S_UNLIMITED, line_size};
+            DataSpace dataspace( RANK, dims, maxdims );
+            // Modify dataset creation property to enable chunking
+            DSetCreatPropList prop;
+            const hsize_t chunk_dims[RANK] = {m_diagnostics_chunk_size, line_size};
+            prop.setChunk(RANK, chunk_dims);
+
+            dataset = diagnostics_group.createDataSet(chunk.first, datatype, dataspace, prop);
+        }
+        // Extend the dataset.
+        const hsize_t offset[RANK] = {dims[0], 0};
+        dims[0] += new_dims[0];
+        dataset.extend(dims);
+
+        DataSpace filespace = dataset.getSpace();
+        filespace.selectHyperslab(H5S_SELECT_SET, new_dims, offset);
+        // Define memory space.
+        DataSpace memspace{RANK, new_dims, NULL};
+
+        dataset.write(chunk.second.second.data(), PredType::NATIVE_DOUBLE, memspace, filespace);
+    }
+
+    // clearing buffer
+    m_data_chunk_diagnostics.clear();
+};
+
 template <typename TFloeGroup, typename TDynamicsMgr>
 double HDF5Manager<TFloeGroup, TDynamicsMgr>::recover_states(
         H5std_string filename, real_type time, floe_group_type& floe_group,
         dynamics_mgr_type& dynamics_manager, bool keep_as_outfile)
 {
-    
+    std::lock_guard<std::mutex> lock(hdf5_mutex());
     /*
      * Open the specified file and the specified dataset in the file.
      */
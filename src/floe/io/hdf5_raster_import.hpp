@@ -0,0 +1,112 @@
+/*!
+ * \file io/hdf5_raster_import.hpp
+ * \brief Labelled raster reading and input file writing in hdf5 format
+ */
+
+#ifndef FLOE_IO_HDF5_RASTER_IMPORT_HPP
+#define FLOE_IO_HDF5_RASTER_IMPORT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "boost/multi_array.hpp"
+#include "floe/io/raster_import.hpp"
+
+#include "H5Cpp.h"
+
+
+namespace floe { namespace io
+{
+
+/*! Reads a labelled raster from an hdf5 file
+ *
+ * The labels are the 2D dataset "labels" (rows from the top of the image). The pixel size (m) is read
+ * from its attribute "pixel_size" if any, default_pixel_size is used otherwise.
+ */
+template <typename T>
+LabelRaster<T> read_h5_label_raster(H5std_string filename, T default_pixel_size = 1)
+{
+    using namespace H5;
+
+    H5File file( filename, H5F_ACC_RDONLY );
+    DataSet dataset = file.openDataSet( "labels" );
+    DataSpace dataspace = dataset.getSpace();
+    hsize_t dims_out[2];
+    dataspace.getSimpleExtentDims( dims_out, NULL );
+
+    LabelRaster<T> raster;
+    raster.ny = dims_out[0];
+    raster.nx = dims_out[1];
+    raster.pixel_size = default_pixel_size;
+    raster.labels.resize(raster.nx * raster.ny);
+    dataset.read( raster.labels.data(), PredType::NATIVE_UINT32 );
+    if (dataset.attrExists("pixel_size"))
+    {
+        double val;
+        dataset.openAttribute("pixel_size").read(PredType::NATIVE_DOUBLE, &val);
+        raster.pixel_size = val;
+    }
+    return raster;
+}
+
+/*! Writes an input file (same layout as the generator and pack_creator ones)
+ *
+ * \param filename  Output file name.
+ * \param floes     Floes (shapes relative to their centroid, states at rest).
+ * \param window    Initial window (min_x, max_x, min_y, max_y).
+ */
+template <typename TPoint, typename T>
+void write_raster_floes_input(H5std_string filename, std::vector<RasterFloe<TPoint>> const& floes,
+                              std::array<T, 4> const& window)
+{
+    using namespace H5;
+
+    H5File file( filename, H5F_ACC_TRUNC );
+    FloatType datatype( PredType::NATIVE_DOUBLE );
+    datatype.setOrder( H5T_ORDER_LE );
+
+    /* shapes */
+    Group shapes_group = file.createGroup("floe_shapes");
+    for (std::size_t i = 0; i != floes.size(); ++i)
+    {
+        auto const& shape = floes[i].shape;
+        hsize_t dimsf[2] = {shape.size(), 2};
+        DataSpace dataspace( 2, dimsf );
+        DataSet dataset = shapes_group.createDataSet(H5std_string{std::to_string(i)}, datatype, dataspace);
+        boost::multi_array<double, 2> data(boost::extents[dimsf[0]][dimsf[1]]);
+        for (std::size_t j = 0; j != dimsf[0]; ++j)
+        {
+            data[j][0] = shape[j].x;
+            data[j][1] = shape[j].y;
+        }
+        dataset.write( data.data(), PredType::NATIVE_DOUBLE );
+    }
+
+    /* states at t = 0: pos, theta, speed, rot, impulse, real pos */
+    const hsize_t state_size = 9;
+    hsize_t dims[3] = {1, floes.size(), state_size};
+    DataSpace states_space( 3, dims );
+    DataSet states_dataset = file.createDataSet("floe_states", datatype, states_space);
+    boost::multi_array<double, 3> states(boost::extents[1][floes.size()][state_size]);
+    for (std::size_t i = 0; i != floes.size(); ++i)
+    {
+        auto const& pos = floes[i].pos;
+        const double state[state_size] = {pos.x, pos.y, 0, 0, 0, 0, 0, pos.x, pos.y};
+        std::copy(state, state + state_size, &states[0][i][0]);
+    }
+    states_dataset.write( states.data(), PredType::NATIVE_DOUBLE );
+
+    /* window */
+    hsize_t win_dims[1] = {4};
+    DataSpace win_space( 1, win_dims );
+    DataSet win_dataset = file.createDataSet("window", datatype, win_space);
+    const double win[4] = {window[0], window[1], window[2], window[3]};
+    win_dataset.write( win, PredType::NATIVE_DOUBLE );
+}
+
+
+}} // namespace floe::io
+
+#endif // FLOE_IO_HDF5_RASTER_IMPORT_HPP
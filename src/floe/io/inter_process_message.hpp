@@ -24,6 +24,7 @@ enum JobTag {
     move_job,
     interpene_job,
     test_job,
+    subgraph_job,
     termination_signal
 };
 
@@ -38,6 +39,7 @@ public:
     // Type traits
     using real_type = T;
     using id_list_type = std::vector<std::size_t>;
+    using task_list_type = std::vector<id_list_type>;
 
     //! Default constructor.
     InterProcessMessage() {}
@@ -64,6 +66,9 @@ public:
     inline void interpenetration(bool b) { m_interpenetration = b; }
     inline int mpi_source() const { return m_mpi_source; }
     inline void mpi_source(int n) { m_mpi_source = n; }
+    //! Floe ids of the collision subgraphs left to the subgraph tasks (collision job response)
+    inline task_list_type const& subgraph_tasks() const { return m_subgraph_tasks; }
+    inline void store_subgraph_tasks(task_list_type const& tasks) { m_subgraph_tasks = tasks; }
     template<typename TPoint>
     inline void store_OBL_contribution(TPoint speed){ m_OBL_speed = { {speed.x, speed.y} }; }
     template<typename TPoint>
@@ -107,7 +112,7 @@ public:
     {
     archive( m_id, m_tag, m_floe_ids, m_states, m_delta_t,
         m_time, m_nb_LCP_solved, m_interpenetration,
-        m_mpi_source, m_OBL_speed ); // serialize things by passing them to the archive
+        m_mpi_source, m_OBL_speed, m_subgraph_tasks ); // serialize things by passing them to the archive
     }
 
 private:
@@ -122,6 +127,7 @@ private:
     int m_mpi_source = -1;
     //! OBL speed, worker sends speed difference, master returns absolute speed
     std::array<real_type, 2> m_OBL_speed;
+    task_list_type m_subgraph_tasks;
 };
 
 }} // namespace floe::io
@@ -13,6 +13,7 @@
 #include <matio.h>
 
 #include "floe/geometry/geometries/point.hpp" 
+#include "floe/io/forcing_series.hpp"
 
 #include <iostream> // DEBUG
 
@@ -69,10 +70,10 @@ void read_topaz_from_file( std::string const& file_name,
     if ((x_air->dims[0] != y_air->dims[0]) || (x_ocean->dims[0] != y_ocean->dims[0]))
         fprintf(stderr,"x and y vector sizes are not equal !\n");
 
-    for ( std::size_t i = 0; i < x_air->dims[0]; ++i )
+    for ( std::size_t i = 0; i < x_ocean->dims[0]; ++i )
         ocean_data.push_back({static_cast<T*>(x_ocean->data)[i], static_cast<T*>(y_ocean->data)[i]});
 
-    for ( std::size_t i = 0; i < x_ocean->dims[0]; ++i )
+    for ( std::size_t i = 0; i < x_air->dims[0]; ++i )
         air_data.push_back({static_cast<T*>(x_air->data)[i], static_cast<T*>(y_air->data)[i]});
 
     // freeing memory
@@ -83,6 +84,20 @@ void read_topaz_from_file( std::string const& file_name,
 }
 
 
+/*! Converts a topaz .mat file into a forcing series file (see floe::io::ForcingSeries)
+ *
+ * \param file_name Topaz file name.
+ * \param series_file_name Forcing series file name.
+ */
+inline void convert_topaz_to_forcing_series( std::string const& file_name,
+                                             std::string const& series_file_name )
+{
+    std::vector<floe::geometry::Point<double>> ocean_data, air_data;
+    read_topaz_from_file(file_name, ocean_data, air_data);
+    write_forcing_series(series_file_name, ocean_data, air_data);
+}
+
+
 }}} // namespace floe::io::matlab
 
 #endif // FLOE_IO_MATLAB_TOPAZ_IMPORT_HPP
@@ -0,0 +1,229 @@
+/*!
+ * \file floe/io/mpi_shared_floes.hpp
+ * \brief Static floe geometry meshed by slices on the processes of a node and shared by them in MPI-3 shared memory windows
+ */
+
+#ifndef IO_MPI_SHARED_FLOES_HPP
+#define IO_MPI_SHARED_FLOES_HPP
+
+#include <mpi.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "floe/generator/mesh_service.hpp"
+#include "floe/utils/shared_storage_allocator.hpp"
+
+namespace floe { namespace io
+{
+
+/*! Communicator of the processes sharing memory with the calling one (same node)
+ *
+ * The process of node rank 0 is the leader of the node.
+ */
+class NodeCommunicator
+{
+public:
+    NodeCommunicator(MPI_Comm comm = MPI_COMM_WORLD) {
+        MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &m_comm);
+        MPI_Comm_rank(m_comm, &m_rank);
+        MPI_Comm_size(m_comm, &m_size);
+    }
+    NodeCommunicator(NodeCommunicator const&) = delete;
+    NodeCommunicator& operator=(NodeCommunicator const&) = delete;
+    ~NodeCommunicator() { MPI_Comm_free(&m_comm); }
+
+    inline MPI_Comm comm() const { return m_comm; }
+    inline int rank() const { return m_rank; }
+    inline int size() const { return m_size; }
+    inline bool is_leader() const { return m_rank == 0; }
+    //! True on all the processes of the node if flag is true on one of them (collective call)
+    inline bool any(bool flag) const {
+        int value = flag, result;
+        MPI_Allreduce(&value, &result, 1, MPI_INT, MPI_MAX, m_comm);
+        return result != 0;
+    }
+
+private:
+    MPI_Comm m_comm;
+    int m_rank;
+    int m_size;
+};
+
+/*! Array in a node shared memory window (MPI_Win_allocate_shared)
+ *
+ * The memory is allocated by the node leader and mapped by the other processes of the node.
+ * Writes must be surrounded by fence() calls to be seen by the other processes.
+ * The window is freed by a collective call: all the processes of the node destroy the array at the same point.
+ *
+ * \tparam T    Value type (trivially copyable).
+ */
+template <typename T>
+class NodeSharedArray
+{
+public:
+    /*!
+     * \param node  Node communicator (collective call).
+     * \param size  Number of values (only significant on the node leader).
+     */
+    NodeSharedArray(NodeCommunicator const& node, std::size_t size) {
+        unsigned long long n = size;
+        MPI_Bcast(&n, 1, MPI_UNSIGNED_LONG_LONG, 0, node.comm());
+        m_size = n;
+        const MPI_Aint bytes = node.is_leader() ? m_size * sizeof(T) : 0;
+        void* base;
+        MPI_Win_allocate_shared(bytes, sizeof(T), MPI_INFO_NULL, node.comm(), &base, &m_win);
+        MPI_Aint leader_bytes;
+        int disp_unit;
+        MPI_Win_shared_query(m_win, 0, &leader_bytes, &disp_unit, &m_data);
+    }
+    NodeSharedArray(NodeSharedArray const&) = delete;
+    NodeSharedArray& operator=(NodeSharedArray const&) = delete;
+    ~NodeSharedArray() { MPI_Win_free(&m_win); }
+
+    inline T* data() { return m_data; }
+    inline T const* data() const { return m_data; }
+    inline std::size_t size() const { return m_size; }
+    //! Synchronization of the node processes (collective call)
+    inline void fence() { MPI_Win_fence(0, m_win); }
+
+private:
+    MPI_Win m_win;
+    T* m_data;
+    std::size_t m_size;
+};
+
+/*! Static floe geometry of the node (boundaries, mesh points and triangles, in the floe frames)
+ *
+ * Kept alive by the floe group whose floes are attached to it (see share_static_floes).
+ */
+template <typename TPoint>
+struct NodeSharedGeometry
+{
+    using triangle_type = std::array<std::size_t, 3>;
+
+    NodeSharedGeometry(NodeCommunicator const& node, std::size_t nb_boundary, std::size_t nb_points, std::size_t nb_triangles)
+        : boundaries(node, nb_boundary), points(node, nb_points), triangles(node, nb_triangles) {}
+    //! Synchronization of the node processes (collective call)
+    void fence() { boundaries.fence(); points.fence(); triangles.fence(); }
+
+    NodeSharedArray<TPoint> boundaries;     //!< Boundary points of all the floes
+    NodeSharedArray<TPoint> points;         //!< Mesh points of all the floes
+    NodeSharedArray<triangle_type> triangles; //!< Mesh triangles of all the floes
+};
+
+/*! Meshes the floes of the node slice of the calling process (floe n with n % node.size() == node.rank())
+ *
+ * The other floe meshes are left as they are (e.g. empty, until share_static_floes).
+ */
+template <typename TFloeGroup>
+void mesh_node_slice(NodeCommunicator const& node, TFloeGroup& floe_group)
+{
+    using floe_type = typename TFloeGroup::floe_type;
+    using geometry_type = typename floe_type::geometry_type;
+    using mesh_type = typename floe_type::mesh_type;
+
+    auto& floes = floe_group.get_floes();
+    std::vector<geometry_type> shapes;
+    for (std::size_t n = node.rank(); n < floes.absolute_size(); n += node.size())
+        shapes.push_back(floes(n).static_floe().get_geometry());
+    auto meshes = floe::generator::generate_meshes_for_shapes<geometry_type, mesh_type>(shapes);
+    for (std::size_t n = node.rank(), k = 0; n < floes.absolute_size(); n += node.size(), ++k)
+    {
+        auto& floe = floes(n);
+        mesh_type& floe_mesh = floe.get_floe_h().m_static_mesh;
+        floe_mesh = std::move(meshes[k]);
+        floe.static_floe().attach_mesh_ptr(&floe_mesh);
+        floe.static_floe().set_density(floe.static_floe().get_density()); // resets the cached moment constant
+        floe.update();
+    }
+}
+
+/*! Shares the static floe geometry between the processes of the node
+ *
+ * The process of node rank r provides the boundaries and meshes of its node slice of floes (see mesh_node_slice).
+ * They are written once in node shared windows, to which the boundaries and meshes of the floes of all the
+ * processes of the node are then attached (no copy, see utils::SharedStorageAllocator): the node holds one copy
+ * of the static geometry, whatever its number of processes. The windows are kept by the floe group
+ * (see FloeGroup::keep_static_storage) until the floes are destroyed or shared again.
+ * Collective call on the node communicator. The floe lists must have the same size on all processes.
+ */
+template <typename TFloeGroup>
+void share_static_floes(NodeCommunicator const& node, TFloeGroup& floe_group)
+{
+    using floe_type = typename TFloeGroup::floe_type;
+    using point_type = typename floe_type::point_type;
+    using storage_type = NodeSharedGeometry<point_type>;
+    using triangle_type = typename storage_type::triangle_type;
+
+    if (node.size() == 1) return;
+    auto& floes = floe_group.get_floes();
+    const std::size_t nb_floes = floes.absolute_size();
+
+    // sizes of the floe geometries, each set by the process providing it
+    std::vector<unsigned long long> sizes(3 * nb_floes, 0);
+    for (std::size_t n = node.rank(); n < nb_floes; n += node.size())
+    {
+        auto const& static_floe = floes(n).static_floe();
+        sizes[3 * n] = static_floe.get_geometry().outer().size();
+        sizes[3 * n + 1] = static_floe.mesh().points().size();
+        sizes[3 * n + 2] = static_floe.mesh().connectivity().size();
+    }
+    MPI_Allreduce(MPI_IN_PLACE, sizes.data(), static_cast<int>(sizes.size()), MPI_UNSIGNED_LONG_LONG, MPI_SUM, node.comm());
+    std::vector<std::size_t> offsets(3 * (nb_floes + 1), 0);
+    for (std::size_t i = 0; i < sizes.size(); ++i) offsets[i + 3] = offsets[i] + sizes[i];
+
+    auto storage = std::make_shared<storage_type>(node, offsets[3 * nb_floes], offsets[3 * nb_floes + 1], offsets[3 * nb_floes + 2]);
+    storage->fence();
+    for (std::size_t n = node.rank(); n < nb_floes; n += node.size())
+    {
+        auto const& static_floe = floes(n).static_floe();
+        auto const& boundary = static_floe.get_geometry().outer();
+        auto const& mesh = static_floe.mesh();
+        std::copy(boundary.begin(), boundary.end(), storage->boundaries.data() + offsets[3 * n]);
+        std::copy(mesh.points().begin(), mesh.points().end(), storage->points.data() + offsets[3 * n + 1]);
+        std::copy(mesh.connectivity().begin(), mesh.connectivity().end(), storage->triangles.data() + offsets[3 * n + 2]);
+    }
+    storage->fence();
+
+    for (std::size_t n = 0; n < nb_floes; ++n)
+    {
+        auto& floe = floes(n);
+        auto& static_floe = floe.static_floe();
+        auto& floe_mesh = floe.get_floe_h().m_static_mesh;
+        utils::attach_storage<point_type>(static_floe.geometry().outer(), storage->boundaries.data() + offsets[3 * n], sizes[3 * n]);
+        utils::attach_storage<point_type>(floe_mesh.points(), storage->points.data() + offsets[3 * n + 1], sizes[3 * n + 1]);
+        utils::attach_storage<triangle_type>(floe_mesh.connectivity(), storage->triangles.data() + offsets[3 * n + 2], sizes[3 * n + 2]);
+        static_floe.attach_mesh_ptr(&floe_mesh);
+        static_floe.set_density(static_floe.get_density()); // resets the cached moment constant
+        floe.update();
+    }
+    floe_group.keep_static_storage(storage);
+}
+
+/*! Runs a loading step on every process of the node, before a collective call on the node
+ *
+ * The load status is shared first, so that if the loading fails on one process (e.g. on the leader,
+ * the others waiting for its geometry), it throws on all of them instead of leaving them in the collective call.
+ */
+template <typename TLoad>
+void load_on_node(NodeCommunicator const& node, TLoad load)
+{
+    std::exception_ptr error;
+    try { load(); }
+    catch (...) { error = std::current_exception(); }
+    if (node.any(error != nullptr))
+    {
+        if (error) std::rethrow_exception(error);
+        throw std::runtime_error("Floe loading failed on another process of the node");
+    }
+}
+
+}} // namespace floe::io
+
+
+#endif // IO_MPI_SHARED_FLOES_HPP
@@ -124,6 +124,16 @@ public:
         }
         for (auto& mgr : this->m_out_managers) mgr.save_step_if_needed(time, dyn_mgr);
     }
+    //! Contact impulses are only saved in the main out file
+    template <typename TContactImpulses>
+    void add_contact_impulses(TContactImpulses const& contact_impulses){
+        this->m_out_managers[0].add_contact_impulses(contact_impulses);
+    }
+    //! Diagnostics are only saved in the main out file
+    template <typename TRecords>
+    void add_diagnostics(TRecords const& records){
+        this->m_out_managers[0].add_diagnostics(records);
+    }
     //! Flush temporarily saved data
     void flush(){
         for (auto& mgr : this->m_out_managers) mgr.flush();
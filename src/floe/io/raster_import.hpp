@@ -0,0 +1,314 @@
+/*!
+ * \file floe/io/raster_import.hpp
+ * \brief Floe contours extraction from a labelled raster (segmented imagery).
+ */
+
+#ifndef FLOE_IO_RASTER_IMPORT_HPP
+#define FLOE_IO_RASTER_IMPORT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "floe/geometry/algorithms/simplify.hpp"
+
+namespace floe { namespace io
+{
+
+/*! Labelled raster
+ *
+ * Each pixel holds the label of the floe it belongs to (0 for water).
+ * Rows are stored from the top of the image, pixel (i, j) being the column i and the row j from the bottom,
+ * of center ((i + 1/2) * pixel_size, (j + 1/2) * pixel_size).
+ */
+template <typename T>
+struct LabelRaster
+{
+    std::size_t nx = 0; //!< Number of columns
+    std::size_t ny = 0; //!< Number of rows
+    T pixel_size = 1; //!< Pixel size (m)
+    std::vector<std::uint32_t> labels; //!< Row major labels, first row at the top
+
+    inline std::uint32_t operator()(std::size_t i, std::size_t j) const { return labels[(ny - 1 - j) * nx + i]; }
+    //! Domain covered by the image (min_x, max_x, min_y, max_y)
+    inline std::array<T, 4> window() const { return {{0, nx * pixel_size, 0, ny * pixel_size}}; }
+};
+
+//! Floe extracted from a raster
+template <typename TPoint>
+struct RasterFloe
+{
+    std::uint32_t label; //!< Label in the raster
+    std::vector<TPoint> shape; //!< Counterclockwise boundary, relative to the floe centroid
+    TPoint pos; //!< Centroid
+};
+
+//! Reads a raw raster of nx * ny native uint32 labels (row major, first row at the top)
+template <typename T>
+LabelRaster<T> read_raw_label_raster(std::string const& filename, std::size_t nx, std::size_t ny, T pixel_size)
+{
+    LabelRaster<T> raster;
+    raster.nx = nx;
+    raster.ny = ny;
+    raster.pixel_size = pixel_size;
+    raster.labels.resize(nx * ny);
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.read(reinterpret_cast<char*>(raster.labels.data()), raster.labels.size() * sizeof(std::uint32_t)))
+        throw std::runtime_error("Cannot read " + std::to_string(nx * ny) + " uint32 labels from " + filename);
+    return raster;
+}
+
+
+namespace detail { namespace raster
+{
+
+/*! Outer contour of a label by marching squares
+ *
+ * The largest 4-connected component of the label is kept and its holes are filled. The squares join the
+ * centers of the pixels of its bounding box (plus a one pixel margin). The contour points are the middles of the
+ * square edges separating the component from the rest, each square edge giving at most one outgoing segment
+ * (component on the left). The saddle squares separate the diagonal pixels, consistently with the 4-connectivity.
+ *
+ * \param nb_pixels     Set to the number of pixels of the filled component.
+ * \return  the counterclockwise contour, in pixel units of the raster.
+ */
+template <typename TPoint, typename T>
+std::vector<TPoint> label_contour(LabelRaster<T> const& raster, std::uint32_t label, std::array<std::size_t, 4> const& box,
+                                  std::size_t& nb_pixels)
+{
+    // local grid of pixel centers, with a margin of one pixel
+    const std::size_t W = box[1] - box[0] + 3, H = box[3] - box[2] + 3;
+    std::vector<char> inside(W * H, 0);
+    for (std::size_t lj = 1; lj + 1 < H; ++lj)
+        for (std::size_t li = 1; li + 1 < W; ++li)
+            inside[lj * W + li] = (raster(box[0] + li - 1, box[2] + lj - 1) == label);
+
+    // largest 4-connected component
+    std::vector<int> component(W * H, -1);
+    std::vector<std::size_t> stack;
+    int best_component = -1;
+    std::size_t best_size = 0;
+    for (std::size_t start = 0, nb_components = 0; start < W * H; ++start)
+    {
+        if (!inside[start] || component[start] >= 0) continue;
+        std::size_t size = 0;
+        component[start] = nb_components;
+        stack.push_back(start);
+        while (!stack.empty())
+        {
+            const std::size_t k = stack.back();
+            stack.pop_back();
+            ++size;
+            for (std::size_t nk : {k - 1, k + 1, k - W, k + W}) // the margin is outside
+                if (inside[nk] && component[nk] < 0) { component[nk] = nb_components; stack.push_back(nk); }
+        }
+        if (size > best_size) { best_size = size; best_component = nb_components; }
+        ++nb_components;
+    }
+    // holes filling: the pixels not reached from the margin by 8-connected paths out of the component
+    std::vector<char> outside(W * H, 0);
+    for (std::size_t k = 0; k < W * H; ++k)
+    {
+        const std::size_t li = k % W, lj = k / W;
+        if (li == 0 || lj == 0 || li + 1 == W || lj + 1 == H) { outside[k] = 1; stack.push_back(k); }
+    }
+    while (!stack.empty())
+    {
+        const std::size_t k = stack.back();
+        stack.pop_back();
+        const std::size_t li = k % W, lj = k / W;
+        for (std::size_t nj = (lj ? lj - 1 : 0); nj <= std::min(lj + 1, H - 1); ++nj)
+            for (std::size_t ni = (li ? li - 1 : 0); ni <= std::min(li + 1, W - 1); ++ni)
+            {
+                const std::size_t nk = nj * W + ni;
+                if (!outside[nk] && component[nk] != best_component) { outside[nk] = 1; stack.push_back(nk); }
+            }
+    }
+    nb_pixels = 0;
+    for (std::size_t k = 0; k < W * H; ++k)
+    {
+        inside[k] = !outside[k];
+        nb_pixels += inside[k];
+    }
+
+    // square edge ids: horizontal edge from node (li, lj) = 2 * node, vertical edge = 2 * node + 1
+    auto edge_point = [&](std::size_t id) {
+        const std::size_t node = id / 2;
+        const T u = T(node % W), v = T(node / W);
+        return (id % 2) ? TPoint{u, v + T(0.5)} : TPoint{u + T(0.5), v};
+    };
+    const std::size_t nb_edges = 2 * W * H;
+    std::vector<std::size_t> next(nb_edges, nb_edges);
+    for (std::size_t cj = 0; cj + 1 < H; ++cj)
+        for (std::size_t ci = 0; ci + 1 < W; ++ci)
+        {
+            const std::size_t a = cj * W + ci, b = a + 1, c = a + W + 1, d = a + W;
+            const int code = inside[a] + 2 * inside[b] + 4 * inside[c] + 8 * inside[d];
+            if (code == 0 || code == 15) continue;
+            const std::size_t B = 2 * a, R = 2 * b + 1, Tp = 2 * d, L = 2 * a + 1;
+            // segments as pairs of edges, and the corners of each edge
+            std::array<std::size_t, 4> segments;
+            std::size_t nb_segments = 1;
+            switch (code)
+            {
+                case 1: case 14: segments = {{L, B, 0, 0}}; break;
+                case 2: case 13: segments = {{B, R, 0, 0}}; break;
+                case 4: case 11: segments = {{R, Tp, 0, 0}}; break;
+                case 8: case 7:  segments = {{Tp, L, 0, 0}}; break;
+                case 3: case 12: segments = {{L, R, 0, 0}}; break;
+                case 6: case 9:  segments = {{B, Tp, 0, 0}}; break;
+                case 5:  segments = {{L, B, R, Tp}}; nb_segments = 2; break;
+                case 10: segments = {{B, R, Tp, L}}; nb_segments = 2; break;
+            }
+            auto corners = [&](std::size_t e) {
+                if (e == B) return std::array<std::size_t, 2>{{a, b}};
+                if (e == R) return std::array<std::size_t, 2>{{b, c}};
+                if (e == Tp) return std::array<std::size_t, 2>{{d, c}};
+                return std::array<std::size_t, 2>{{a, d}};
+            };
+            for (std::size_t s = 0; s < nb_segments; ++s)
+            {
+                const std::size_t e1 = segments[2 * s], e2 = segments[2 * s + 1];
+                const auto ends = corners(e1);
+                const std::size_t q = inside[ends[0]] ? ends[0] : ends[1];
+                const TPoint p1 = edge_point(e1), p2 = edge_point(e2);
+                const TPoint pq{T(q % W), T(q / W)};
+                // label on the left of the oriented segment
+                if ((p2.x - p1.x) * (pq.y - p1.y) - (p2.y - p1.y) * (pq.x - p1.x) > 0)
+                    next[e1] = e2;
+                else
+                    next[e2] = e1;
+            }
+        }
+
+    // closed contour (the largest one, should round-off make several)
+    std::vector<TPoint> best;
+    T best_area = 0;
+    std::vector<bool> visited(nb_edges, false);
+    for (std::size_t start = 0; start < nb_edges; ++start)
+    {
+        if (next[start] == nb_edges || visited[start]) continue;
+        std::vector<TPoint> ring;
+        T area = 0;
+        for (std::size_t e = start; !visited[e]; e = next[e])
+        {
+            visited[e] = true;
+            ring.push_back(edge_point(e));
+        }
+        for (std::size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++)
+            area += ring[j].x * ring[i].y - ring[i].x * ring[j].y;
+        if (area > best_area)
+        {
+            best_area = area;
+            best = std::move(ring);
+        }
+    }
+    for (auto& p : best)
+    {
+        p.x = (box[0] + p.x - T(0.5)) * raster.pixel_size;
+        p.y = (box[2] + p.y - T(0.5)) * raster.pixel_size;
+    }
+    return best;
+}
+
+}} // namespace detail::raster
+
+
+/*! Floes of a labelled raster
+ *
+ * The labels are processed in parallel: the outer contour of each label is extracted by marching squares,
+ * simplified (topology preserving, see floe::geometry::simplify_ring), scaled about its centroid to the area of
+ * the label pixels and centered on it. A label made of several 4-connected components keeps its largest one,
+ * the holes are filled (not handled by the floe meshes).
+ *
+ * \param raster        Labelled raster.
+ * \param max_error     Max distance between the contour and its simplification, in pixels.
+ * \param min_pixels    Labels with fewer pixels are ignored.
+ * \return  the floes, by increasing label.
+ */
+template <typename TPoint, typename T>
+std::vector<RasterFloe<TPoint>>
+extract_raster_floes(LabelRaster<T> const& raster, T max_error = 0.5, std::size_t min_pixels = 4)
+{
+    // bounding box (i_min, i_max, j_min, j_max) and number of pixels of each label
+    std::unordered_map<std::uint32_t, std::size_t> ids;
+    std::vector<std::uint32_t> labels;
+    std::vector<std::array<std::size_t, 4>> boxes;
+    std::vector<std::size_t> nb_pixels;
+    for (std::size_t j = 0; j < raster.ny; ++j)
+        for (std::size_t i = 0; i < raster.nx; ++i)
+        {
+            const std::uint32_t label = raster(i, j);
+            if (label == 0) continue;
+            auto it = ids.find(label);
+            if (it == ids.end())
+            {
+                it = ids.emplace(label, labels.size()).first;
+                labels.push_back(label);
+                boxes.push_back({{i, i, j, j}});
+                nb_pixels.push_back(0);
+            }
+            auto& box = boxes[it->second];
+            box[0] = std::min(box[0], i); box[1] = std::max(box[1], i);
+            box[3] = j;
+            ++nb_pixels[it->second];
+        }
+
+    std::vector<std::size_t> order(labels.size());
+    for (std::size_t k = 0; k < order.size(); ++k) order[k] = k;
+    std::sort(order.begin(), order.end(), [&](std::size_t k1, std::size_t k2) { return labels[k1] < labels[k2]; });
+
+    std::vector<RasterFloe<TPoint>> floes(labels.size());
+    std::vector<char> valid(labels.size(), 0);
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (std::size_t n = 0; n < order.size(); ++n)
+    {
+        const std::size_t k = order[n];
+        if (nb_pixels[k] < min_pixels) continue;
+        std::size_t nb_floe_pixels;
+        auto ring = detail::raster::label_contour<TPoint>(raster, labels[k], boxes[k], nb_floe_pixels);
+        floe::geometry::simplify_ring(ring, ring, max_error * raster.pixel_size);
+        if (ring.size() < 3) continue;
+
+        // centroid and area of the contour
+        T area = 0, cx = 0, cy = 0;
+        for (std::size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++)
+        {
+            const T c = ring[j].x * ring[i].y - ring[i].x * ring[j].y;
+            area += c;
+            cx += (ring[j].x + ring[i].x) * c;
+            cy += (ring[j].y + ring[i].y) * c;
+        }
+        if (!(area > 0)) continue;
+        cx /= 3 * area;
+        cy /= 3 * area;
+        area /= 2;
+        const T ratio = std::sqrt(nb_floe_pixels * raster.pixel_size * raster.pixel_size / area);
+
+        RasterFloe<TPoint>& floe = floes[n];
+        floe.label = labels[k];
+        floe.pos = TPoint{cx, cy};
+        floe.shape.reserve(ring.size());
+        for (auto const& p : ring)
+            floe.shape.push_back(TPoint{ratio * (p.x - cx), ratio * (p.y - cy)});
+        valid[n] = 1;
+    }
+
+    std::vector<RasterFloe<TPoint>> result;
+    result.reserve(floes.size());
+    for (std::size_t n = 0; n < floes.size(); ++n)
+        if (valid[n]) result.push_back(std::move(floes[n]));
+    return result;
+}
+
+
+}} // namespace floe::io
+
+#endif // FLOE_IO_RASTER_IMPORT_HPP
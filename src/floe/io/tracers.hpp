@@ -0,0 +1,268 @@
+/*!
+ * \file floe/io/tracers.hpp
+ * \brief Virtual buoys: Lagrangian tracers attached to the floes and written as a small dataset.
+ */
+
+#ifndef FLOE_IO_TRACERS_HPP
+#define FLOE_IO_TRACERS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace floe { namespace io
+{
+
+/*! TracerManager
+ *
+ * Each tracer is attached to the floe containing its initial position and moves with the rigid motion of this floe
+ * (its coordinates are kept in the floe frame). When its floe is deactivated (fracture, melting), the tracer
+ * is attached again to the active floe containing its current position. Tracers out of any floe stay in place.
+ * The floes candidate for a point are found with a uniform grid of the floe bounding disks (broad phase),
+ * before the point in polygon test.
+ *
+ * Every out_step, a line (time, then x, y and floe id per tracer, floe id being -1 for a free tracer)
+ * is recorded for the "tracers" dataset.
+ *
+ * \tparam TFloeGroup   Type of floe group.
+ */
+template <typename TFloeGroup>
+class TracerManager
+{
+
+public:
+    using floe_group_type = TFloeGroup;
+    using floe_type = typename TFloeGroup::floe_type;
+    using real_type = typename TFloeGroup::real_type;
+    using point_type = typename TFloeGroup::point_type;
+    using record_type = std::pair<std::string, std::vector<real_type>>; //!< dataset name, line (time first)
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max(); //!< floe id of free tracers
+
+    TracerManager() : m_out_step{0}, m_next_out_limit{-1} {}
+
+    //! Initial tracer positions (attached at the first record)
+    void set_points(std::vector<point_type> const& points);
+    //! Time step between tracer records (0 disables them)
+    inline void set_out_step(real_type out_step) { m_out_step = out_step; m_next_out_limit = -1; }
+    inline bool is_enabled() const { return m_out_step > 0 && !m_tracers.empty(); }
+    inline std::size_t nb_tracers() const { return m_tracers.size(); }
+    //! Current position and floe of a tracer
+    inline point_type position(std::size_t i) const { return m_tracers[i].position; }
+    inline std::size_t floe_id(std::size_t i) const { return m_tracers[i].floe; }
+
+    /*! Record the tracer positions if time has reached the next record time
+     *
+     * \return true if a new record is available.
+     */
+    bool record_if_needed(real_type time, floe_group_type const& floe_group);
+    //! Update the tracer positions (attaching the tracers without active floe) and record them
+    void record(real_type time, floe_group_type const& floe_group);
+
+    inline std::vector<record_type> const& records() const { return m_records; }
+    inline void clear() { m_records.clear(); }
+
+private:
+    struct Tracer
+    {
+        point_type position; //!< Position (real position, see SpaceTimeState::real_position)
+        point_type point; //!< Position in the frame of the floe geometries (for attachment)
+        point_type local; //!< Coordinates in the floe frame
+        std::size_t floe; //!< Floe id (npos if free)
+    };
+
+    std::vector<Tracer> m_tracers;
+    std::vector<record_type> m_records; //!< Lines not given to the output manager yet
+    real_type m_out_step; //!< Time step between records
+    real_type m_next_out_limit; //!< Next record time (negative before the first record)
+
+    //! Update the positions from the floe states, returns the number of tracers to attach again
+    std::size_t update_positions(floe_group_type const& floe_group);
+    //! Attach the tracers without active floe to the active floe containing them
+    void attach(floe_group_type const& floe_group);
+
+    static inline point_type rotate(point_type const& p, real_type theta)
+    {
+        const real_type c = std::cos(theta), s = std::sin(theta);
+        return { c * p.x - s * p.y, s * p.x + c * p.y };
+    }
+    //! Point in ring test (ray casting)
+    template <typename TRing>
+    static bool in_ring(point_type const& p, TRing const& ring);
+    //! Point in polygon test (outer ring minus inner rings)
+    template <typename TPolygon>
+    static bool in_polygon(point_type const& p, TPolygon const& polygon);
+};
+
+template <typename TFloeGroup>
+constexpr std::size_t TracerManager<TFloeGroup>::npos;
+
+
+template <typename TFloeGroup>
+void
+TracerManager<TFloeGroup>::set_points(std::vector<point_type> const& points)
+{
+    m_tracers.clear();
+    for (auto const& p : points)
+        m_tracers.push_back({p, p, p, npos});
+    m_next_out_limit = -1;
+}
+
+template <typename TFloeGroup>
+bool
+TracerManager<TFloeGroup>::record_if_needed(real_type time, floe_group_type const& floe_group)
+{
+    if (!is_enabled())
+        return false;
+    if (m_next_out_limit < 0)
+    {
+        attach(floe_group);
+        m_next_out_limit = time;
+    }
+    if (time < m_next_out_limit)
+        return false;
+    record(time, floe_group);
+    m_next_out_limit += m_out_step;
+    return true;
+}
+
+template <typename TFloeGroup>
+void
+TracerManager<TFloeGroup>::record(real_type time, floe_group_type const& floe_group)
+{
+    if (update_positions(floe_group))
+        attach(floe_group);
+
+    std::vector<real_type> line{time};
+    line.reserve(1 + 3 * m_tracers.size());
+    for (auto const& tracer : m_tracers)
+    {
+        line.push_back(tracer.position.x);
+        line.push_back(tracer.position.y);
+        line.push_back((tracer.floe == npos) ? real_type(-1) : real_type(tracer.floe));
+    }
+    m_records.emplace_back("tracers", std::move(line));
+}
+
+template <typename TFloeGroup>
+std::size_t
+TracerManager<TFloeGroup>::update_positions(floe_group_type const& floe_group)
+{
+    auto const& floes = floe_group.get_floes();
+    std::size_t nb_detached = 0;
+    #pragma omp parallel for reduction(+:nb_detached)
+    for (std::size_t i = 0; i < m_tracers.size(); ++i)
+    {
+        Tracer& tracer = m_tracers[i];
+        if (tracer.floe == npos) continue;
+        if (tracer.floe >= floes.size()) { tracer.floe = npos; ++nb_detached; continue; }
+        auto const& floe = floes[tracer.floe];
+        auto const& state = floe.state();
+        const point_type offset = rotate(tracer.local, state.theta);
+        tracer.point = state.pos + offset;
+        tracer.position = state.real_position() + offset;
+        if (!floe.is_active()) { tracer.floe = npos; ++nb_detached; }
+    }
+    return nb_detached;
+}
+
+template <typename TFloeGroup>
+void
+TracerManager<TFloeGroup>::attach(floe_group_type const& floe_group)
+{
+    auto const& floes = floe_group.get_floes();
+
+    // bounding disks of the active floes
+    std::vector<std::size_t> ids;
+    std::vector<point_type> centers;
+    std::vector<real_type> radii;
+    real_type min_x = std::numeric_limits<real_type>::max(), min_y = min_x;
+    real_type max_x = std::numeric_limits<real_type>::lowest(), max_y = max_x, mean_radius = 0;
+    for (std::size_t n = 0; n < floes.size(); ++n)
+    {
+        auto const& floe = floes[n];
+        if (!floe.is_active() || floe.is_obstacle()) continue;
+        const point_type c = floe.state().pos;
+        real_type r2 = 0;
+        for (auto const& p : floe.geometry().outer())
+            r2 = std::max(r2, (p.x - c.x) * (p.x - c.x) + (p.y - c.y) * (p.y - c.y));
+        const real_type r = std::sqrt(r2);
+        ids.push_back(n);
+        centers.push_back(c);
+        radii.push_back(r);
+        min_x = std::min(min_x, c.x - r); max_x = std::max(max_x, c.x + r);
+        min_y = std::min(min_y, c.y - r); max_y = std::max(max_y, c.y + r);
+        mean_radius += r;
+    }
+    if (ids.empty()) return;
+    mean_radius /= ids.size();
+
+    // uniform grid of the disks (cells of a mean floe diameter)
+    const real_type cell_size = std::max(2 * mean_radius, std::numeric_limits<real_type>::min());
+    const std::size_t nx = std::min<std::size_t>(static_cast<std::size_t>((max_x - min_x) / cell_size) + 1, 4096);
+    const std::size_t ny = std::min<std::size_t>(static_cast<std::size_t>((max_y - min_y) / cell_size) + 1, 4096);
+    const real_type dx = std::max((max_x - min_x) / nx, cell_size), dy = std::max((max_y - min_y) / ny, cell_size);
+    auto cell_x = [&](real_type x) { return std::min(static_cast<std::size_t>(std::max(x - min_x, real_type(0)) / dx), nx - 1); };
+    auto cell_y = [&](real_type y) { return std::min(static_cast<std::size_t>(std::max(y - min_y, real_type(0)) / dy), ny - 1); };
+    std::vector<std::vector<std::size_t>> cells(nx * ny);
+    for (std::size_t k = 0; k < ids.size(); ++k)
+        for (std::size_t j = cell_y(centers[k].y - radii[k]); j <= cell_y(centers[k].y + radii[k]); ++j)
+            for (std::size_t i = cell_x(centers[k].x - radii[k]); i <= cell_x(centers[k].x + radii[k]); ++i)
+                cells[j * nx + i].push_back(k);
+
+    #pragma omp parallel for
+    for (std::size_t t = 0; t < m_tracers.size(); ++t)
+    {
+        Tracer& tracer = m_tracers[t];
+        if (tracer.floe != npos) continue;
+        const point_type p = tracer.point;
+        if (p.x < min_x || p.x > max_x || p.y < min_y || p.y > max_y) continue;
+        for (std::size_t k : cells[cell_y(p.y) * nx + cell_x(p.x)])
+        {
+            const point_type d = p - centers[k];
+            if (d.x * d.x + d.y * d.y > radii[k] * radii[k] || !in_polygon(p, floes[ids[k]].geometry()))
+                continue;
+            auto const& state = floes[ids[k]].state();
+            tracer.floe = ids[k];
+            tracer.local = rotate(d, -state.theta);
+            tracer.position = state.real_position() + d;
+            break;
+        }
+    }
+}
+
+template <typename TFloeGroup>
+template <typename TRing>
+bool
+TracerManager<TFloeGroup>::in_ring(point_type const& p, TRing const& ring)
+{
+    bool inside = false;
+    const std::size_t n = ring.size();
+    for (std::size_t i = 0, j = n - 1; i < n; j = i++)
+    {
+        auto const& a = ring[i];
+        auto const& b = ring[j];
+        if ((a.y > p.y) != (b.y > p.y) && p.x < (b.x - a.x) * (p.y - a.y) / (b.y - a.y) + a.x)
+            inside = !inside;
+    }
+    return inside;
+}
+
+template <typename TFloeGroup>
+template <typename TPolygon>
+bool
+TracerManager<TFloeGroup>::in_polygon(point_type const& p, TPolygon const& polygon)
+{
+    if (!in_ring(p, polygon.outer())) return false;
+    for (auto const& inner : polygon.inners())
+        if (in_ring(p, inner)) return false;
+    return true;
+}
+
+
+}} // namespace floe::io
+
+#endif // FLOE_IO_TRACERS_HPP
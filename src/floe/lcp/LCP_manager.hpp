@@ -8,12 +8,15 @@
 #define OPE_LCP_MANAGER_HPP
 
 #include "floe/domain/time_scale_manager.hpp"
+#include "floe/lcp/contact_impulse_record.hpp"
 #include <boost/numeric/ublas/vector_proxy.hpp>
 #include <boost/numeric/ublas/blas.hpp>
 #include <iostream> // debug
 #include <array>
 #include <algorithm>
 #include <chrono> // test perf
+#include <functional>
+#include <map>
 #include <vector>
 
 #include <boost/graph/adjacency_list.hpp>
@@ -55,6 +58,7 @@ public:
     using solver_type = TSolver;
     using real_type = typename solver_type::real_type;
     using value_vector = boost::numeric::ublas::vector<real_type>;
+    using contact_record_type = ContactImpulseRecord<real_type>;
 
     //! Constructor
     LCPManager(real_type epsilon) : m_solver{epsilon}, m_nb_lcp{0}, m_nb_lcp_success{0} {}
@@ -65,33 +69,70 @@ public:
             std::cout   << "#TOTAL LCP solve: " << m_nb_lcp_success << "/" << m_nb_lcp << "(" << success_ratio() << "%) \n"
                         << "LCP_failed compression phase: " << m_nb_lcp_failed_stats[0] << 
                         ", LCP_failed decompression phase: " << m_nb_lcp_failed_stats[1] << "\n" <<
-                        ", LCP_solved with solution maintaining the kinetic energy: " << m_nb_lcp_failed_stats[2] << "\n";
+                        ", LCP_solved with solution maintaining the kinetic energy: " << m_nb_lcp_failed_stats[2] << "\n" <<
+                        ", LCP_failed replaced by the fallback solution: " << m_nb_lcp_failed_stats[3] << "\n";
+        if (m_solver.get_mixed_precision())
+            std::cout   << "#LCP mixed precision: " << m_solver.get_nb_mixed_solved() << " solved, "
+                        << m_solver.get_nb_mixed_fallback() << " fallback to double precision\n";
     }
 
     //! LCP solver accessor
     inline solver_type& get_solver() { return m_solver; }
+    //! Contact impulses record accessor
+    inline contact_record_type& get_contact_record() { return m_contact_record; }
 
-    //! Solve collision represented by a contact graph
+    /*! Solve collision represented by a contact graph
+     *
+     * The collision subgraphs are independent: with OpenMP, they are solved as tasks (largest first),
+     * each thread using its own copy of the solver. The subgraphs sharing an obstacle are solved in the same task.
+     */
     template<typename TContactGraph>
     int solve_contacts(TContactGraph& contact_graph);
+    //! Solve the collision subgraphs in parallel tasks (with OpenMP, default)
+    inline void set_parallel(bool parallel) { m_parallel = parallel; }
     //! Get solving success ratio in percent
     double success_ratio(){ return (m_nb_lcp == 0)? 100 : 100 * (double)m_nb_lcp_success/m_nb_lcp; }
 
 private:
 
     solver_type m_solver; //!< LCP Solver
+    contact_record_type m_contact_record; //!< Impulses of each contact point during the current step
     long        m_nb_lcp; //!< Total number of LCP managed
     long        m_nb_lcp_success; //!< Total number of LCP solving success
-    long        m_nb_lcp_failed_stats[3]={0,0,0}; // LCP failed statistics: [nb LCP failed during compression phase,
-    // nb LCP failed during decompression phase, nb LCP solved maintaining the kinetic energy in decompression phase].
+    bool        m_parallel{true}; //!< Collision subgraphs solved in parallel tasks
+    long        m_nb_lcp_failed_stats[4]={0,0,0,0}; // LCP failed statistics: [nb LCP failed during compression phase,
+    // nb LCP failed during decompression phase, nb LCP solved maintaining the kinetic energy in decompression phase,
+    // nb LCP failed replaced by the fallback solution].
     // Other LCP statistics are found in the matlab routine (see folder: io/outputs).
     
     double chrono_active_subgraph{0.0}; // test perf
     double max_chrono_active_subgraph{0.0}; // test perf
 
+    //! LCP counters of a step
+    struct SolveCounters
+    {
+        int nb_lcp = 0;
+        int nb_success = 0;
+        int failed_stats[4] = {0, 0, 0, 0};
+    };
+
+    //! Active subgraph strategy on a collision subgraph
+    template<typename TSubgraph>
+    void solve_subgraph(TSubgraph& subgraph, solver_type& solver, SolveCounters& counters);
+    //! Groups of collision subgraphs solved in the same task (sharing an obstacle), largest first
+    template<typename TSubgraphs>
+    std::vector<std::vector<std::size_t>> subgraph_tasks(TSubgraphs const& subgraphs) const;
     //! Update floes state with LCP solution
     template<typename TContactGraph>
     void update_floes_state(TContactGraph& graph, const std::array<value_vector, 2> Sol);
+    /*! Accumulate the contact impulses of the last LCP solved by solver in the contact record
+     *
+     * Concurrent tasks write different lines (the edges of different subgraphs).
+     */
+    template<typename TContactGraph>
+    void record_contact_impulses(TContactGraph const& graph, solver_type const& solver) {
+        if (m_contact_record.is_enabled()) m_contact_record.add(graph, solver.get_contact_impulses());
+    }
 
     /*! \fn bool saving_contact_graph_in_hdf5(int lCP_count, std::size_t loop_count, std::size_t size_a_sub_graph, bool all_solved )
         \brief Saves information on the contact graph in the same file as LCP statistics.
@@ -119,16 +160,9 @@ int LCPManager<T>::solve_contacts(TContactGraph& contact_graph)
 {
 
     auto const subgraphs = collision_subgraphs( contact_graph );
-    int LCP_count=0, nb_success=0;
-    int nb_lcp_failed_stats[3]={0,0,0}; 
+    SolveCounters counters;
 
-    const std::size_t limit_sup_loop_cnt    = 800;//5000; // from Quentin: 1000
-    const std::size_t limit_sup_nb_contact  =  80;//500; // from Quentin:   50
-
-    // variables for contact informations:
-    #ifdef LCPSTATS
-        static bool end_recording = false;
-    #endif
+    m_solver.set_store_contact_impulses(m_contact_record.is_enabled());
 
     // m_solver.nb_solver_run = 0; // test perf
     // m_solver.chrono_solver = 0; // test perf
@@ -137,99 +171,44 @@ int LCPManager<T>::solve_contacts(TContactGraph& contact_graph)
     // max_chrono_active_subgraph = 0; // test perf
     // int nb_active_subgraph_loop = 0;// test
     // auto t_start = std::chrono::high_resolution_clock::now(); // test perf
-    for ( auto& subgraph : subgraphs )
+#if defined(_OPENMP) && !defined(LCPSTATS) // LCP statistics are recorded in order
+    if (m_parallel && subgraphs.size() > 1 && omp_get_max_threads() > 1 && !omp_in_parallel())
     {
-        //  // Big LCP solving
-        // LCP_count += 1;
-        // bool success;
-        // auto Sol = m_solver.solve( subgraph, success );
-        // mark_solved(subgraph, success);
-        // if (success) nb_success++;
-        // update_floes_state(subgraph, Sol, subgraph);
-
-        // Active subgraph LCP strategy
-        auto asubgraphs = active_subgraphs( subgraph );
-        std::size_t loop_cnt    = 0;
-        int loop_nb_success     = -1;
-        bool active_quad_cut    = 0;
-
-        // variables for contact informations:
-        #ifdef LCPSTATS
-            std::size_t size_a_sub_graph = asubgraphs.size();
-        #endif
-        bool all_solved = true;
-
-        int contact_loop_stats[2]={0,0};    // number of contact points, indicator for be out of loop due to all success (1) or no success (0) 
-                                            // or no enough iteration (2)
-        contact_loop_stats[0] = static_cast<int>(num_contacts(subgraph));
-        contact_loop_stats[1] = 1;
-
-        while (asubgraphs.size() != 0
-               && loop_cnt < std::min( 100 * num_contacts(subgraph), limit_sup_loop_cnt) // 60 * num_contacts(subgraph)
-               && loop_nb_success !=0 )
+        // Subgraphs sharing an obstacle are solved in the same task (obstacle impulses are accumulated)
+        const auto tasks = subgraph_tasks( subgraphs );
+        std::vector<solver_type> solvers;
+        std::vector<SolveCounters> task_counters(tasks.size());
+        #pragma omp parallel
+        #pragma omp single
         {
-            loop_nb_success = 0;    // if no succes after one total path of contact graph, no use (nothing change)
-                                    // to browse again the while loop. Thus we add "loop_nb_succes !=0".
-
-            LCP_count += asubgraphs.size();
-
-            for ( auto const& graph : asubgraphs ) // loop over the total number of active contact group
+            // one copy per thread of the actual team, which may be smaller than omp_get_max_threads()
+            solvers.assign(omp_get_num_threads(), m_solver);
+            for ( auto& solver : solvers )
+                solver.reset_counters(); // only the runs of this step are merged back
+            for ( std::size_t t = 0; t < tasks.size(); ++t )
             {
-                bool success;
-                if (num_contacts(graph) > limit_sup_nb_contact){
-                    std::cout << "Q4, nb contact:" << num_contacts(graph) << " \n";
-                    auto qdct = quad_cut( graph );
-                    std::cout << "nb quad_cut: " << qdct.size() << " \n";
-                    active_quad_cut = 1;
-                    for ( auto const& igraph : quad_cut( graph ) ){
-                        auto Sol = m_solver.solve( igraph, success, nb_lcp_failed_stats );
-                        mark_solved(igraph, success);
-                        if (success) {++loop_nb_success;}
-                        update_floes_state(igraph, Sol);
-                    }
-                } else {
-                    auto Sol = m_solver.solve( graph, success, nb_lcp_failed_stats );
-                    mark_solved(graph, success);
-                    if (success) {++loop_nb_success;}
-                    update_floes_state(graph, Sol); // updates the velocity of floes
+                #pragma omp task firstprivate(t) shared(tasks, subgraphs, solvers, task_counters)
+                {
+                    auto& solver = solvers[omp_get_thread_num()]; // tied task: no thread change
+                    for ( std::size_t i : tasks[t] )
+                        solve_subgraph( subgraphs[i], solver, task_counters[t] );
                 }
-
-                mark_changed_parent(graph, subgraph); // indicates which floes have been modified
             }
-            // auto t_start2 = std::chrono::high_resolution_clock::now(); // test perf
-            asubgraphs = active_subgraphs( subgraph ); // computes the new relative velocitoies from velocities of modified floes 
-            
-            // auto t_end2 = std::chrono::high_resolution_clock::now(); // test perf
-            // auto call_time = std::chrono::duration<double, std::milli>(t_end2-t_start2).count(); // test perf
-            // chrono_active_subgraph += call_time; // test perf
-            // max_chrono_active_subgraph = std::max(max_chrono_active_subgraph, call_time); // test perf
-            nb_success += loop_nb_success;
-            ++loop_cnt;
-
-            if (loop_nb_success==0) {contact_loop_stats[1] = 0;}
         }
-        if (asubgraphs.size() != 0)
+        for ( auto& solver : solvers )
+            m_solver.merge_counters( solver );
+        for ( auto const& c : task_counters )
         {
-            all_solved = false;
-            if (loop_nb_success!=0) {contact_loop_stats[1] = 2;}
-            std::cout << "End of the while loop without resolution of all contacts!! nb contact: "<< num_contacts(subgraph) << "\n";
-            // LCP_count += asubgraphs.size();
-
-            for ( auto const& graph : asubgraphs ) mark_solved(graph, false);
+            counters.nb_lcp += c.nb_lcp;
+            counters.nb_success += c.nb_success;
+            for (int i=0;i<4;++i) counters.failed_stats[i] += c.failed_stats[i];
         }
-
-        // Mat
-        // Saving data on LCP:
-        /*
-         * Recovery of contact data (LCP_count, etc). Save in h5 file:
-         */
-        #ifdef LCPSTATS
-            if (!end_recording && size_a_sub_graph!=0) {
-                end_recording = saving_contact_graph_in_hdf5( LCP_count, loop_cnt, size_a_sub_graph, all_solved, contact_loop_stats );
-            } 
-        #endif
-        // End saving data on LCP
-        // EndMat
+    }
+    else
+#endif
+    {
+        for ( auto& subgraph : subgraphs )
+            solve_subgraph( subgraph, m_solver, counters );
     }
     // auto t_end = std::chrono::high_resolution_clock::now(); // test perf
     // auto call_time = std::chrono::duration<double, std::milli>(t_end-t_start).count(); // test perf
@@ -243,47 +222,168 @@ int LCPManager<T>::solve_contacts(TContactGraph& contact_graph)
     // << " ( #contacts : " << num_contacts(contact_graph) << " )" // test perf
     // << "\n"; // test perf
 
-    // version omp
-    // #pragma omp parallel for
-    // for ( std::size_t i = 0; i < subgraphs.size(); ++i )
-    // {
-    //     auto& subgraph = subgraphs[i];
-    //     auto asubgraphs = active_subgraphs( subgraph );
-    //     int loop_cnt = 0;
-    //     while (asubgraphs.size() != 0 && loop_cnt < 60 * num_contacts(subgraph) )
-    //     {
-    //         LCP_count += asubgraphs.size();
-    //         #pragma omp parallel for
-    //         for ( std::size_t j = 0; j < asubgraphs.size(); ++j )
-    //         {
-    //             bool success;
-    //             auto& graph = asubgraphs[j];
-    //             auto Sol = m_solver.solve( graph, success );
-    //             mark_solved(graph, success);
-    //             // #pragma omp critical
-    //             if (success) 
-    //             {
-    //                 // #pragma omp atomic
-    //                 // nb_success++;
-    //                 update_floes_state(graph, Sol);
-    //             }
-    //         }
-    //         asubgraphs = active_subgraphs( subgraph );
-    //         loop_cnt++;
-    //     }
-    // }
-
-    m_nb_lcp += LCP_count;
-    m_nb_lcp_success += nb_success;
-    for (int i=0;i<3;++i){
-        m_nb_lcp_failed_stats[i] += nb_lcp_failed_stats[i];
+    m_nb_lcp += counters.nb_lcp;
+    m_nb_lcp_success += counters.nb_success;
+    for (int i=0;i<4;++i){
+        m_nb_lcp_failed_stats[i] += counters.failed_stats[i];
     }
 
     #ifndef MPIRUN
-    if (LCP_count)
-        std::cout << " #LCP solve: "<< nb_success << " / " << LCP_count << std::endl;
+    if (counters.nb_lcp)
+        std::cout << " #LCP solve: "<< counters.nb_success << " / " << counters.nb_lcp << std::endl;
+    #endif
+    return counters.nb_success;
+}
+
+template<typename T>
+template<typename TSubgraph>
+void LCPManager<T>::solve_subgraph(TSubgraph& subgraph, solver_type& solver, SolveCounters& counters)
+{
+    const std::size_t limit_sup_loop_cnt    = 800;//5000; // from Quentin: 1000
+    const std::size_t limit_sup_nb_contact  =  80;//500; // from Quentin:   50
+
+    // variables for contact informations:
+    #ifdef LCPSTATS
+        static bool end_recording = false;
     #endif
-    return nb_success;
+
+    //  // Big LCP solving
+    // LCP_count += 1;
+    // bool success;
+    // auto Sol = solver.solve( subgraph, success );
+    // mark_solved(subgraph, success);
+    // if (success) nb_success++;
+    // update_floes_state(subgraph, Sol, subgraph);
+
+    // Active subgraph LCP strategy
+    auto asubgraphs = active_subgraphs( subgraph );
+    std::size_t loop_cnt    = 0;
+    int loop_nb_success     = -1;
+    bool active_quad_cut    = 0;
+
+    // variables for contact informations:
+    #ifdef LCPSTATS
+        std::size_t size_a_sub_graph = asubgraphs.size();
+    #endif
+    bool all_solved = true;
+
+    int contact_loop_stats[2]={0,0};    // number of contact points, indicator for be out of loop due to all success (1) or no success (0) 
+                                        // or no enough iteration (2)
+    contact_loop_stats[0] = static_cast<int>(num_contacts(subgraph));
+    contact_loop_stats[1] = 1;
+
+    while (asubgraphs.size() != 0
+           && loop_cnt < std::min( 100 * num_contacts(subgraph), limit_sup_loop_cnt) // 60 * num_contacts(subgraph)
+           && loop_nb_success !=0 )
+    {
+        loop_nb_success = 0;    // if no succes after one total path of contact graph, no use (nothing change)
+                                // to browse again the while loop. Thus we add "loop_nb_succes !=0".
+
+        counters.nb_lcp += asubgraphs.size();
+
+        for ( auto const& graph : asubgraphs ) // loop over the total number of active contact group
+        {
+            bool success;
+            if (num_contacts(graph) > limit_sup_nb_contact){
+                std::cout << "Q4, nb contact:" << num_contacts(graph) << " \n";
+                auto qdct = quad_cut( graph );
+                std::cout << "nb quad_cut: " << qdct.size() << " \n";
+                active_quad_cut = 1;
+                for ( auto const& igraph : quad_cut( graph ) ){
+                    auto Sol = solver.solve( igraph, success, counters.failed_stats );
+                    mark_solved(igraph, success);
+                    if (success) {++loop_nb_success;}
+                    update_floes_state(igraph, Sol);
+                    record_contact_impulses(igraph, solver);
+                }
+            } else {
+                auto Sol = solver.solve( graph, success, counters.failed_stats );
+                mark_solved(graph, success);
+                if (success) {++loop_nb_success;}
+                update_floes_state(graph, Sol); // updates the velocity of floes
+                record_contact_impulses(graph, solver);
+            }
+
+            mark_changed_parent(graph, subgraph); // indicates which floes have been modified
+        }
+        // auto t_start2 = std::chrono::high_resolution_clock::now(); // test perf
+        asubgraphs = active_subgraphs( subgraph ); // computes the new relative velocitoies from velocities of modified floes 
+        
+        // auto t_end2 = std::chrono::high_resolution_clock::now(); // test perf
+        // auto call_time = std::chrono::duration<double, std::milli>(t_end2-t_start2).count(); // test perf
+        // chrono_active_subgraph += call_time; // test perf
+        // max_chrono_active_subgraph = std::max(max_chrono_active_subgraph, call_time); // test perf
+        counters.nb_success += loop_nb_success;
+        ++loop_cnt;
+
+        if (loop_nb_success==0) {contact_loop_stats[1] = 0;}
+    }
+    if (asubgraphs.size() != 0)
+    {
+        all_solved = false;
+        if (loop_nb_success!=0) {contact_loop_stats[1] = 2;}
+        std::cout << "End of the while loop without resolution of all contacts!! nb contact: "<< num_contacts(subgraph) << "\n";
+        // counters.nb_lcp += asubgraphs.size();
+
+        for ( auto const& graph : asubgraphs ) mark_solved(graph, false);
+    }
+
+    // Mat
+    // Saving data on LCP:
+    /*
+     * Recovery of contact data (LCP_count, etc). Save in h5 file:
+     */
+    #ifdef LCPSTATS
+        if (!end_recording && size_a_sub_graph!=0) {
+            end_recording = saving_contact_graph_in_hdf5( counters.nb_lcp, loop_cnt, size_a_sub_graph, all_solved, contact_loop_stats );
+        } 
+    #endif
+    // End saving data on LCP
+    // EndMat
+}
+
+template<typename T>
+template<typename TSubgraphs>
+std::vector<std::vector<std::size_t>> LCPManager<T>::subgraph_tasks(TSubgraphs const& subgraphs) const
+{
+    // union of the subgraphs sharing an obstacle
+    std::vector<std::size_t> root(subgraphs.size());
+    for (std::size_t i = 0; i < root.size(); ++i) root[i] = i;
+    std::function<std::size_t(std::size_t)> find = [&](std::size_t i) { return root[i] == i ? i : root[i] = find(root[i]); };
+    std::map<void const*, std::size_t> obstacle_subgraph;
+    std::vector<std::size_t> nb_contacts(subgraphs.size());
+    for (std::size_t i = 0; i < subgraphs.size(); ++i)
+    {
+        auto const& subgraph = subgraphs[i];
+        nb_contacts[i] = num_contacts(subgraph);
+        for ( auto const v : boost::make_iterator_range( vertices(subgraph) ) )
+        {
+            if ( !subgraph[v].floe->is_obstacle() ) continue;
+            auto it = obstacle_subgraph.emplace(subgraph[v].floe, i).first;
+            root[find(i)] = find(it->second);
+        }
+    }
+    std::map<std::size_t, std::vector<std::size_t>> groups;
+    for (std::size_t i = 0; i < subgraphs.size(); ++i)
+        groups[find(i)].push_back(i);
+
+    // largest tasks first, for load balance
+    std::vector<std::vector<std::size_t>> tasks;
+    std::vector<std::size_t> task_size;
+    for (auto& group : groups)
+    {
+        tasks.push_back(std::move(group.second));
+        std::size_t size = 0;
+        for (std::size_t i : tasks.back()) size += nb_contacts[i];
+        task_size.push_back(size);
+    }
+    std::vector<std::size_t> order(tasks.size());
+    for (std::size_t t = 0; t < order.size(); ++t) order[t] = t;
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return task_size[a] > task_size[b]; });
+    std::vector<std::vector<std::size_t>> sorted_tasks;
+    sorted_tasks.reserve(tasks.size());
+    for (std::size_t t : order) sorted_tasks.push_back(std::move(tasks[t]));
+    return sorted_tasks;
 }
 
 
@@ -11,6 +11,9 @@
 #include <algorithm>
 #include <utility>
 #include <type_traits>
+#include <array>
+#include <cmath>
+#include <vector>
 
 #include <boost/numeric/ublas/banded.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
@@ -73,6 +76,26 @@ public:
     ublas::vector<T> impulse_vector(lcp_type const& lcp_c, lcp_type const& lcp_d, T epsilon) const;
     //! Impulse vector in case of decompression LCP solving fail
     ublas::vector<T> impulse_vector(lcp_type const& lcp_c, T epsilon = 0) const;
+    /*! Normal and tangential impulse of each contact (in the order of the columns of J).
+     *
+     * Impulses are those received by contact.floe2, in the contact frame (tangential along u, normal along v).
+     * contact.floe1 receives the opposite impulses.
+     */
+    std::array<ublas::vector<T>, 2> contact_impulses(lcp_type const& lcp_c, lcp_type const& lcp_d, T epsilon) const;
+    //! Normal and tangential impulse of each contact in case of decompression LCP solving fail
+    std::array<ublas::vector<T>, 2> contact_impulses(lcp_type const& lcp_c, T epsilon = 0) const;
+    /*! Approximate LCP solution by projected Gauss-Seidel, for floes' speeds V0 before the impulses.
+     *
+     * With V0 = W, it approximates getLCP() (compression phase). With V0 = Solc + epsilon invM J zc, it approximates
+     * getLCP_d() (decompression phase). Returned in the layout of LCP::z: normal impulses, tangential impulses (t+, t-)
+     * and sliding speeds. Normal impulses are non-negative and tangential ones lie in the Coulomb cone, whatever the
+     * number of sweeps, so that it can replace an unsolved LCP solution (see LCPSolver::solve).
+     *
+     * \param V0           floes' speeds before the impulses.
+     * \param max_sweeps   maximal number of sweeps over the contacts.
+     * \param tolerance    stops when the impulses change is less than tolerance times the greatest normal impulse.
+     */
+    ublas::vector<T> pgs_solution(ublas::vector<T> const& V0, std::size_t max_sweeps, T tolerance) const;
 
 
     ublas::diagonal_matrix<T>   M;   //!< Mass and momentum matrix.
@@ -87,8 +110,36 @@ public:
 
 
 private:
+    /*! Local Jacobian of one contact.
+     *
+     * The only non-zero rows of the columns j (in J) and 2j (in D) : one 3-vector (x, y, rotation)
+     * per floe in contact. Column 2j+1 of D is the opposite of column 2j.
+     */
+    struct ContactJacobian
+    {
+        std::array<std::size_t, 2>          floe;   //!< Ids of the two floes (graph vertices).
+        std::array<std::array<T, 3>, 2>     n;      //!< Normal rows, for each floe.
+        std::array<std::array<T, 3>, 2>     t;      //!< Tangential rows, for each floe.
+    };
+
     TGraph const& m_graph; //<! The contact graph.
+    std::vector<ContactJacobian> m_contact_jac; //<! Local Jacobians, indexed as the columns of J.
+    std::vector<std::vector<std::size_t>> m_floe_contacts; //<! Contacts (columns of J) touching each floe.
+    std::vector<std::array<T, 3>> m_inv_mass; //<! Diagonal of invM, per floe.
+
     ublas::vector<T> calc_floe_impulses(ublas::vector<T> const& normal, ublas::vector<T> const& tangential) const;
+    //! Per-contact normal impulse and net tangential impulse (t+ - t-)
+    std::array<ublas::vector<T>, 2> calc_contact_impulses(ublas::vector<T> const& normal, ublas::vector<T> const& tangential) const;
+
+    //! Weighted dot product u^T invM_f v of two local Jacobian rows.
+    static inline T weighted_dot(std::array<T, 3> const& u, std::array<T, 3> const& w, std::array<T, 3> const& v)
+    {
+        return u[0] * w[0] * v[0] + u[1] * w[1] * v[1] + u[2] * w[2] * v[2];
+    }
+
+    //! Fill the Delassus blocks of A, one pass over the contact pairs sharing a floe.
+    template <typename TMatrix>
+    void assemble_delassus(TMatrix& A) const;
 };
 
 template < typename T, typename TGraph >
@@ -108,6 +159,7 @@ init()
     // Mass & momentum matrix (and inverse) initialization
     M.resize(3*n, 3*n, false);
     invM.resize(3*n, 3*n, false);
+    m_inv_mass.assign(n, {{0, 0, 0}});
 
     for ( size_t i = 0; i < 3*n; i += 3 )
     {
@@ -123,6 +175,7 @@ init()
             invM(i+1, i+1) = invM(i, i) = T(1) / m_graph[i/3].floe->mass(); // fv_test
             invM(i+2, i+2) = T(1) / m_graph[i/3].floe->moment_cst(); // fv_test
         }
+        m_inv_mass[i/3] = {{ invM(i, i), invM(i+1, i+1), invM(i+2, i+2) }};
     }
 
             
@@ -130,6 +183,8 @@ init()
     J.resize(3*n, m, false);
     D.resize(3*n, 2*m, false);
     mu.resize(m, m, false);
+    m_contact_jac.resize(m);
+    m_floe_contacts.assign(n, {});
 
     size_t j = 0;
 
@@ -187,6 +242,16 @@ init()
             D(i2+1, 2*j+1) = c * fg::get<1>(tangent);
             D(i2+2, 2*j+1) = c * fg::determinant<T>( r2, tangent );
 
+            // Local Jacobian (same values as above, kept dense for the LCP assembly)
+            auto& jac = m_contact_jac[j];
+            jac.floe = {{ id.first, id.second }};
+            jac.n[0] = {{ J(i1, j), J(i1+1, j), J(i1+2, j) }};
+            jac.n[1] = {{ J(i2, j), J(i2+1, j), J(i2+2, j) }};
+            jac.t[0] = {{ D(i1, 2*j), D(i1+1, 2*j), D(i1+2, 2*j) }};
+            jac.t[1] = {{ D(i2, 2*j), D(i2+1, 2*j), D(i2+2, 2*j) }};
+            m_floe_contacts[id.first].push_back(j);
+            m_floe_contacts[id.second].push_back(j);
+
             // Filling static friction coefficient matrix
             mu(j, j) = floe1->mu_static(); // An expression depending of floe1 & floe2 mu ?
             
@@ -214,26 +279,18 @@ getLCP() const
     // LCP main matrix
     lcp::LCP<T> lcp(4*m);
     auto & A = lcp.M;
+    A.clear();
 
-    // Temporaries
-    decltype(J) iMJ(3*n, m);        axpy_prod(invM, J, iMJ, true);
-    decltype(D) iMD(3*n, 2*m);    axpy_prod(invM, D, iMD, true);
-
-    // Filling by blocks
-    //      1st row
-    project(A, range(0, m), range(0, m)) = prod(trans(J), iMJ);
-    project(A, range(0, m), range(m, 3*m)) = prod(trans(J), iMD);
-    project( A, range(0, m), range(3*m, 4*m) ) = zero_matrix<T>(m, m);
+    // Delassus blocks: J^T invM J, J^T invM D, D^T invM J and D^T invM D
+    assemble_delassus(A);
 
-    //      2nd row
-    project(A, range(m, 3*m), range(0, m)) = trans(project(A, range(0, m), range(m, 3*m))); // It is faster to transpose already calculated block
-    project(A, range(m, 3*m), range(m, 3*m)) = prod(trans(D), iMD);
-    project( A, range(m, 3*m), range(3*m, 4*m) ) = E;
-
-    //      3th row
-    project( A, range(3*m, 4*m), range(0, m) ) = mu;
-    project( A, range(3*m, 4*m), range(m, 3*m) ) = -trans(E);
-    project( A, range(3*m, 4*m), range(3*m, 4*m) ) = zero_matrix<T>(m,m);
+    // Friction blocks: E, mu and -E^T
+    for ( std::size_t j = 0; j < m; ++j )
+    {
+        A(m+2*j, 3*m+j) = A(m+2*j+1, 3*m+j) = 1;
+        A(3*m+j, j) = mu(j, j);
+        A(3*m+j, m+2*j) = A(3*m+j, m+2*j+1) = -1;
+    }
 
     // And now, the q vector !!
     // vector<T> W(3*n); // changed to access W from outside
@@ -249,17 +306,82 @@ getLCP() const
         W(i+2) = state.rot;
     }
 
-    // Filling q
+    // Filling q = (J^T W, D^T W, 0)
     auto& q = lcp.q;
-    project(q, range(0, m))   = prod( trans(J), W );
-    project(q, range(m, 3*m)) = prod( trans(D), W );
-    project(q, range(3*m, 4*m)) = zero_vector<T>(m);
+    for ( std::size_t j = 0; j < m; ++j )
+    {
+        auto const& jac = m_contact_jac[j];
+        T qn = 0, qt = 0;
+        for ( std::size_t s = 0; s < 2; ++s )
+        {
+            const std::size_t i = 3 * jac.floe[s];
+            for ( std::size_t d = 0; d < 3; ++d )
+            {
+                qn += jac.n[s][d] * W(i+d);
+                qt += jac.t[s][d] * W(i+d);
+            }
+        }
+        q(j) = qn;
+        q(m+2*j) = qt;
+        q(m+2*j+1) = -qt;
+        q(3*m+j) = 0;
+    }
 
     // Job done !
     return lcp;
 }
 
 
+template <typename T, typename TGraph>
+template <typename TMatrix>
+void
+GraphLCP<T, TGraph>::
+assemble_delassus(TMatrix& A) const
+{
+    const std::size_t m = nb_contacts;
+
+    // Each contact only involves 2 floes, so that an entry (j, k) of the Delassus matrix
+    // is a sum, over the floes shared by the contacts j and k, of weighted 3x3 dot products.
+    // Column 2k+1 of D being the opposite of column 2k, only one tangential product is needed.
+    for ( std::size_t f = 0; f < m_floe_contacts.size(); ++f )
+    {
+        auto const& w = m_inv_mass[f];
+        if ( w[0] == 0 && w[1] == 0 && w[2] == 0 ) continue; // obstacle: no contribution
+
+        auto const& contacts = m_floe_contacts[f];
+        for ( std::size_t j : contacts )
+        {
+            auto const& jac_j = m_contact_jac[j];
+            const std::size_t s = ( jac_j.floe[0] == f ) ? 0 : 1;
+            auto const& nj = jac_j.n[s];
+            auto const& tj = jac_j.t[s];
+
+            for ( std::size_t k : contacts )
+            {
+                auto const& jac_k = m_contact_jac[k];
+                const std::size_t r = ( jac_k.floe[0] == f ) ? 0 : 1;
+                auto const& nk = jac_k.n[r];
+                auto const& tk = jac_k.t[r];
+
+                const T nn = weighted_dot(nj, w, nk);
+                const T nt = weighted_dot(nj, w, tk);
+                const T tn = weighted_dot(tj, w, nk);
+                const T tt = weighted_dot(tj, w, tk);
+
+                A(j, k)                 += nn;
+                A(j, m+2*k)             += nt;
+                A(j, m+2*k+1)           -= nt;
+                A(m+2*j, k)             += tn;
+                A(m+2*j+1, k)           -= tn;
+                A(m+2*j, m+2*k)         += tt;
+                A(m+2*j, m+2*k+1)       -= tt;
+                A(m+2*j+1, m+2*k)       -= tt;
+                A(m+2*j+1, m+2*k+1)     += tt;
+            }
+        }
+    }
+}
+
 template <typename T, typename TGraph>
 typename GraphLCP<T, TGraph>::lcp_type
 GraphLCP<T, TGraph>::
@@ -301,6 +423,82 @@ born_sup_d(lcp::LCP<T> const& lcp_c, T epsilon) const
             ) / inner_prod( prod(trans(W), M), W) );
 }
 
+template <typename T, typename TGraph>
+ublas::vector<T>
+GraphLCP<T, TGraph>::
+pgs_solution(ublas::vector<T> const& V0, std::size_t max_sweeps, T tolerance) const
+{
+    const std::size_t m = nb_contacts;
+
+    // Floes' speed updated in place by the impulses
+    ublas::vector<T> V = V0;
+    std::vector<T> pn(m, 0), pt(m, 0);
+
+    // Velocity of the contact along one of its local Jacobian rows
+    auto rel_speed = [&]( ContactJacobian const& jac, std::array<std::array<T, 3>, 2> const& row ) {
+        T speed = 0;
+        for ( std::size_t s = 0; s < 2; ++s )
+            for ( std::size_t d = 0; d < 3; ++d )
+                speed += row[s][d] * V(3*jac.floe[s]+d);
+        return speed;
+    };
+    auto apply = [&]( ContactJacobian const& jac, std::array<std::array<T, 3>, 2> const& row, T impulse ) {
+        for ( std::size_t s = 0; s < 2; ++s )
+            for ( std::size_t d = 0; d < 3; ++d )
+                V(3*jac.floe[s]+d) += m_inv_mass[jac.floe[s]][d] * row[s][d] * impulse;
+    };
+
+    // Diagonal of the Delassus matrix
+    std::vector<T> Dnn(m, 0), Dtt(m, 0);
+    for ( std::size_t j = 0; j < m; ++j )
+    {
+        auto const& jac = m_contact_jac[j];
+        for ( std::size_t s = 0; s < 2; ++s )
+        {
+            Dnn[j] += weighted_dot(jac.n[s], m_inv_mass[jac.floe[s]], jac.n[s]);
+            Dtt[j] += weighted_dot(jac.t[s], m_inv_mass[jac.floe[s]], jac.t[s]);
+        }
+    }
+
+    for ( std::size_t sweep = 0; sweep < max_sweeps; ++sweep )
+    {
+        T max_delta = 0, max_pn = 0;
+        for ( std::size_t j = 0; j < m; ++j )
+        {
+            auto const& jac = m_contact_jac[j];
+            if ( Dnn[j] <= 0 ) continue; // between obstacles
+
+            const T pn_new = std::max( T(0), pn[j] - rel_speed(jac, jac.n) / Dnn[j] );
+            apply(jac, jac.n, pn_new - pn[j]);
+            max_delta = std::max( max_delta, std::abs(pn_new - pn[j]) );
+            pn[j] = pn_new;
+
+            const T bound = mu(j, j) * pn[j];
+            T pt_new = pt[j];
+            if ( Dtt[j] > 0 ) pt_new -= rel_speed(jac, jac.t) / Dtt[j];
+            pt_new = std::min( bound, std::max( -bound, pt_new ) );
+            apply(jac, jac.t, pt_new - pt[j]);
+            max_delta = std::max( max_delta, std::abs(pt_new - pt[j]) );
+            pt[j] = pt_new;
+
+            max_pn = std::max( max_pn, pn[j] );
+        }
+        if ( max_delta <= tolerance * max_pn ) break;
+    }
+
+    ublas::vector<T> z(4*m);
+    for ( std::size_t j = 0; j < m; ++j )
+    {
+        auto const& jac = m_contact_jac[j];
+        z(j) = pn[j];
+        z(m+2*j) = std::max( T(0), pt[j] );
+        z(m+2*j+1) = std::max( T(0), -pt[j] );
+        // Sliding speed, only when the friction reaches the Coulomb cone (or without normal impulse)
+        z(3*m+j) = ( std::abs(pt[j]) >= mu(j, j) * pn[j] ) ? std::abs( rel_speed(jac, jac.t) ) : 0;
+    }
+    return z;
+}
+
 template <typename T, typename TGraph>
 ublas::vector<T>
 GraphLCP<T, TGraph>::
@@ -333,7 +531,8 @@ impulse_vector(lcp_type const& lcp_c, lcp_type const& lcp_d, T epsilon) const {
     auto const& z_c = lcp_c.z;
     auto const& z_d = lcp_d.z;
     std::size_t m= J.size2();
-    auto normal = (1 + epsilon) * subrange(z_c, 0, m) + subrange(z_d, 0, m);
+    const T coef = 1 + epsilon; // kept alive: the expression templates hold a reference to it
+    auto normal = coef * subrange(z_c, 0, m) + subrange(z_d, 0, m);
     auto tangential = subrange(z_c, m, 3*m) + subrange(z_d, m, 3*m);
     return calc_floe_impulses(normal, tangential);
 }
@@ -344,11 +543,46 @@ GraphLCP<T, TGraph>::
 impulse_vector(lcp_type const& lcp_c, T epsilon) const {
     auto const& z_c = lcp_c.z;
     std::size_t m = nb_contacts;
-    auto normal = (1 + epsilon) * subrange(z_c, 0, m);
+    const T coef = 1 + epsilon; // kept alive: the expression templates hold a reference to it
+    auto normal = coef * subrange(z_c, 0, m);
     auto tangential = subrange(z_c, m, 3*m);
     return calc_floe_impulses(normal, tangential);
 }
 
+template <typename T, typename TGraph>
+std::array<ublas::vector<T>, 2>
+GraphLCP<T, TGraph>::
+calc_contact_impulses(ublas::vector<T> const& normal, ublas::vector<T> const& tangential) const {
+    std::size_t m = nb_contacts;
+    ublas::vector<T> tangential_net(m);
+    for (std::size_t i = 0; i < m; ++i)
+        tangential_net[i] = tangential[2*i] - tangential[2*i + 1];
+    return {{normal, tangential_net}};
+}
+
+template <typename T, typename TGraph>
+std::array<ublas::vector<T>, 2>
+GraphLCP<T, TGraph>::
+contact_impulses(lcp_type const& lcp_c, lcp_type const& lcp_d, T epsilon) const {
+    auto const& z_c = lcp_c.z;
+    auto const& z_d = lcp_d.z;
+    std::size_t m = nb_contacts;
+    ublas::vector<T> normal = (1 + epsilon) * subrange(z_c, 0, m) + subrange(z_d, 0, m);
+    ublas::vector<T> tangential = subrange(z_c, m, 3*m) + subrange(z_d, m, 3*m);
+    return calc_contact_impulses(normal, tangential);
+}
+
+template <typename T, typename TGraph>
+std::array<ublas::vector<T>, 2>
+GraphLCP<T, TGraph>::
+contact_impulses(lcp_type const& lcp_c, T epsilon) const {
+    auto const& z_c = lcp_c.z;
+    std::size_t m = nb_contacts;
+    ublas::vector<T> normal = (1 + epsilon) * subrange(z_c, 0, m);
+    ublas::vector<T> tangential = subrange(z_c, m, 3*m);
+    return calc_contact_impulses(normal, tangential);
+}
+
 
 }}} // namespace floe::lcp::builder
 
@@ -0,0 +1,119 @@
+/*!
+ * \file floe/lcp/contact_impulse_record.hpp
+ * \brief Per-step record of the impulses exchanged at each contact point.
+ */
+
+#ifndef FLOE_LCP_CONTACT_IMPULSE_RECORD_HPP
+#define FLOE_LCP_CONTACT_IMPULSE_RECORD_HPP
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+#include <boost/graph/graph_utility.hpp>
+
+#include "floe/geometry/core/access.hpp"
+#include "floe/collision/contact_graph.hpp"
+
+namespace floe { namespace lcp
+{
+
+/*! Record of the contact impulses of one time step
+ *
+ * One line per contact point of the contact graph, filled with the impulses of every LCP
+ * involving this contact during the step (the active subgraph strategy may solve a contact several times).
+ * Each line contains: time, floe1 id, floe2 id, contact point (x, y), normal impulse, tangential impulse.
+ * Impulses are those received by floe2, in the contact frame (see GraphLCP::contact_impulses).
+ *
+ * The buffer keeps its capacity from one step to another.
+ *
+ * \tparam T    Real type.
+ */
+template <typename T>
+class ContactImpulseRecord
+{
+
+public:
+    using real_type = T;
+    using record_type = std::array<real_type, 7>;
+
+    ContactImpulseRecord() : m_enabled{false}, m_floe_origin{nullptr} {}
+
+    inline bool is_enabled() const { return m_enabled; }
+    inline void set_enabled(bool enabled) { m_enabled = enabled; }
+
+    /*! Initialize the record lines of a new step
+     *
+     * \param time          current time.
+     * \param floe_origin   first floe of the floe list storage (floe ids are computed from it).
+     * \param graph         the contact graph of the step.
+     */
+    template <typename TFloe, typename TContactGraph>
+    void start_step(real_type time, TFloe const* floe_origin, TContactGraph const& graph);
+
+    //! Accumulate the impulses of a LCP solved on a subgraph of the step contact graph
+    template <typename TContactGraph, typename TVector>
+    void add(TContactGraph const& graph, std::array<TVector, 2> const& impulses);
+
+    inline std::vector<record_type> const& records() const { return m_records; }
+    //! Clear the record (the capacity is kept)
+    inline void clear() { m_records.clear(); m_edge_offset.clear(); }
+
+private:
+    bool m_enabled; //!< Contact impulses recording
+    void const* m_floe_origin; //!< First floe of the floe list storage
+    std::vector<record_type> m_records; //!< Record lines
+    std::map<void const*, std::size_t> m_edge_offset; //!< First line of each edge in the current step, by FloeContact::id()
+
+    template <typename TFloe>
+    inline std::size_t floe_id(TFloe const* floe) const { return floe - static_cast<TFloe const*>(m_floe_origin); }
+};
+
+
+template <typename T>
+template <typename TFloe, typename TContactGraph>
+void
+ContactImpulseRecord<T>::start_step(real_type time, TFloe const* floe_origin, TContactGraph const& graph)
+{
+    namespace fg = floe::geometry;
+
+    m_floe_origin = floe_origin;
+    m_edge_offset.clear();
+    for ( auto const& edge : make_iterator_range( edges( graph ) ) )
+    {
+        m_edge_offset[graph[edge].id()] = m_records.size();
+        for ( auto const& contact : graph[edge] )
+        {
+            auto const& pt = contact.frame.center();
+            m_records.push_back({{
+                time, real_type(floe_id(contact.floe1)), real_type(floe_id(contact.floe2)),
+                fg::get<0>(pt), fg::get<1>(pt), 0, 0
+            }});
+        }
+    }
+}
+
+template <typename T>
+template <typename TContactGraph, typename TVector>
+void
+ContactImpulseRecord<T>::add(TContactGraph const& graph, std::array<TVector, 2> const& impulses)
+{
+    if ( impulses[0].size() != num_contacts(graph) ) return; // solver not storing contact impulses
+
+    std::size_t j = 0;
+    for ( auto const& edge : make_iterator_range( edges( graph ) ) )
+    {
+        auto const it = m_edge_offset.find(graph[edge].id()); // the parallel edges of a floe pair have their own lines
+        for ( std::size_t i = 0; i < graph[edge].size(); ++i, ++j )
+        {
+            if ( it == m_edge_offset.end() ) continue;
+            m_records[it->second + i][5] += impulses[0](j);
+            m_records[it->second + i][6] += impulses[1](j);
+        }
+    }
+}
+
+}} // namespace floe::lcp
+
+#endif // FLOE_LCP_CONTACT_IMPULSE_RECORD_HPP
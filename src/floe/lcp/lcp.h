@@ -16,9 +16,19 @@
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/numeric/ublas/vector.hpp>
 
+#include "floe/utils/arena.hpp"
+
 namespace floe { namespace lcp
 {
 
+//! Dense matrix allocated in the step arena of the thread (LCP temporaries)
+template < typename T >
+using arena_matrix = boost::numeric::ublas::matrix<T, boost::numeric::ublas::row_major,
+                                                   boost::numeric::ublas::unbounded_array<T, utils::ArenaAllocator<T>>>;
+//! Dense vector allocated in the step arena of the thread (LCP temporaries)
+template < typename T >
+using arena_vector = boost::numeric::ublas::vector<T, boost::numeric::ublas::unbounded_array<T, utils::ArenaAllocator<T>>>;
+
 /*! A LCP defined by M, q
  *
  * The problem is to find z that respect:
@@ -34,8 +44,8 @@ template < typename T >
 struct LCP
 {
     //!< attributes:
-    typedef boost::numeric::ublas::matrix<T> array_type;    //!< Type of array.
-    typedef boost::numeric::ublas::vector<T> vector_type;   //!< Type of vector.
+    typedef arena_matrix<T> array_type;     //!< Type of array (allocated in the step arena, see utils::step_arena).
+    typedef arena_vector<T> vector_type;    //!< Type of vector.
 
     std::size_t         dim;    //!< Dimension of the problem. (4 times the number of contacts)
     array_type          M;      //!< The matrix of the problem. Actually APS formulation \cite Moreau1988, Anitescu1997, Stewart2000.
@@ -84,7 +84,7 @@ T LCP<T>::LCP_error() const
 
 ////////////////////////////////////////////////////////////
 template < typename T >
-vector<T> LCP<T>::LCP_error_detailed() const
+typename LCP<T>::vector_type LCP<T>::LCP_error_detailed() const
 {
     vector_type Vec_Err(3*dim,0);
 
@@ -152,7 +152,7 @@ void LCP<T>::pivoting(const int block, const int drive)
 
 ////////////////////////////////////////////////////////////
 template<typename T>
-void LCP<T>::multi_pivoting( LCP<T> &lcp_orig, matrix<T> invSubM, std::vector<int> idx_a )
+void LCP<T>::multi_pivoting( LCP<T> &lcp_orig, array_type invSubM, std::vector<int> idx_a )
 {
     std::vector<int> idx_g;
     std::vector<int>::iterator it;
@@ -199,11 +199,11 @@ void LCP<T>::multi_pivoting( LCP<T> &lcp_orig, matrix<T> invSubM, std::vector<in
      *  \Warning:   prod() no return a matrix or a vector, one need to transform to a matrix or a vector
      *              before use again prod().
      */
-    Mprime_gg = M_gg - prod( M_ga , matrix<T>(prod(invSubM , M_ag)) );
+    Mprime_gg = M_gg - prod( M_ga , array_type(prod(invSubM , M_ag)) );
     Mprime_ag = - prod( invSubM, M_ag );
     Mprime_ga = prod( M_ga, invSubM );
     qprime_a  = -prod( invSubM, q_a );
-    qprime_g  = q_g - prod( M_ga , vector<T>(prod(invSubM, q_a)) ); 
+    qprime_g  = q_g - prod( M_ga , vector_type(prod(invSubM, q_a)) ); 
 
     // reset to zero-matrix and zero-vector:
     M.resize(M.size1(),M.size2(),false);
@@ -358,7 +358,7 @@ int LCP<T>::go_through_adj_cone( LCP<T> &lcp_orig, const int Z0, const double to
         }
         
         assert(idx_alpha.size()!=0);
-        matrix<T> subM(idx_alpha.size(),idx_alpha.size());
+        array_type subM(idx_alpha.size(),idx_alpha.size());
         
         for (kr=0;kr<idx_alpha.size();++kr){
             for (kc=0;kc<idx_alpha.size();++kc){
@@ -369,7 +369,7 @@ int LCP<T>::go_through_adj_cone( LCP<T> &lcp_orig, const int Z0, const double to
         // pivoting operation from a sub-matrix, only if the sub-matrix is nonsingular.
         // computation of the inverse of the sub-matrix: using the LU decomposition:
         // create a working copy of the subM:
-        matrix<T> A(subM);
+        array_type A(subM);
         // create a permutation matrix for the LU-factorization
         permutation_matrix<std::size_t> pm(A.size1());
 
@@ -382,7 +382,7 @@ int LCP<T>::go_through_adj_cone( LCP<T> &lcp_orig, const int Z0, const double to
         }
 
         // create identity matrix of "inverse"
-        matrix<T> invSubM(A.size1(),A.size2());
+        array_type invSubM(A.size1(),A.size2());
         invSubM.assign(identity_matrix<T>(A.size1()));
 
         // backsubstitute to get the inverse
@@ -68,6 +68,28 @@ public:
             }
         m_max_storage_unsol = max_storage_unsol;
     };
+    //! Run the Lemke's pivoting in float with a refined solve in real_type (see lexicolemke_MR_mixed)
+    inline void set_mixed_precision(bool mixed_precision) { m_mixed_precision = mixed_precision; }
+    inline bool get_mixed_precision() const { return m_mixed_precision; }
+    //! Number of Lemke's runs solved in mixed precision and number of them falling back to real_type precision
+    inline long get_nb_mixed_solved() const { return m_nb_mixed_solved; }
+    inline long get_nb_mixed_fallback() const { return m_nb_mixed_fallback; }
+    //! Reset the counters (thread copy of a solver, see merge_counters)
+    inline void reset_counters() { m_nb_mixed_solved = m_nb_mixed_fallback = 0; }
+    //! Add the counters of another solver (thread copy) to this one and reset them
+    inline void merge_counters(LCPSolver& other)
+    {
+        m_nb_mixed_solved += other.m_nb_mixed_solved;
+        m_nb_mixed_fallback += other.m_nb_mixed_fallback;
+        other.m_nb_mixed_solved = other.m_nb_mixed_fallback = 0;
+    }
+    //! Keep the per-contact impulses of each solved LCP (see get_contact_impulses)
+    inline void set_store_contact_impulses(bool store) { m_store_contact_impulses = store; }
+    //! Normal and tangential impulses of each contact of the last LCP (see GraphLCP::contact_impulses)
+    inline std::array<vector<real_type>, 2> const& get_contact_impulses() const { return m_contact_impulses; }
+    //! Replace the solution of an unsolved LCP by an admissible one (see fallback_solution)
+    inline void set_fallback(bool fallback) { m_fallback = fallback; }
+    inline bool get_fallback() const { return m_fallback; }
 
 protected:
     typedef boost::numeric::ublas::matrix<real_type> array_type;
@@ -82,6 +104,16 @@ protected:
                                 // one could increase up to 10.
     int     m_max_storage_sol;   //!< solved lcp max number 
     int     m_max_storage_unsol; //!< unsolved lcp max number
+    bool    m_mixed_precision{false};   //!< Lemke's pivoting in float with refinement in real_type
+    long    m_nb_mixed_solved{0};       //!< Lemke's runs solved in mixed precision
+    long    m_nb_mixed_fallback{0};     //!< Lemke's runs falling back to real_type precision
+    bool    m_store_contact_impulses{false};            //!< per-contact impulses are kept
+    std::array<vector<real_type>, 2> m_contact_impulses; //!< per-contact impulses of the last LCP
+    bool        m_fallback{true};           //!< unsolved LCPs are replaced by an admissible solution
+    std::size_t m_fallback_sweeps{200};     //!< max number of projected Gauss-Seidel sweeps of the fallback
+
+    //! Lemke's algorithm in real_type or in mixed precision (depending on m_mixed_precision)
+    std::vector<int> run_lemke(lcp_type& lcp, int itermax);
 
     //! Compute normalized Kinetic Energy
     template<typename Tmat, typename Tvect>
@@ -95,6 +127,31 @@ protected:
     template<typename TGraphLCP>
     vector<real_type> calcSold(TGraphLCP& graph_lcp, lcp_type& lcp_c, lcp_type& lcp_d, vector<real_type> Solc);
 
+    /*! Admissible solution when Lemke's algorithm fails in the compression phase
+     *
+     *  The compression phase is approximated by projected Gauss-Seidel (see GraphLCP::pgs_solution), then the
+     *  decompression phase by fallback_decompression. lcp_c.z and lcp_d.z are set to the impulses of each phase.
+     */
+    template<typename TGraphLCP>
+    vector<real_type> fallback_solution(TGraphLCP& graph_lcp, lcp_type& lcp_c, lcp_type& lcp_d, real_type& epsilon_eff);
+
+    /*! Admissible solution when Lemke's algorithm fails in the decompression phase
+     *
+     *  The restitution epsilon zc is reduced to epsilon_eff zc, with the greatest epsilon_eff in [0, epsilon] such that
+     *  the kinetic energy does not exceed the initial one (quadratic with born_sup_d as leading coefficient).
+     *  Then the decompression phase is approximated by projected Gauss-Seidel.
+     */
+    template<typename TGraphLCP>
+    vector<real_type> fallback_decompression(TGraphLCP& graph_lcp, lcp_type& lcp_c, vector<real_type> const& Solc,
+                                             lcp_type& lcp_d, real_type& epsilon_eff);
+
+    /*! Scale down the impulses z (LCP layout) so that they do not increase the kinetic energy of the speeds V0.
+     *
+     *  Returns the speeds after the impulses. Scaling keeps the impulses in the Coulomb cone.
+     */
+    template<typename TGraphLCP>
+    vector<real_type> dissipative_impulses(TGraphLCP& graph_lcp, vector<real_type> const& V0, typename lcp_type::vector_type& z);
+
     //! Normal relative speed test
     template<typename TContactGraph>
     bool Rel_Norm_Vel_test(const vector<real_type>& V, const TContactGraph& graph);
@@ -138,7 +195,7 @@ protected:
  *  SOL(q, M ) = \emptyset
  */ 
 template<typename T>
-void reduction_via_perturbation(std::size_t dim , matrix<T> &M, T alpha);
+void reduction_via_perturbation(std::size_t dim , arena_matrix<T> &M, T alpha);
 
 }}} // namespace floe::lcp::solver
 
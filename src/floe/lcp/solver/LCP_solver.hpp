@@ -28,6 +28,9 @@ template<typename TContactGraph>
 std::array<vector<typename LCPSolver<T>::real_type>, 2>
 LCPSolver<T>::solve( TContactGraph& graph, bool& success, int lcp_failed_stats[] ) {
 
+    // The LCP temporaries are allocated in the step arena of the thread, given back when leaving
+    utils::ArenaScope arena_scope;
+
     floe::lcp::builder::GraphLCP<real_type, decltype(graph)> graph_lcp( graph );
     auto lcp_orig = graph_lcp.getLCP();
 
@@ -75,7 +78,7 @@ LCPSolver<T>::solve( TContactGraph& graph, bool& success, int lcp_failed_stats[]
     
     while (!solved && count_attempt<=m_ite_max_attempt) {
 
-        error_status = lexicolemke_MR(m_tolerance, lcp_a, itermax);
+        error_status = run_lemke(lcp_a, itermax);
 
         // Always comparing to the orignal one: (lcp.M could be perturbed)
         lcp_orig.z = lcp_a.z;
@@ -182,6 +185,20 @@ LCPSolver<T>::solve( TContactGraph& graph, bool& success, int lcp_failed_stats[]
             
         lcp_failed_stats[0] += 1;
 
+        if (m_fallback) {
+            lcp_failed_stats[3] += 1;
+            real_type epsilon_eff;
+            lcp_type lcp_d = lcp_orig;
+            auto Sol = fallback_solution(graph_lcp, lcp_orig, lcp_d, epsilon_eff);
+            floe_impulses = graph_lcp.impulse_vector(lcp_orig, lcp_d, epsilon_eff);
+            if (m_store_contact_impulses) m_contact_impulses = graph_lcp.contact_impulses(lcp_orig, lcp_d, epsilon_eff);
+            success = 1;
+            return {{Sol, floe_impulses}};
+        }
+
+        if (m_store_contact_impulses) {
+            m_contact_impulses[0] = m_contact_impulses[1] = zero_vector<real_type>(graph_lcp.nb_contacts);
+        }
         success = 0;
         return {{graph_lcp.W, floe_impulses}};
     }
@@ -205,7 +222,7 @@ LCPSolver<T>::solve( TContactGraph& graph, bool& success, int lcp_failed_stats[]
 
         while (!solved && count_attempt<=m_ite_max_attempt) {
 
-            error_status = lexicolemke_MR(m_tolerance, lcp_a, itermax);
+            error_status = run_lemke(lcp_a, itermax);
 
             // Always comparing to the original one: (lcp.M could be perturbed)
             lcp_d_orig.z = lcp_a.z;
@@ -220,9 +237,11 @@ LCPSolver<T>::solve( TContactGraph& graph, bool& success, int lcp_failed_stats[]
                     lcp_failed_stats[2] += 1;
                     Sold = (1 + epsilon) * Solc - epsilon * graph_lcp.W; // return this instead of Sold
                     floe_impulses = graph_lcp.impulse_vector(lcp_orig, epsilon);
+                    if (m_store_contact_impulses) m_contact_impulses = graph_lcp.contact_impulses(lcp_orig, epsilon);
                 } else {
                     // Impulse calculation
                     floe_impulses = graph_lcp.impulse_vector(lcp_orig, lcp_d_orig, epsilon);
+                    if (m_store_contact_impulses) m_contact_impulses = graph_lcp.contact_impulses(lcp_orig, lcp_d_orig, epsilon);
                 } 
                 solved = true; SR_status = 0; RP_status = 0;
             }
@@ -277,8 +296,19 @@ LCPSolver<T>::solve( TContactGraph& graph, bool& success, int lcp_failed_stats[]
         if (!solved) {
             lcp_failed_stats[1] += 1;
 
+            if (m_fallback) {
+                lcp_failed_stats[3] += 1;
+                real_type epsilon_eff;
+                auto Sol = fallback_decompression(graph_lcp, lcp_orig, Solc, lcp_d_orig, epsilon_eff);
+                floe_impulses = graph_lcp.impulse_vector(lcp_orig, lcp_d_orig, epsilon_eff);
+                if (m_store_contact_impulses) m_contact_impulses = graph_lcp.contact_impulses(lcp_orig, lcp_d_orig, epsilon_eff);
+                success = 1;
+                return {{Sol, floe_impulses}};
+            }
+
             success = 0;
             floe_impulses = graph_lcp.impulse_vector(lcp_orig, epsilon);
+            if (m_store_contact_impulses) m_contact_impulses = graph_lcp.contact_impulses(lcp_orig, epsilon);
             /*! 
              *  \attention when, in the decompression phase, the LCP remains unsolved, we return the solution
              *             given by the linear combination of the velovies before and after the compression phase.
@@ -289,6 +319,7 @@ LCPSolver<T>::solve( TContactGraph& graph, bool& success, int lcp_failed_stats[]
     else {
         success = 1;
         floe_impulses = graph_lcp.impulse_vector(lcp_orig);
+        if (m_store_contact_impulses) m_contact_impulses = graph_lcp.contact_impulses(lcp_orig);
         return {{Solc, floe_impulses}};
     }
 
@@ -296,6 +327,21 @@ LCPSolver<T>::solve( TContactGraph& graph, bool& success, int lcp_failed_stats[]
     return {{Sold, floe_impulses}};
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+std::vector<int>
+LCPSolver<T>::run_lemke(lcp_type& lcp, int itermax)
+{
+    if (!m_mixed_precision)
+        return lexicolemke_MR(m_tolerance, lcp, itermax);
+
+    bool used_fallback;
+    std::vector<int> error_status = lexicolemke_MR_mixed(m_tolerance, lcp, itermax, used_fallback);
+    if (used_fallback) ++m_nb_mixed_fallback;
+    else ++m_nb_mixed_solved;
+    return error_status;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename T>
 template<typename Tmat, typename Tvect>
@@ -332,6 +378,72 @@ LCPSolver<T>::calcSold(TGraphLCP& graph_lcp, lcp_type& lcp_c, lcp_type& lcp_d, v
     );
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+template<typename TGraphLCP>
+vector<typename LCPSolver<T>::real_type>
+LCPSolver<T>::fallback_solution(TGraphLCP& graph_lcp, lcp_type& lcp_c, lcp_type& lcp_d, real_type& epsilon_eff)
+{
+    lcp_c.z = graph_lcp.pgs_solution(graph_lcp.W, m_fallback_sweeps, m_tolerance);
+    const vector<real_type> Solc = dissipative_impulses(graph_lcp, graph_lcp.W, lcp_c.z);
+    return fallback_decompression(graph_lcp, lcp_c, Solc, lcp_d, epsilon_eff);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+template<typename TGraphLCP>
+vector<typename LCPSolver<T>::real_type>
+LCPSolver<T>::fallback_decompression(TGraphLCP& graph_lcp, lcp_type& lcp_c, vector<real_type> const& Solc,
+                                     lcp_type& lcp_d, real_type& epsilon_eff)
+{
+    const std::size_t m = graph_lcp.nb_contacts;
+    vector<real_type> V0 = Solc;
+    epsilon_eff = 0;
+
+    const real_type EcW = inner_prod(prod(graph_lcp.W, graph_lcp.M), graph_lcp.W);
+    if (epsilon != 0 && EcW > 0) {
+        // Normalized kinetic energy of Solc + s invM J (epsilon zc): Ec(s) = c + 2 s a + s^2 b
+        vector<real_type> dV = prod(graph_lcp.invM, vector<real_type>(prod(graph_lcp.J, epsilon * subrange(lcp_c.z, 0, m))));
+        const real_type c = calcEc(Solc, graph_lcp.M, graph_lcp.W);
+        const real_type a = inner_prod(prod(Solc, graph_lcp.M), dV) / EcW;
+        const real_type b = graph_lcp.born_sup_d(lcp_c, epsilon);
+
+        real_type s = 1;
+        if (c + 2*a + b > 1) {
+            if (c >= 1 || !(b > 0)) s = 0;
+            else s = std::min(real_type(1), (-a + std::sqrt(a*a + b*(1 - c))) / b);
+        }
+        epsilon_eff = s * epsilon;
+        V0 += s * dV;
+    }
+
+    // Decompression impulses restoring non-negative normal relative speeds
+    lcp_d.z = graph_lcp.pgs_solution(V0, m_fallback_sweeps, m_tolerance);
+    return dissipative_impulses(graph_lcp, V0, lcp_d.z);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+template<typename TGraphLCP>
+vector<typename LCPSolver<T>::real_type>
+LCPSolver<T>::dissipative_impulses(TGraphLCP& graph_lcp, vector<real_type> const& V0, typename lcp_type::vector_type& z)
+{
+    const std::size_t m = graph_lcp.nb_contacts;
+
+    // Kinetic energy variation with impulses scaled by alpha: 2 alpha V0.P + alpha^2 dV.P (P = J zn + D zt = M dV)
+    vector<real_type> P = prod(graph_lcp.J, subrange(z, 0, m)) + prod(graph_lcp.D, subrange(z, m, 3*m));
+    vector<real_type> dV = prod(graph_lcp.invM, P);
+    const real_type a = inner_prod(V0, P);
+    const real_type b = inner_prod(dV, P);
+    if (2*a + b > 0) {
+        const real_type alpha = (b > 0) ? std::min(real_type(1), std::max(real_type(0), -a / b)) : 0;
+        z *= alpha;
+        dV *= alpha;
+    }
+
+    return V0 + dV;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename T>
 template<typename TContactGraph>
@@ -383,7 +495,7 @@ int LCPSolver<T>::which_failure( vector<real_type> Err, bool Is_pos_rel_norm_vel
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename T>
-void reduction_via_perturbation(std::size_t dim , matrix<T> &M, T alpha){
+void reduction_via_perturbation(std::size_t dim , arena_matrix<T> &M, T alpha){
 
     const std::size_t size_Delassus = 3*dim/4;
 
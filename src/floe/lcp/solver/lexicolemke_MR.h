@@ -39,12 +39,25 @@ using namespace boost::numeric::ublas;
 template < typename T>
 std::vector<int> lexicolemke_MR(double tolerance, LCP<T> &lcp, int itermax );
 
+/*! Mixed precision variant of lexicolemke_MR.
+ *
+ * The pivoting sequence is run in float on a copy of the tableau (half the memory traffic of the
+ * dominant kernel). The final basis is then used to solve the LCP in T: the basic system
+ * M_aa z_a = -q_a (a being the set of basic z variables) is factorised once (full pivoting LU) and the solution
+ * is improved by iterative refinement. The solution is accepted if its LCP error is below the tolerance,
+ * otherwise the double precision lexicolemke_MR is run on the LCP (and used_fallback is set).
+ *
+ * On success, lcp.z and lcp.basis are updated but lcp.M and lcp.q are left unpivoted.
+ */
+template < typename T>
+std::vector<int> lexicolemke_MR_mixed(double tolerance, LCP<T> &lcp, int itermax, bool& used_fallback );
+
 template<typename T>
 std::vector<int> lcp_lexicolemke_MR( const double tolerance, const int itermax, const std::size_t dim, 
-        matrix<T> &M, vector<T> &q, vector<T> &z, std::vector<int> &basis, int &driving  );
+        arena_matrix<T> &M, arena_vector<T> &q, arena_vector<T> &z, std::vector<int> &basis, int &driving  );
 
 template<typename T>
-void pivoting(matrix<T> &M, vector<T> &q, const int block, const int drive);
+void pivoting(arena_matrix<T> &M, arena_vector<T> &q, const int block, const int drive);
 
 }}}
 
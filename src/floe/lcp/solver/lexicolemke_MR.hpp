@@ -6,16 +6,22 @@
 #ifndef FLOE_LCP_SOLVER_LEXICOLEMKE_MR_HPP
 #define FLOE_LCP_SOLVER_LEXICOLEMKE_MR_HPP
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <vector>
 
 #include "floe/lcp/lcp.h"
 #include "floe/lcp/solver/lexicolemke_MR.h"
 
 #include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
 #include <boost/numeric/ublas/vector.hpp>
 
+#include <Eigen/LU>
+
 namespace floe { namespace lcp { namespace solver
 {
 
@@ -28,24 +34,102 @@ std::vector<int> lexicolemke_MR(double tolerance, LCP<T>& lcp, int itermax)
     const double tol = tolerance;
     const int itmax = itermax;
     const std::size_t dim = lcp.dim;
-    matrix<T> M = lcp.M;
-    vector<T> q = lcp.q;
-    vector<T> z = lcp.z;
+
+    // pivoting in place (the LCP tableau was copied back anyway)
+    return lcp_lexicolemke_MR( tol, itmax, dim, lcp.M, lcp.q, lcp.z, lcp.basis, lcp.driving );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template < typename T>
+std::vector<int> lexicolemke_MR_mixed(double tolerance, LCP<T>& lcp, int itermax, bool& used_fallback)
+{
+    const std::size_t dim = lcp.dim;
+    used_fallback = false;
+    // the float tableau is given back to the step arena at each call (lcp is only modified in place)
+    utils::ArenaScope arena_scope;
+
+    // Pivoting sequence in float, on a copy of the tableau
+    arena_matrix<float> Mf = lcp.M;
+    arena_vector<float> qf = lcp.q;
+    arena_vector<float> zf = lcp.z;
     std::vector<int> bas = lcp.basis;
     int drive = lcp.driving;
 
+    std::vector<int> error_status = lcp_lexicolemke_MR( tolerance, itermax, dim, Mf, qf, zf, bas, drive );
+
+    // LCP error of a candidate solution, on the original (unpivoted) LCP
+    auto error = [&]( arena_vector<T> const& z ) {
+        const arena_vector<T> w = prod( subrange(lcp.M, 0, dim, 0, dim), z ) + lcp.q;
+        T err = 0;
+        for (std::size_t i = 0; i < dim; ++i)
+        {
+            if (z(i) < 0) err -= z(i);
+            if (w(i) < 0) err -= w(i);
+            err += std::abs( z(i) * w(i) );
+        }
+        return err;
+    };
+
+    // Only a terminated Lemke's algorithm gives a candidate (-1: solution, -2: trivial, 3: inaccurate solution)
+    bool valid = ( error_status[0] == -1 || error_status[0] == -2 || error_status[0] == 3 );
+
+    arena_vector<T> z = zf;
+    T err = valid ? error(z) : 0;
+
+    // Refined solve in T on the final basis: M_aa z_a = -q_a, a being the set of basic z variables
+    std::vector<std::size_t> idx_a;
+    if (valid && error_status[0] != -2)
+        for (std::size_t i = 0; i < dim; ++i)
+            if ( bas[i] >= int(dim) && bas[i] < int(2*dim) ) idx_a.push_back( bas[i] - dim );
+
+    if (idx_a.size() != 0)
+    {
+        const std::size_t na = idx_a.size();
+        Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> M_aa(na, na);
+        Eigen::Matrix<T, Eigen::Dynamic, 1> rhs(na);
+        for (std::size_t kr = 0; kr < na; ++kr)
+        {
+            rhs(kr) = - lcp.q(idx_a[kr]);
+            for (std::size_t kc = 0; kc < na; ++kc)
+                M_aa(kr, kc) = lcp.M(idx_a[kr], idx_a[kc]);
+        }
 
-    std::vector<int> error_status = lcp_lexicolemke_MR( tol, itmax, dim, M, q, z, bas, drive );
+        // Rank revealing factorisation: the basic matrix may be singular when the float pivoting
+        // went through a degenerated vertex (redundant contacts), a particular solution is then computed.
+        Eigen::FullPivLU< Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > lu(M_aa);
+        Eigen::Matrix<T, Eigen::Dynamic, 1> za = lu.solve(rhs);
+
+        // Iterative refinement with the same factorisation
+        for (int it = 0; it < 3; ++it)
+        {
+            const Eigen::Matrix<T, Eigen::Dynamic, 1> r = rhs - M_aa * za;
+            if ( r.template lpNorm<Eigen::Infinity>() <= std::numeric_limits<T>::epsilon() * rhs.template lpNorm<Eigen::Infinity>() ) break;
+            za += lu.solve(r);
+        }
 
-    lcp.M = M; lcp.q = q; lcp.z = z; lcp.basis = bas; lcp.driving = drive;
+        arena_vector<T> z_ref(dim, 0);
+        for (std::size_t k = 0; k < na; ++k) z_ref(idx_a[k]) = za(k);
+        const T err_ref = error(z_ref);
+        if (err_ref <= err) { z = z_ref; err = err_ref; }
+    }
 
+    if ( !valid || err > tolerance )
+    {
+        used_fallback = true;
+        return lexicolemke_MR( tolerance, lcp, itermax );
+    }
+
+    lcp.z = z;
+    lcp.basis = bas;
+    lcp.driving = drive;
+    if (error_status[0] == 3) error_status[0] = -1;
     return error_status;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename T>
 std::vector<int> lcp_lexicolemke_MR( const double tolerance, const int itermax, const std::size_t dim, 
-        matrix<T> &M, vector<T> &q, vector<T> &z, std::vector<int> &basis, int &driving  )
+        arena_matrix<T> &M, arena_vector<T> &q, arena_vector<T> &z, std::vector<int> &basis, int &driving  )
 {
     // itermax, by default: 1000
     int iter;
@@ -54,7 +138,8 @@ std::vector<int> lcp_lexicolemke_MR( const double tolerance, const int itermax,
 
     std::size_t i, j;
     int block, drive, entering, leaving, Z0_priority;
-    double tol = 1e-7/dim;//tolerance/dim;//1e-7/dim; // same order as the LCP error
+    // same order as the LCP error, but not below the rounding error of T (float pivoting, see lexicolemke_MR_mixed)
+    double tol = std::max( 1e-7, 100. * std::numeric_limits<T>::epsilon() )/dim;//tolerance/dim;//1e-7/dim;
     // /* to prevent to remove all basis variable as candidate for pivoting (cause of strong numerical approximation)
     //  * one adjust the tolerance with the smallest value of q
     //  */
@@ -80,6 +165,10 @@ std::vector<int> lcp_lexicolemke_MR( const double tolerance, const int itermax,
         return res;
     }   
 
+    // the pivoting temporaries (Q, copies of M and q) are given back to the step arena at each call:
+    // (M, q and z are only modified in place from here)
+    utils::ArenaScope arena_scope;
+
     int Z0  = 2*dim; // artificial variable associated with the covering vector
     entering = Z0;
     
@@ -94,11 +183,10 @@ std::vector<int> lcp_lexicolemke_MR( const double tolerance, const int itermax,
 
     // Q = Id, matrix with lexicographically positive row built like a vector of vector for using 
     // lexicographical comparison:
-    std::vector< std::vector<T> > Q(dim);
+    using row_type = std::vector<T, utils::ArenaAllocator<T>>;
+    std::vector<row_type> Q(dim, row_type(dim,0));
     for (i=0; i<dim; ++i) {
-        std::vector<T> v(dim,0);
-        v[i] = 1;
-        Q[i] = v;
+        Q[i][i] = 1;
     }
 
     // Looking for zbar such as w = q + (d * zbar) >=0
@@ -146,7 +234,7 @@ std::vector<int> lcp_lexicolemke_MR( const double tolerance, const int itermax,
                                             // ratio test (MRT).
     std::vector<int> base_candidate;        // basis index for blocking satisfying the MRT
     std::size_t nb_candidate{0};            // length of candidate_pivots_indx
-    std::vector<T> Q_tmp(dim,0.0);          // temporary vector for lexicographic comparison
+    row_type Q_tmp(dim,0.0);                // temporary vector for lexicographic comparison
 
     for (iter=1; iter<=itermax; ++iter) {
 
@@ -301,7 +389,7 @@ std::vector<int> lcp_lexicolemke_MR( const double tolerance, const int itermax,
       
     if (iter > itermax && leaving != Z0){res[0]=1;}
 
-    vector<T> w(dim,0.0);   
+    arena_vector<T> w(dim,0.0);   
     // re-initialization of z:
     for (i=0; i<dim; ++i) {
         z[i] = 0.0;
@@ -324,7 +412,7 @@ std::vector<int> lcp_lexicolemke_MR( const double tolerance, const int itermax,
 
     // numerical error test:
     if (res[0]==-1) { // Lemke's algorithme ends with a solution
-        T N2 = norm_2( w - vector<T>( prod( subrange(M_orig,0,dim,0,dim) , z ) ) - q_orig );
+        T N2 = norm_2( w - arena_vector<T>( prod( subrange(M_orig,0,dim,0,dim) , z ) ) - q_orig );
         if (N2>tolerance) {res[0]=3;}
     }
 
@@ -336,7 +424,7 @@ std::vector<int> lcp_lexicolemke_MR( const double tolerance, const int itermax,
 
 ////////////////////////////////////////////////////////////
 template<typename T>
-void pivoting(matrix<T> &M, vector<T> &q, const int block, const int drive)
+void pivoting(arena_matrix<T> &M, arena_vector<T> &q, const int block, const int drive)
 {
     // WARNING: preferring a/b instead of 1/b*a
     // M is not necessarily a square matrix (augmented lcp case)
@@ -349,7 +437,7 @@ void pivoting(matrix<T> &M, vector<T> &q, const int block, const int drive)
     T pivot = M( block, drive );
     
     // M:
-    vector<T> d(dim,0.0);
+    arena_vector<T> d(dim,0.0);
     for (i=0;i<dim;++i) {
         d(i) = M(i,drive);
     }
@@ -9,6 +9,8 @@
 
 #include <iostream> // debug
 #include <set>
+#include <vector>
+#include <algorithm>
 #include <chrono> // tests
 
 #include "floe/problem/mpi_problem.hpp"
@@ -40,6 +42,7 @@ public:
     using message_type = typename base_class::message_type;
     using floe_distrib_type = typename TProblem::proximity_detector_type::floe_distrib_type;
     using process_list_type = typename TProblem::proximity_detector_type::process_list_type;
+    using task_list_type = typename message_type::task_list_type;
 
     //! Default constructor
     MPIMasterProblem(real_type epsilon, int OBL_status) : base_class(epsilon, OBL_status), msg_pk{0} {
@@ -53,6 +56,8 @@ public:
 private:
     //! last message id (increment for unicity)
     int msg_pk = 0; // TOD
+    //! Floe ids of the collision subgraphs left by the workers of a partition (see MPIProblem::set_subgraph_task_size)
+    task_list_type m_subgraph_tasks;
     //! Move one time step forward
     virtual void step_solve(bool crack = false, bool melt = false) override;
      //! Collision solving
@@ -64,6 +69,8 @@ private:
 
     std::set<int> request_jobs(floe::io::JobTag, process_list_type const&, bool interpene=false);
     bool handle_responses(std::set<int>&, floe::io::JobTag);
+    //! Solves the subgraph tasks, each idle worker pulling the next one (largest first)
+    bool solve_subgraph_tasks();
 
     void send_request(message_type&, int);
     message_type receive_response();
@@ -189,6 +196,7 @@ int MPIMasterProblem<TProblem>::manage_collisions(){
         std::cout << "LCP (" << keys[i] << ") : " << std::flush;
         auto msg_ids = request_jobs(floe::io::collision_job, this->m_proximity_detector.process_partition().at(keys[i]));
         still_collision = handle_responses(msg_ids, floe::io::collision_job);
+        if (m_subgraph_tasks.size()) still_collision = solve_subgraph_tasks() || still_collision;
         if (!still_collision) { OK_SET++; } else { OK_SET = 0; }
         i = (i+1)%keys.size();
     }
@@ -303,6 +311,7 @@ bool MPIMasterProblem<TProblem>::handle_responses(std::set<int>& msg_id_set, flo
             lcp_tot += nb_lcp;
             if (nb_lcp) std::cout << nb_lcp << ((msg_id_set.size()!=0) ? " + " : "") << std::flush;
             if (msg_id_set.size() == 0) std::cout << " = " << lcp_tot << std::endl;
+            m_subgraph_tasks.insert(m_subgraph_tasks.end(), resp.subgraph_tasks().begin(), resp.subgraph_tasks().end());
         } else if (tag==floe::io::move_job or tag==floe::io::interpene_job) {
             OBL_floes_force += resp.template get_OBL_speed<point_type>();
             ret = ret || resp.interpenetration();
@@ -314,6 +323,40 @@ bool MPIMasterProblem<TProblem>::handle_responses(std::set<int>& msg_id_set, flo
     return ret;
 }
 
+template<typename TProblem>
+bool MPIMasterProblem<TProblem>::solve_subgraph_tasks(){
+    // the subgraphs of a partition are disjoint: tasks are solved concurrently
+    std::stable_sort(m_subgraph_tasks.begin(), m_subgraph_tasks.end(),
+        [](std::vector<std::size_t> const& a, std::vector<std::size_t> const& b){ return a.size() > b.size(); });
+    std::set<int> msg_id_set;
+    std::size_t next_task = 0;
+    auto send_task = [&](int p_id){
+        message_type request{++msg_pk};
+        msg_id_set.insert(msg_pk);
+        request.set_tag(floe::io::subgraph_job);
+        request.store_time(this->m_domain.time());
+        request.store_OBL_contribution(this->get_dynamics_manager().OBL_speed());
+        request.set_floe_ids(m_subgraph_tasks[next_task++]);
+        request.store_states_light(this->get_floe_group(), request.floe_ids(), p_id);
+        send_request(request, p_id);
+    };
+    for (int p_id : this->m_proximity_detector.all_worker_processes())
+        if (next_task < m_subgraph_tasks.size()) send_task(p_id);
+    bool ret{false};
+    int lcp_tot = 0;
+    while (msg_id_set.size()){
+        auto resp = receive_response();
+        msg_id_set.erase(resp.id());
+        this->get_floe_group().update_floe_states(resp, false); // results merged by floe id
+        ret = ret || resp.nb_LCP_solved();
+        lcp_tot += resp.nb_LCP_solved();
+        if (next_task < m_subgraph_tasks.size()) send_task(resp.mpi_source()); // idle worker
+    }
+    std::cout << "Subgraph tasks : " << m_subgraph_tasks.size() << " (" << lcp_tot << " LCP)" << std::endl;
+    m_subgraph_tasks.clear();
+    return ret;
+}
+
 template<typename TProblem>
 void MPIMasterProblem<TProblem>::send_request(message_type& request, int process_id){
     this->mpi().send_serial(request, process_id, 0);
@@ -8,6 +8,7 @@
 #define PROBLEM_MPI_PROBLEM_HPP
 
 #include "floe/io/mpi_utils.hpp"
+#include "floe/io/mpi_shared_floes.hpp"
 
 namespace floe { namespace problem
 {
@@ -35,6 +36,15 @@ public:
         }
     }
 
+    //! Simplifies the floe boundaries (see FloeGroup::simplify_floe_shapes), by slices on the processes of the node
+    void simplify_floe_shapes(real_type factor) {
+        floe::io::NodeCommunicator node;
+        floe::io::load_on_node(node, [&]() {
+            this->get_floe_group().simplify_floe_shapes(factor, node.rank(), node.size());
+        });
+        floe::io::share_static_floes(node, this->get_floe_group());
+    }
+
     //! Solver of the problem (main method)
     virtual void solve(
         real_type end_time,
@@ -45,6 +55,29 @@ public:
         bool melting = false) override = 0;
     virtual mpi_terminal_type& mpi() { return m_mpi_term; }
 
+    /*! Collision subgraphs with more than nb_contacts contacts are not solved by the worker of their partition,
+     * but queued as tasks pulled by idle workers (0 to disable)
+     */
+    inline void set_subgraph_task_size(std::size_t nb_contacts) { m_subgraph_task_size = nb_contacts; }
+
+protected:
+    std::size_t m_subgraph_task_size{0}; //!< Min number of contacts of a subgraph task (0 : no subgraph task)
+
+    //! Floes are meshed by slices on the processes of the node, that share their meshes (see io::share_static_floes)
+    void load_h5_config(std::string const& filename) override {
+        floe::io::NodeCommunicator node;
+        floe::io::load_on_node(node, [&]() {
+            if (node.size() == 1) {
+                base_class::load_h5_config(filename);
+            } else {
+                this->get_floe_group().load_h5_config(filename, false);
+                this->get_dynamics_manager().set_ocean_window_area(this->get_floe_group().ocean_window_area());
+                floe::io::mesh_node_slice(node, this->get_floe_group());
+            }
+        });
+        floe::io::share_static_floes(node, this->get_floe_group());
+    }
+
 private:
     //! MPI terminal
     mpi_terminal_type m_mpi_term;
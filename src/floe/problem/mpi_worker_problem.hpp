@@ -13,6 +13,7 @@
 
 #include "floe/problem/mpi_problem.hpp"
 #include "floe/collision/contact_graph.hpp" // for graph vertices access (collision job response), todo move elsewhere
+#include "floe/utils/arena.hpp"
 
 namespace floe { namespace problem
 {
@@ -75,9 +76,11 @@ void MPIWorkerProblem<TProblem>::step_solve(bool crack, bool melt){
     // std::cout << "#" << this->mpi().process_rank() << " : " << this->get_floe_group().get_floes().size() << " floes" << std::endl;
     message_type response{request};
     // auto t_10 = std::chrono::high_resolution_clock::now();
-    if (request.tag()==floe::io::collision_job){
+    if (request.tag()==floe::io::collision_job || request.tag()==floe::io::subgraph_job){
         // this->detect_proximity();
         if (!this->m_proximity_detector.update()) std::cout << "DIRECT INTER #" << this->mpi().process_rank() << std::endl;
+        if (request.tag()==floe::io::collision_job && this->m_subgraph_task_size)
+            response.store_subgraph_tasks(this->m_proximity_detector.extract_large_subgraphs(this->m_subgraph_task_size));
         int n = this->manage_collisions();
         // if (n) std::cout << "#" << this->mpi().process_rank() << " : " << n << " lcp" << std::endl;
         response.nb_LCP_solved(n);
@@ -99,6 +102,7 @@ void MPIWorkerProblem<TProblem>::step_solve(bool crack, bool melt){
         return;
     }
     this->m_step_nb++;
+    floe::utils::reset_step_arenas();
     // auto t_2 = std::chrono::high_resolution_clock::now();
     send_response(response, request);
     // auto t_end = std::chrono::high_resolution_clock::now();
@@ -118,8 +122,8 @@ typename MPIWorkerProblem<TProblem>::message_type MPIWorkerProblem<TProblem>::re
 template<typename TProblem>
 void MPIWorkerProblem<TProblem>::send_response(message_type& resp, message_type& req){
     if (resp.tag() != floe::io::time_step_job){
-        if (resp.tag() == floe::io::collision_job){
-
+        if (resp.tag() == floe::io::collision_job || resp.tag() == floe::io::subgraph_job){
+            // only the floes of the contact graph are stored (see below)
         } else {
             resp.store_states(this->get_floe_group(), req.floe_ids());
         }
@@ -128,7 +132,8 @@ void MPIWorkerProblem<TProblem>::send_response(message_type& resp, message_type&
     switch(resp.tag()) {
         case floe::io::time_step_job : break;
         case floe::io::interpene_job : break;
-        case floe::io::collision_job : {
+        case floe::io::collision_job :
+        case floe::io::subgraph_job : {
             // if no LCP were solved, no floe states were modified
             if (resp.nb_LCP_solved() > 0){
                 // Send only states of potentially changed floes (floes in contact graph)
@@ -11,8 +11,13 @@
 #include "floe/io/hdf5_manager.h"
 // #include "floe/io/false_hdf5_manager.hpp"
 #include "floe/io/multi_out_manager.hpp"
+#include "floe/io/diagnostics.hpp"
+#include "floe/io/tracers.hpp"
 
  #include "floe/domain/time_scale_manager.hpp"
+#include "floe/collision/aggregate_manager.hpp"
+#include "floe/collision/dem_manager.hpp"
+#include "floe/utils/arena.hpp"
 
 #include <iostream>
 #include <atomic>
@@ -56,6 +61,10 @@ public:
     using floe_group_type = TFloeGroup; // generator accessor
     using time_scale_manager_type = domain::TimeScaleManager<typename TProxymityDetector::proximity_data_type>;
     using proximity_detector_type = TProxymityDetector;
+    using aggregate_manager_type = collision::AggregateManager<typename TFloeGroup::floe_type>;
+    using dem_manager_type = collision::DEMManager<typename TFloeGroup::floe_type>;
+    using diagnostics_type = io::DiagnosticsManager<TFloeGroup>;
+    using tracer_manager_type = io::TracerManager<TFloeGroup>;
 
     //! Default constructor.
     Problem(real_type epsilon=0.4, int OBL_status=0);
@@ -64,10 +73,19 @@ public:
     virtual void solve(real_type end_time, real_type dt_default, real_type out_step = 0, bool reset = true, bool fracture = false, bool melting = false);
 
     virtual void load_config(std::string const& filename);
+    /*! Loads an h5 config with the floe boundaries and meshes of another floe group loaded from the same file
+     *
+     * No meshing (ensemble members): the meshes are not copied and must outlive this problem.
+     */
+    void load_config_sharing_floes(std::string const& filename, floe_group_type& floe_group);
     //! Load ocean and wind data from a topaz file
     inline void load_matlab_topaz_data(std::string const& filename) {
         m_dynamics_manager.load_matlab_topaz_data(filename);
     }
+    //! Use ocean and wind data from a forcing series file, read by windows of hours
+    inline void load_forcing_series(std::string const& filename, std::size_t window_hours) {
+        m_dynamics_manager.load_forcing_series(filename, window_hours);
+    }
     //! Recover simulation state from previous ouput file, at any recorded time t
     virtual void recover_states_from_file(std::string const& filename, real_type t, bool keep_as_outfile=true);
 
@@ -94,7 +112,17 @@ public:
     inline out_manager_type& get_out_manager() {return m_out_manager;}
     //!< LCP solver accessor
     inline TCollisionManager& get_lcp_manager() { return m_collision_manager; }
-    bool variable_nb_of_floes () { return (m_fracture || m_melting); }
+    //!< Floe aggregates accessor
+    inline aggregate_manager_type& get_aggregate_manager() { return m_aggregate_manager; }
+    //!< Soft contact (DEM) manager accessor, used instead of the LCP solver when enabled
+    inline dem_manager_type& get_dem_manager() { return m_dem_manager; }
+    //!< In-situ diagnostics accessor
+    inline diagnostics_type& get_diagnostics() { return m_diagnostics; }
+    //!< Virtual buoys accessor
+    inline tracer_manager_type& get_tracers() { return m_tracers; }
+    bool variable_nb_of_floes () { return (m_fracture || m_melting || m_dynamics_manager.subgrid_enabled()); }
+    //! Sorts the floes along a Hilbert curve every nb_steps steps (0 to disable), see PartialFloeGroup::sort_along_hilbert_curve
+    inline void set_reorder_steps(std::size_t nb_steps) { m_reorder_steps = nb_steps; }
 
     const std::atomic<bool>* QUIT; //!< Exit signal
 
@@ -111,6 +139,8 @@ protected:
     TCollisionManager m_collision_manager; //!< Object managing collisions solving
     TDynamicsManager m_dynamics_manager; //!< Object managing floes dynamics (moving according to physics)
     time_scale_manager_type m_time_scale_manager; //!< Time scale manager at discrete level
+    aggregate_manager_type m_aggregate_manager; //!< Compound rigid aggregates of floes in persistent contact
+    dem_manager_type m_dem_manager; //!< Explicit penalty contact forces (alternative to the LCP solving)
 
     // variables
     TFloeGroup m_floe_group; //!< The set of floes
@@ -118,8 +148,11 @@ protected:
     // io
     int m_step_nb; //!< Total number of steps from beginning
     out_manager_type m_out_manager; //!< Object managing simulation output
+    diagnostics_type m_diagnostics; //!< In-situ diagnostics (reductions over floes, written with the output)
+    tracer_manager_type m_tracers; //!< Virtual buoys moving with the floes (written with the diagnostics)
     bool m_fracture; //!< Fracture activated ?
     bool m_melting; //!< Melting model activated ?
+    std::size_t m_reorder_steps{0}; //!< Number of steps between two floe sortings along a Hilbert curve (0 : never)
 
     //! Load floes set and initial states from matlab file
     virtual void load_matlab_config(std::string const& filename);
@@ -137,6 +170,10 @@ protected:
     virtual void safe_move_floe_group();
     //! Apply smooth dynamics to floes
     point_type move_floe_group();
+    //! Convert the smallest floes into sub-grid ice (see DynamicsManager::absorb_small_floes)
+    void absorb_small_floes();
+    //! Sort the floes along a Hilbert curve (see set_reorder_steps)
+    void reorder_floes();
     //! Handle output_datas (console + out file)
     void output_datas();
 
@@ -189,6 +226,13 @@ void PROBLEM::load_config(std::string const& filename) {
         throw std::runtime_error("Input file extension must be .mat or .h5");
 }
 
+TEMPLATE_PB
+void PROBLEM::load_config_sharing_floes(std::string const& filename, floe_group_type& floe_group) {
+    m_floe_group.load_h5_config(filename, false);
+    m_floe_group.share_static_floes(floe_group);
+    m_dynamics_manager.set_ocean_window_area(m_floe_group.ocean_window_area());
+}
+
 TEMPLATE_PB
 void PROBLEM::load_matlab_config(std::string const& filename) {
     m_floe_group.load_matlab_config(filename);
@@ -224,12 +268,16 @@ TEMPLATE_PB
 void PROBLEM::create_optim_vars() {
     m_proximity_detector.reset();
     m_proximity_detector.set_floe_group(m_floe_group);
+    m_aggregate_manager.reset(m_floe_group.get_floes().size());
+    m_dem_manager.reset();
 }
 
 TEMPLATE_PB
 void PROBLEM::update_optim_vars() {
     m_proximity_detector.reset();
     m_proximity_detector.rescan_floe_group();
+    m_aggregate_manager.reset(m_floe_group.get_floes().size());
+    m_dem_manager.reset();
 }
 
 
@@ -241,8 +289,12 @@ void PROBLEM::solve(real_type end_time, real_type dt_default, real_type out_step
     if (this->variable_nb_of_floes()) {
         this->m_floe_group.update_list_ids_active();
     }
+    // aggregates are only handled with a fixed floe list
+    bool aggregates = m_aggregate_manager.is_enabled() && !this->variable_nb_of_floes();
+    m_proximity_detector.set_aggregate_ids(aggregates ? &m_aggregate_manager.aggregate_ids() : nullptr);
     this->m_domain.set_default_time_step(dt_default);
     this->m_out_manager.set_out_step(out_step, this->m_domain.time());
+    this->absorb_small_floes();
     this->output_datas(); // Initial state out
     this->detect_proximity(); // First proximity detection
         // condition for fracture :
@@ -272,6 +324,8 @@ void PROBLEM::solve(real_type end_time, real_type dt_default, real_type out_step
 TEMPLATE_PB
 void PROBLEM::step_solve(bool crack, bool melt) {
     auto t0 = std::chrono::high_resolution_clock::now();
+    const bool dem = m_dem_manager.is_enabled();
+    if (dem) compute_time_step(); // contact forces are integrated over the coming time step
     manage_collisions();
     // fracture
     if (crack) {
@@ -280,9 +334,12 @@ void PROBLEM::step_solve(bool crack, bool melt) {
         this->update_optim_vars();
     	std::cout << "Fracture - nb floes : " << nb_before << " -> " << m_floe_group.get_floes().size() << std::endl;
     }
+    absorb_small_floes();
     auto t1 = std::chrono::high_resolution_clock::now();
-    compute_time_step();
+    if (!dem) compute_time_step();
     auto t2 = std::chrono::high_resolution_clock::now();
+    if (m_reorder_steps && m_step_nb % m_reorder_steps == 0)
+        reorder_floes(); // pair datas and contact graph are rebuilt in the new order by the detection of the move
     safe_move_floe_group();
     auto t3 = std::chrono::high_resolution_clock::now();
     if (melt) {
@@ -305,6 +362,7 @@ void PROBLEM::step_solve(bool crack, bool melt) {
 
     output_datas();
     m_step_nb++;
+    floe::utils::reset_step_arenas(); // step temporaries (LCP) given back wholesale
 }
 
 TEMPLATE_PB
@@ -355,9 +413,20 @@ void PROBLEM::output_datas(){
     std::cout << " | delta_t : " << this->m_domain.time_step();
     std::cout << " | Kinetic energy : " << this->m_floe_group.kinetic_energy() << std::endl;
     // ouput data
-    if (this->variable_nb_of_floes()) m_floe_group.get_floes().filter_off();
+    const bool filtered = m_floe_group.get_floes().is_filtered(); // output in storage order
+    if (filtered) m_floe_group.get_floes().filter_off();
     m_out_manager.save_step_if_needed(this->m_domain.time(), this->m_dynamics_manager);
-    if (this->variable_nb_of_floes()) m_floe_group.get_floes().filter_on();
+    if (m_diagnostics.reduce_if_needed(this->m_domain.time(), m_floe_group))
+    {
+        m_out_manager.add_diagnostics(m_diagnostics.records());
+        m_diagnostics.clear();
+    }
+    if (m_tracers.record_if_needed(this->m_domain.time(), m_floe_group))
+    {
+        m_out_manager.add_diagnostics(m_tracers.records());
+        m_tracers.clear();
+    }
+    if (filtered) m_floe_group.get_floes().filter_on();
 }
 
 TEMPLATE_PB
@@ -376,25 +445,83 @@ void PROBLEM::detect_proximity(){
 
 TEMPLATE_PB
 int PROBLEM::manage_collisions(){
-    int nb_lcp = m_collision_manager.solve_contacts(m_proximity_detector.contact_graph());
+    auto& contact_record = m_collision_manager.get_contact_record();
+    if (contact_record.is_enabled())
+        contact_record.start_step(m_domain.time(), m_floe_group.get_floes().data(), m_proximity_detector.contact_graph());
+
+    int nb_lcp = m_dem_manager.is_enabled()
+        ? m_dem_manager.solve_contacts(m_proximity_detector.contact_graph(), m_domain.time_step())
+        : m_collision_manager.solve_contacts(m_proximity_detector.contact_graph());
     m_proximity_detector.clean_dist_opt();
+    if (m_aggregate_manager.is_enabled() && !this->variable_nb_of_floes())
+    {
+        // aggregates are indexed by storage index
+        const bool filtered = m_floe_group.get_floes().is_filtered();
+        if (filtered) m_floe_group.get_floes().filter_off();
+        m_aggregate_manager.update(m_floe_group.get_floes(), m_proximity_detector.contact_graph());
+        if (!m_dem_manager.is_enabled()) // the rigid projection can make external contacts approaching again
+            m_aggregate_manager.solve_external_contacts(m_floe_group.get_floes(), m_proximity_detector.contact_graph(),
+                                                        m_collision_manager);
+        if (filtered) m_floe_group.get_floes().filter_on();
+    }
+
+    if (contact_record.is_enabled())
+    {
+        m_out_manager.add_contact_impulses(contact_record.records());
+        contact_record.clear();
+    }
     return nb_lcp;
 }
 
 
 TEMPLATE_PB
 void PROBLEM::compute_time_step(){
-    m_time_scale_manager.delta_t_secu(&m_domain);
+    if (m_dem_manager.is_enabled() && !m_proximity_detector.data().interpenetration())
+        m_domain.set_time_step(m_dem_manager.stable_time_step(
+            m_floe_group.get_floes(), m_proximity_detector.contact_graph(), m_domain.default_time_step()));
+    else
+        m_time_scale_manager.delta_t_secu(&m_domain); // also divides the time step after an interpenetration
 }
 
 
 TEMPLATE_PB
 typename TFloeGroup::point_type PROBLEM::move_floe_group(){
+    // aggregate members moved rigidly (aggregates are indexed by storage index)
+    const bool aggregates = m_aggregate_manager.nb_aggregates() != 0;
+    const bool filtered = m_floe_group.get_floes().is_filtered();
+    if (aggregates)
+    {
+        if (filtered) m_floe_group.get_floes().filter_off();
+        m_aggregate_manager.save_positions(m_floe_group.get_floes());
+        if (filtered) m_floe_group.get_floes().filter_on();
+    }
     point_type resp = m_dynamics_manager.move_floes(m_floe_group, m_domain.time_step());
+    if (aggregates)
+    {
+        if (filtered) m_floe_group.get_floes().filter_off();
+        m_aggregate_manager.rigid_move(m_floe_group.get_floes());
+        if (filtered) m_floe_group.get_floes().filter_on();
+    }
     m_domain.update_time();
     return resp;
 }
 
+TEMPLATE_PB
+void PROBLEM::absorb_small_floes(){
+    if (!m_dynamics_manager.subgrid_enabled()) return;
+    std::size_t nb_absorbed = m_dynamics_manager.absorb_small_floes(m_floe_group);
+    if (nb_absorbed == 0) return;
+    m_floe_group.update_list_ids_active();
+    this->update_optim_vars();
+    std::cout << "Sub-grid ice - " << nb_absorbed << " floes absorbed, nb floes : "
+              << m_floe_group.get_floes().size() << std::endl;
+}
+
+TEMPLATE_PB
+void PROBLEM::reorder_floes(){
+    m_floe_group.sort_along_hilbert_curve();
+}
+
 TEMPLATE_PB
 void PROBLEM::make_input_file(){
     m_out_manager.make_input_file(m_dynamics_manager);
@@ -0,0 +1,229 @@
+/*!
+ * \file utils/arena.hpp
+ * \brief Per-thread monotonic arenas for the temporaries of a time step.
+ */
+
+#ifndef FLOE_UTILS_ARENA_HPP
+#define FLOE_UTILS_ARENA_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace floe { namespace utils
+{
+
+/*! Monotonic (bump pointer) arena
+ *
+ * Memory is taken from a list of blocks and is only given back wholesale, by reset() or rewind().
+ * deallocate() does nothing, except for the last allocation, which is rolled back: the short-lived
+ * temporaries allocated and freed in LIFO order (as in the pivoting loops) do not make the arena grow.
+ * After a reset, the blocks are merged into a single one, so that the arena quickly reaches its steady size.
+ *
+ * \warning Not thread-safe: use one arena per thread (see step_arena()).
+ */
+class MonotonicArena
+{
+public:
+    //! Position in the arena, to rewind to
+    struct Marker
+    {
+        std::size_t block;
+        std::size_t offset;
+    };
+
+    explicit MonotonicArena(std::size_t block_size = 1 << 16) : m_block_size{block_size} {}
+    MonotonicArena(MonotonicArena const&) = delete;
+    MonotonicArena& operator=(MonotonicArena const&) = delete;
+    ~MonotonicArena() { release(); }
+
+    //! Allocates bytes with the given alignment
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+    {
+        if (bytes == 0) bytes = 1;
+        while (m_block < m_blocks.size())
+        {
+            Block& block = m_blocks[m_block];
+            const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.data);
+            const std::size_t offset = ((base + m_offset + alignment - 1) & ~(alignment - 1)) - base;
+            if (offset + bytes <= block.size)
+            {
+                m_last = block.data + offset;
+                m_last_offset = m_offset;
+                m_offset = offset + bytes;
+                return m_last;
+            }
+            ++m_block;
+            m_offset = 0;
+        }
+        // new block, at least twice as big as the previous one
+        const std::size_t size = std::max(bytes + alignment, m_blocks.empty() ? m_block_size : 2 * m_blocks.back().size);
+        m_blocks.push_back({static_cast<char*>(::operator new(size)), size});
+        m_block = m_blocks.size() - 1;
+        m_offset = 0;
+        return allocate(bytes, alignment);
+    }
+
+    //! Rolls back the last allocation, does nothing otherwise
+    void deallocate(void* p, std::size_t /* bytes */)
+    {
+        if (p != nullptr && p == m_last)
+        {
+            m_offset = m_last_offset;
+            m_last = nullptr;
+        }
+    }
+
+    //! Current position
+    Marker mark() const { return {m_block, m_offset}; }
+
+    //! Frees every allocation made after the marker
+    void rewind(Marker marker)
+    {
+        m_block = marker.block;
+        m_offset = marker.offset;
+        m_last = nullptr;
+    }
+
+    //! Frees every allocation, merging the blocks into a single one
+    void reset()
+    {
+        if (m_blocks.size() > 1)
+        {
+            std::size_t size = 0;
+            for (auto const& block : m_blocks) size += block.size;
+            release();
+            m_blocks.push_back({static_cast<char*>(::operator new(size)), size});
+        }
+        rewind({0, 0});
+    }
+
+    //! Total size of the blocks
+    std::size_t capacity() const
+    {
+        std::size_t size = 0;
+        for (auto const& block : m_blocks) size += block.size;
+        return size;
+    }
+
+    std::size_t epoch = 0; //!< Step of the last reset (see step_arena())
+    std::size_t nb_scopes = 0; //!< Number of open ArenaScope (no lazy reset meanwhile, see step_arena())
+
+private:
+    struct Block
+    {
+        char*       data;
+        std::size_t size;
+    };
+
+    std::vector<Block>  m_blocks;
+    std::size_t         m_block = 0;        //!< Current block
+    std::size_t         m_offset = 0;       //!< First free byte in the current block
+    void*               m_last = nullptr;   //!< Last allocation (rolled back by deallocate)
+    std::size_t         m_last_offset = 0;  //!< Offset before the last allocation
+    std::size_t         m_block_size;       //!< Size of the first block
+
+    void release()
+    {
+        for (auto const& block : m_blocks) ::operator delete(block.data);
+        m_blocks.clear();
+    }
+};
+
+namespace detail
+{
+    inline std::atomic<std::size_t>& step_epoch()
+    {
+        static std::atomic<std::size_t> epoch{0};
+        return epoch;
+    }
+} // namespace detail
+
+/*! Arena of the calling thread for the current time step
+ *
+ * The arenas of all the threads are reset wholesale by reset_step_arenas(), lazily (at their next use).
+ * An arena with an open ArenaScope is not reset: the steps of independent problems run by other
+ * threads (ensemble members) can end at any time.
+ * \warning Anything allocated in a step arena must be destroyed before the end of the step.
+ */
+inline MonotonicArena& step_arena()
+{
+    static thread_local MonotonicArena arena;
+    const std::size_t epoch = detail::step_epoch().load(std::memory_order_relaxed);
+    if (arena.epoch != epoch && arena.nb_scopes == 0)
+    {
+        arena.reset();
+        arena.epoch = epoch;
+    }
+    return arena;
+}
+
+//! End of time step: resets the step arenas of all the threads
+inline void reset_step_arenas() { ++detail::step_epoch(); }
+
+//! Scope rewinding an arena to its position at construction
+class ArenaScope
+{
+public:
+    explicit ArenaScope(MonotonicArena& arena = step_arena()) : m_arena(arena), m_marker{arena.mark()} { ++arena.nb_scopes; }
+    ArenaScope(ArenaScope const&) = delete;
+    ArenaScope& operator=(ArenaScope const&) = delete;
+    ~ArenaScope() { m_arena.rewind(m_marker); --m_arena.nb_scopes; }
+
+private:
+    MonotonicArena&         m_arena;
+    MonotonicArena::Marker  m_marker;
+};
+
+/*! Standard allocator on a monotonic arena
+ *
+ * A default constructed allocator uses the step arena of the constructing thread.
+ *
+ * \tparam T    Value type.
+ */
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type        = T;
+    using pointer           = T*;
+    using const_pointer     = T const*;
+    using reference         = T&;
+    using const_reference   = T const&;
+    using size_type         = std::size_t;
+    using difference_type   = std::ptrdiff_t;
+    template <typename U> struct rebind { using other = ArenaAllocator<U>; };
+
+    ArenaAllocator() : m_arena{&step_arena()} {}
+    explicit ArenaAllocator(MonotonicArena& arena) : m_arena{&arena} {}
+    template <typename U>
+    ArenaAllocator(ArenaAllocator<U> const& other) : m_arena{other.arena()} {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T* p, std::size_t n) { m_arena->deallocate(p, n * sizeof(T)); }
+
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) { ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...); }
+    template <typename U>
+    void destroy(U* p) { p->~U(); }
+    std::size_t max_size() const { return std::numeric_limits<std::size_t>::max() / sizeof(T); }
+
+    MonotonicArena* arena() const { return m_arena; }
+
+private:
+    MonotonicArena* m_arena;
+};
+
+template <typename T, typename U>
+inline bool operator==(ArenaAllocator<T> const& a, ArenaAllocator<U> const& b) { return a.arena() == b.arena(); }
+template <typename T, typename U>
+inline bool operator!=(ArenaAllocator<T> const& a, ArenaAllocator<U> const& b) { return a.arena() != b.arena(); }
+
+}} // namespace floe::utils
+
+#endif // FLOE_UTILS_ARENA_HPP
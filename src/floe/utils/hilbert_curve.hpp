@@ -0,0 +1,62 @@
+/*!
+ * \file utils/hilbert_curve.hpp
+ * \brief Hilbert space filling curve, to order objects by spatial proximity.
+ */
+
+#ifndef FLOE_UTILS_HILBERT_CURVE_HPP
+#define FLOE_UTILS_HILBERT_CURVE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+
+namespace floe { namespace utils
+{
+
+/*! Index of the cell (x, y) along the Hilbert curve filling the 2^16 x 2^16 grid
+ *
+ * Consecutive indices are neighbour cells. The first 4^k indices fill the 2^k x 2^k cells at the origin.
+ */
+inline std::uint32_t hilbert_index(std::uint32_t x, std::uint32_t y)
+{
+    const std::uint32_t n = 1u << 16;
+    std::uint32_t d = 0;
+    for (std::uint32_t s = n / 2; s > 0; s /= 2)
+    {
+        const std::uint32_t rx = (x & s) ? 1 : 0;
+        const std::uint32_t ry = (y & s) ? 1 : 0;
+        d += s * s * ((3 * rx) ^ ry);
+        // quadrant rotation
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+/*! Hilbert index of a point in a window
+ *
+ * \param pt        Point (clamped to the window).
+ * \param window    Window (min_x, max_x, min_y, max_y).
+ */
+template <typename TPoint, typename T>
+inline std::uint32_t hilbert_index(TPoint const& pt, std::array<T, 4> const& window)
+{
+    const T max_cell = (1u << 16) - 1;
+    auto cell = [max_cell](T v, T min, T max) {
+        const T c = (max > min) ? (v - min) / (max - min) * max_cell : 0;
+        return static_cast<std::uint32_t>(std::min(std::max(c, T(0)), max_cell));
+    };
+    return hilbert_index(cell(pt.x, window[0], window[1]), cell(pt.y, window[2], window[3]));
+}
+
+}} // namespace floe::utils
+
+#endif // FLOE_UTILS_HILBERT_CURVE_HPP
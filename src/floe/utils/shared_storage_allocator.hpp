@@ -0,0 +1,107 @@
+/*!
+ * \file utils/shared_storage_allocator.hpp
+ * \brief Standard allocator that can give a container a storage owned elsewhere.
+ */
+
+#ifndef FLOE_UTILS_SHARED_STORAGE_ALLOCATOR_HPP
+#define FLOE_UTILS_SHARED_STORAGE_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace floe { namespace utils
+{
+
+/*! Standard allocator on the heap, or on a storage owned elsewhere (e.g. a node shared memory window)
+ *
+ * A default constructed allocator allocates on the heap.
+ * An allocator attached to a storage of n values gives it to its first allocation of n values
+ * (see attach_storage()). The values of the storage are never constructed, destroyed or freed:
+ * a container of n default-inserted values shows the values already in the storage, and can be
+ * destroyed after the storage is released. Any other allocation is made on the heap.
+ *
+ * A copy of a container gets a heap allocator. The assignment of a container propagates its allocator:
+ * assigning a container attached to a storage gives it a heap storage instead of writing in the storage.
+ *
+ * \warning The storage is not copied: its values must not be modified through the container.
+ * \tparam T    Value type.
+ */
+template <typename T>
+class SharedStorageAllocator
+{
+public:
+    using value_type        = T;
+    using pointer           = T*;
+    using const_pointer     = T const*;
+    using reference         = T&;
+    using const_reference   = T const&;
+    using size_type         = std::size_t;
+    using difference_type   = std::ptrdiff_t;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    template <typename U> struct rebind { using other = SharedStorageAllocator<U>; };
+
+    SharedStorageAllocator() : m_storage{nullptr}, m_size{0}, m_given{false} {}
+    //! Allocator attached to a storage of size values
+    SharedStorageAllocator(T* storage, std::size_t size) : m_storage{storage}, m_size{size}, m_given{false} {}
+    template <typename U>
+    SharedStorageAllocator(SharedStorageAllocator<U> const&) : SharedStorageAllocator() {}
+
+    //! Copy of a container: heap allocator
+    SharedStorageAllocator select_on_container_copy_construction() const { return {}; }
+
+    T* allocate(std::size_t n)
+    {
+        if (m_storage != nullptr && !m_given && n == m_size)
+        {
+            m_given = true;
+            return m_storage;
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T* p, std::size_t) { if (!in_storage(p)) ::operator delete(p); }
+
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) { if (!in_storage(p)) ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...); }
+    template <typename U>
+    void destroy(U* p) { if (!in_storage(p)) p->~U(); }
+    std::size_t max_size() const { return std::numeric_limits<std::size_t>::max() / sizeof(T); }
+
+    T* storage() const { return m_storage; }
+
+private:
+    T*          m_storage;  //!< Attached storage (nullptr: heap only)
+    std::size_t m_size;     //!< Number of values of the storage
+    bool        m_given;    //!< The storage has been allocated
+
+    template <typename U>
+    bool in_storage(U* p) const
+    {
+        void const* q = p;
+        return m_storage != nullptr && !std::less<void const*>()(q, m_storage)
+               && std::less<void const*>()(q, m_storage + m_size);
+    }
+};
+
+template <typename T, typename U>
+inline bool operator==(SharedStorageAllocator<T> const& a, SharedStorageAllocator<U> const& b)
+{ return static_cast<void const*>(a.storage()) == static_cast<void const*>(b.storage()); }
+template <typename T, typename U>
+inline bool operator!=(SharedStorageAllocator<T> const& a, SharedStorageAllocator<U> const& b) { return !(a == b); }
+
+//! Sets a vector to the size values of a storage owned elsewhere (previous values released)
+template <typename T>
+inline void attach_storage(std::vector<T, SharedStorageAllocator<T>>& values, T* storage, std::size_t size)
+{
+    values = std::vector<T, SharedStorageAllocator<T>>(size, SharedStorageAllocator<T>(storage, size));
+}
+
+}} // namespace floe::utils
+
+#endif // FLOE_UTILS_SHARED_STORAGE_ALLOCATOR_HPP
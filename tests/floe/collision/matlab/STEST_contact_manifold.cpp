@@ -0,0 +1,75 @@
+/*!
+ * \file floe/collision/matlab/STEST_contact_manifold.cpp
+ * \brief Contact manifold reduction: LCP size and solve of a dense pack of square floes.
+ *
+ * The pack is a grid of converging square floes separated by 2 cm, with a boundary point every 50 cm:
+ * the flush edges give many nearly redundant contacts. The contacts are detected and solved once
+ * without reduction, then once for each max number of contacts per cluster.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "../tests/floe/test_floes.hpp"
+#include "floe/floes/partial_floe_group.hpp"
+#include "floe/collision/matlab/detector.hpp"
+#include "floe/lcp/solver/LCP_solver.hpp"
+#include "floe/lcp/LCP_manager.hpp"
+
+int main(int argc, char* argv[])
+{
+    using namespace std;
+    using floe::test::floe_type;
+    using floe::test::point_type;
+    using floe_group_type = floe::floes::PartialFloeGroup<floe_type>;
+    using detector_type = floe::collision::matlab::MatlabDetector<floe_group_type>;
+    using lcp_manager_type = floe::lcp::LCPManager<floe::lcp::solver::LCPSolver<double>>;
+
+    if (argc < 3)
+    {
+        cout << "Usage: " << argv[0] << " <N_floes_per_side> <floe_size> [max_size ...]" << endl;
+        return 1;
+    }
+    const int N = atoi(argv[1]); // 3
+    const double L = atof(argv[2]); // 10
+    std::vector<std::size_t> max_sizes{0};
+    for (int i = 3; i < argc; ++i) max_sizes.push_back(atoi(argv[i]));
+    if (argc == 3) max_sizes.insert(max_sizes.end(), {8, 4, 3});
+
+    for (auto max_size : max_sizes)
+    {
+        floe_group_type floe_group;
+        const double step = L + 0.02, center = (N - 1) * step / 2;
+        floe::test::set_floes(floe_group, N * N, [&](floe_type& floe, std::size_t i) {
+            const point_type pos{(i % N) * step, (i / N) * step};
+            floe::test::set_rectangle(floe, L / 2, L / 2, 917 * L * L, pos, 1e-3 * (point_type{center, center} - pos), 0, 0, 0.5);
+        });
+
+        cout << "Max contacts per cluster: " << max_size << endl;
+        detector_type detector;
+        detector.set_manifold_max_size(max_size);
+        detector.set_floe_group(floe_group);
+        detector.update();
+        auto contact_graph = detector.contact_graph();
+        std::size_t nb_contacts = 0;
+        for (auto const& e : boost::make_iterator_range(edges(contact_graph)))
+            nb_contacts += contact_graph[e].size();
+
+        lcp_manager_type lcp_manager(0.4);
+        lcp_manager.set_parallel(false);
+        const auto t_start = chrono::steady_clock::now();
+        lcp_manager.solve_contacts(contact_graph);
+        const auto t_end = chrono::steady_clock::now();
+
+        double v2 = 0;
+        for (auto const& floe : floe_group.get_floes())
+            v2 += floe.state().speed.x * floe.state().speed.x + floe.state().speed.y * floe.state().speed.y;
+        cout << "\t" << nb_contacts << " contacts (LCP of " << 4 * nb_contacts << " rows)" << endl;
+        cout << "\tLCP solve: " << chrono::duration<double, milli>(t_end - t_start).count() << " ms" << endl;
+        cout << "\tSum of the squared floe speeds after solve: " << v2 << endl;
+    }
+
+    return 0;
+}
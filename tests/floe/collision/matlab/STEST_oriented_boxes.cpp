@@ -0,0 +1,71 @@
+/*!
+ * \file floe/collision/matlab/STEST_oriented_boxes.cpp
+ * \brief Oriented box broad phase: rejected pairs and detection time on a fractured pack.
+ *
+ * The pack is a grid of randomly rotated square floes of side 40 m, each one fractured in parallel strips
+ * separated by 5 cm. The contacts are detected with the global disks only, then with the oriented boxes.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../tests/floe/test_floes.hpp"
+#include "floe/floes/partial_floe_group.hpp"
+#include "floe/collision/matlab/detector.hpp"
+
+int main(int argc, char* argv[])
+{
+    using namespace std;
+    using floe::test::floe_type;
+    using floe::test::point_type;
+    using floe_group_type = floe::floes::PartialFloeGroup<floe_type>;
+    using detector_type = floe::collision::matlab::MatlabDetector<floe_group_type>;
+
+    if (argc < 3)
+    {
+        cout << "Usage: " << argv[0] << " <N_floes_per_side> <N_strips_per_floe> [N_detections]" << endl;
+        return 1;
+    }
+    const std::size_t N = atoi(argv[1]); // 8
+    const std::size_t K = atoi(argv[2]); // 4
+    const int N_detect = (argc > 3) ? atoi(argv[3]) : 10;
+    const double L = 40, w = L / K;
+
+    for (bool oriented_boxes : {false, true})
+    {
+        floe_group_type floe_group;
+        std::mt19937 gen(3);
+        std::uniform_real_distribution<double> U(-1, 1);
+        std::vector<double> thetas(N * N);
+        for (auto& theta : thetas) theta = 0.2 * U(gen);
+        floe::test::set_floes(floe_group, N * N * K, [&](floe_type& floe, std::size_t i) {
+            const std::size_t n = i / K;
+            const double theta = thetas[n], offset = (double(i % K) - (K - 1) / 2.) * (w + 0.05);
+            const point_type pos{1.3 * L * (n % N) - std::sin(theta) * offset, 1.3 * L * (n / N) + std::cos(theta) * offset};
+            floe::test::set_rectangle(floe, L / 2, w / 2, 917 * L * w, pos, {0.01 * U(gen), 0.01 * U(gen)}, 0, theta, 1.);
+        });
+
+        cout << (oriented_boxes ? "Global disks and oriented boxes:" : "Global disks:") << endl;
+        detector_type detector;
+        detector.set_oriented_boxes(oriented_boxes);
+        detector.set_floe_group(floe_group);
+        const auto t_start = chrono::steady_clock::now();
+        for (int i = 0; i < N_detect; ++i)
+            detector.update();
+        const auto t_end = chrono::steady_clock::now();
+
+        auto const& contact_graph = detector.contact_graph();
+        std::size_t nb_contacts = 0;
+        for (auto const& e : boost::make_iterator_range(edges(contact_graph)))
+            nb_contacts += contact_graph[e].size();
+        cout << "\t" << floe_group.get_floes().size() << " floes, " << nb_contacts << " contacts between "
+             << num_edges(contact_graph) << " pairs" << endl;
+        cout << "\tDetection: " << chrono::duration<double, milli>(t_end - t_start).count() / N_detect << " ms" << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,196 @@
+#include "../tests/catch.hpp"
+#include <cmath>
+#include <vector>
+#include <boost/graph/adjacency_list.hpp>
+#include "../tests/floe/test_floes.hpp"
+#include "floe/geometry/arithmetic/point_operators.hpp"
+#include "floe/collision/aggregate_manager.hpp"
+#include "floe/collision/contact_graph.hpp"
+#include "floe/lcp/solver/LCP_solver.hpp"
+#include "floe/lcp/LCP_manager.hpp"
+
+
+namespace {
+
+using floe::test::floe_type;
+using floe::test::point_type;
+
+struct TestFrame { point_type c; point_type const& center() const { return c; } };
+struct TestContact { TestFrame frame; };
+struct TestVertex { floe_type const* floe; };
+
+using graph_type = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, TestVertex, std::vector<TestContact>>;
+
+//! Floes 0-1-2 aligned and in contact, floe 3 alone
+graph_type contact_graph(std::vector<floe_type> const& floes)
+{
+    graph_type graph;
+    for (auto const& floe : floes) add_vertex({&floe}, graph);
+    add_edge(0, 1, std::vector<TestContact>{{{point_type{1, 0}}}}, graph);
+    add_edge(1, 2, std::vector<TestContact>{{{point_type{3, 0}}}}, graph);
+    return graph;
+}
+
+double momentum(std::vector<floe_type> const& floes, int k, std::size_t n = 3)
+{
+    double sum = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        auto const& s = floes[i].get_state();
+        const double m = floes[i].mass();
+        sum += (k == 0) ? m * s.speed.x :
+               (k == 1) ? m * s.speed.y :
+                          floes[i].moment_cst() * s.rot + m * (s.pos.x * s.speed.y - s.pos.y * s.speed.x);
+    }
+    return sum;
+}
+
+//! Floes of side 2 at the positions, with the masses, speeds and rotation speeds
+std::vector<floe_type> square_floes(std::vector<point_type> const& pos, std::vector<double> const& m,
+                                    std::vector<point_type> const& speed, std::vector<double> const& rot)
+{
+    std::vector<floe_type> floes(pos.size());
+    for (std::size_t i = 0; i < pos.size(); ++i)
+        floe::test::set_square(floes[i], 1, m[i], pos[i], speed[i], rot[i]);
+    return floes;
+}
+
+} // namespace
+
+
+TEST_CASE( "Test compound rigid aggregates", "[collision]" ) {
+
+    using manager_type = floe::collision::AggregateManager<floe_type>;
+
+    auto floes = square_floes({{0, 0}, {2, 0}, {4, 0}, {9, 0}}, {1, 2, 1, 1},
+                              {{0.1, 0}, {0.1, 0.0002}, {0.1, 0.0004}, {-0.3, 0}}, {0, 0, 0, 0.01});
+    auto const graph = contact_graph(floes);
+
+    manager_type manager;
+    REQUIRE( !manager.is_enabled() );
+    manager.set_nb_steps(3);
+    manager.set_speed_threshold(1e-3);
+    manager.set_impulse_threshold(10);
+    manager.set_split_impulse(100);
+    manager.reset(floes.size());
+
+    // bonded after 3 quiet steps
+    manager.update(floes, graph);
+    manager.update(floes, graph);
+    REQUIRE( manager.nb_aggregates() == 0 );
+    const double P0[3] = {momentum(floes, 0), momentum(floes, 1), momentum(floes, 2)};
+    manager.update(floes, graph);
+    REQUIRE( manager.nb_aggregates() == 1 );
+    REQUIRE( manager.nb_bonds() == 2 );
+    auto const& ids = manager.aggregate_ids();
+    REQUIRE( ids[0] == ids[1] );
+    REQUIRE( ids[1] == ids[2] );
+    REQUIRE( ids[3] == manager_type::npos );
+
+    // rigid motion with the same momentum and angular momentum
+    for (int k = 0; k < 3; ++k)
+        REQUIRE( std::abs(momentum(floes, k) - P0[k]) < 1e-12 );
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        auto const& s = floes[i].state();
+        REQUIRE( s.rot == floes[0].state().rot );
+        REQUIRE( std::abs(s.speed.x - floes[1].state().speed.x) < 1e-12 );
+        REQUIRE( std::abs(s.speed.y - floes[1].state().speed.y - s.rot * (s.pos.x - floes[1].state().pos.x)) < 1e-12 );
+    }
+    REQUIRE( floes[3].state().rot == 0.01 ); // lone floe unchanged
+
+    // split by a strong impulse
+    floes[2].reset_impulse(1000);
+    manager.update(floes, graph);
+    REQUIRE( manager.nb_aggregates() == 0 );
+    REQUIRE( ids[0] == manager_type::npos );
+
+    // a noisy contact is never bonded
+    floes[2].reset_impulse();
+    manager.reset(floes.size());
+    floes[1].state().speed.y = 0.01;
+    for (int n = 0; n < 5; ++n)
+    {
+        floes[1].state().speed.y = -floes[1].state().speed.y;
+        manager.update(floes, graph);
+    }
+    REQUIRE( manager.nb_aggregates() == 0 );
+}
+
+TEST_CASE( "Test rotating aggregate in collision", "[collision]" ) {
+
+    using manager_type = floe::collision::AggregateManager<floe_type>;
+    using lcp_manager_type = floe::lcp::LCPManager<floe::lcp::solver::LCPSolver<double>>;
+    using contact_type = floe::collision::ContactPoint<floe_type>;
+    using lcp_graph_type = floe::collision::ContactGraph<contact_type>;
+
+    // floes 0 and 1 rotating about their contact point, floe 2 hitting floe 1
+    const double omega = 0.5;
+    auto floes = square_floes({{-1, 0}, {1, 0}, {3, 0}}, {1, 1, 1}, {{0, -omega}, {0, omega}, {-1, 0}}, {omega, omega, 0});
+    auto make_graph = [&floes](bool internal) {
+        lcp_graph_type graph;
+        for (auto& floe : floes) add_vertex(floe::collision::FloeVertex<floe_type>(&floe), graph);
+        auto add_contact = [&](std::size_t i, std::size_t j, point_type a) {
+            floe::collision::FloeContact<contact_type> contacts;
+            contacts.push_back(contact_type(&floes[i], &floes[j], a, a + point_type{1e-3, 0}));
+            add_edge(i, j, contacts, graph);
+        };
+        if (internal) add_contact(0, 1, point_type{0, 0});
+        add_contact(1, 2, point_type{2, 0});
+        return graph;
+    };
+
+    manager_type manager;
+    manager.set_nb_steps(2);
+    manager.reset(floes.size());
+    auto graph = make_graph(true);
+    manager.update(floes, graph);
+    manager.update(floes, graph);
+    REQUIRE( manager.nb_aggregates() == 1 );
+    REQUIRE( manager.aggregate_ids()[2] == manager_type::npos );
+
+    // the contacts between members are not part of the contact graph (see MatlabDetector::set_aggregate_ids)
+    auto external_graph = make_graph(false);
+    const std::size_t nb_approaching = manager.nb_approaching_contacts(floes, external_graph);
+    REQUIRE( nb_approaching == 1 );
+
+    // collisions solved on the external contact until the projected aggregate motion is not approaching anymore
+    lcp_manager_type lcp_manager(1e-11);
+    const double P0[3] = {momentum(floes, 0), momentum(floes, 1), momentum(floes, 2)};
+    const std::size_t nb_left = manager.solve_external_contacts(floes, external_graph, lcp_manager);
+    REQUIRE( nb_left == 0 );
+    REQUIRE( manager.nb_approaching_contacts(floes, external_graph) == 0 );
+    REQUIRE( floes[0].state().rot == floes[1].state().rot );
+    REQUIRE( floes[2].total_received_impulse() > 0 );
+    for (int k = 0; k < 3; ++k)
+        REQUIRE( momentum(floes, k) == Approx(P0[k]) );
+
+    // members moved one by one, then set back to a rigid displacement
+    const double dt = 1;
+    manager.save_positions(floes);
+    for (auto& floe : floes)
+    {
+        auto state = floe.get_state();
+        state.pos += dt * floe.state().speed;
+        state.theta += dt * floe.state().rot;
+        state.speed = state.speed * 0.9; // drag of each member
+        floe.set_state(state);
+    }
+    const point_type center = (floes[0].state().pos + floes[1].state().pos) * 0.5;
+    const double euler_gap = std::sqrt((floes[1].state().pos.x - floes[0].state().pos.x) * (floes[1].state().pos.x - floes[0].state().pos.x)
+                                       + (floes[1].state().pos.y - floes[0].state().pos.y) * (floes[1].state().pos.y - floes[0].state().pos.y));
+    REQUIRE( euler_gap > 2.1 ); // members drifting apart
+    const auto lone_state = floes[2].get_state();
+    manager.rigid_move(floes);
+    const point_type d = floes[1].state().pos - floes[0].state().pos;
+    const double gap = std::sqrt(d.x * d.x + d.y * d.y);
+    REQUIRE( gap == Approx(2) );
+    REQUIRE( floes[0].state().theta == Approx(floes[1].state().theta) );
+    REQUIRE( std::atan2(d.y, d.x) == Approx(floes[0].state().theta) );
+    const point_type new_center = (floes[0].state().pos + floes[1].state().pos) * 0.5;
+    REQUIRE( new_center.x == Approx(center.x) );
+    REQUIRE( new_center.y == Approx(center.y) );
+    REQUIRE( floes[0].state().rot == floes[1].state().rot );
+    REQUIRE( floes[2].state().pos.x == lone_state.pos.x ); // lone floe unchanged
+    REQUIRE( floes[2].state().speed.x == lone_state.speed.x );
+}
@@ -0,0 +1,92 @@
+#include "../tests/catch.hpp"
+#include <algorithm>
+#include <vector>
+#include "floe/floes/static_floe.hpp"
+#include "floe/floes/kinematic_floe.hpp"
+#include "floe/floes/partial_floe_group.hpp"
+#include "floe/collision/matlab/detector.hpp"
+
+
+namespace {
+
+using floe_type = floe::floes::KinematicFloe<floe::floes::StaticFloe<double>>;
+using floe_group_type = floe::floes::PartialFloeGroup<floe_type>;
+using point_type = floe_type::point_type;
+
+//! Detector exposing the contact manifold reduction
+struct TestDetector : floe::collision::matlab::MatlabDetector<floe_group_type>
+{
+    using MatlabDetector::reduce_contact_manifold;
+};
+
+using contact_list_type = TestDetector::contact_list_type;
+
+//! Contacts along the flush edge y = 0 at the abscissas xs, the contact at abscissa deep being the deepest one
+contact_list_type flush_contacts(std::vector<double> const& xs, double deep)
+{
+    contact_list_type contacts;
+    for (double x : xs)
+        contacts.push_back({nullptr, nullptr, point_type{x, 0}, point_type{x, (x == deep) ? -1e-3 : -2e-3}});
+    return contacts;
+}
+
+//! Abscissas of the contacts
+std::vector<double> abscissas(contact_list_type const& contacts)
+{
+    std::vector<double> xs;
+    for (auto const& contact : contacts) xs.push_back(contact.frame.center().x);
+    std::sort(xs.begin(), xs.end());
+    return xs;
+}
+
+} // namespace
+
+
+TEST_CASE( "Test contact manifold reduction", "[collision]" ) {
+
+    TestDetector detector;
+    detector.set_manifold_max_size(4);
+    const std::size_t nb_points = 40;
+
+    // manifold smaller than the limit: unchanged
+    {
+        const std::vector<std::size_t> ids{10, 11, 12};
+        auto contacts = flush_contacts({0, 1, 2}, 1);
+        detector.reduce_contact_manifold(contacts, ids, nb_points);
+        REQUIRE( contacts.size() == 3 );
+    }
+
+    // manifold larger than the limit: extreme, deepest and evenly spaced contacts
+    const std::vector<double> edge{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    {
+        const std::vector<std::size_t> ids{10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+        auto contacts = flush_contacts(edge, 6);
+        detector.reduce_contact_manifold(contacts, ids, nb_points);
+        const auto xs = abscissas(contacts);
+        REQUIRE( xs.size() == 4 );
+        REQUIRE( xs.front() == 0 );
+        REQUIRE( xs.back() == 9 );
+        REQUIRE( std::count(xs.begin(), xs.end(), 6.) == 1 );
+    }
+
+    // manifold crossing the boundary seam (points 36 to 39 then 0 to 5, listed from point 0): a single cluster
+    const std::vector<double> seam_edge{4, 5, 6, 7, 8, 9, 0, 1, 2, 3};
+    {
+        const std::vector<std::size_t> ids{0, 1, 2, 3, 4, 5, 36, 37, 38, 39};
+        auto contacts = flush_contacts(seam_edge, 6);
+        detector.reduce_contact_manifold(contacts, ids, nb_points);
+        const auto xs = abscissas(contacts);
+        REQUIRE( xs.size() == 4 );
+        REQUIRE( xs.front() == 0 );
+        REQUIRE( xs.back() == 9 );
+        REQUIRE( std::count(xs.begin(), xs.end(), 6.) == 1 );
+    }
+
+    // clusters at the end and at the beginning of the boundary, not adjacent: reduced separately
+    {
+        const std::vector<std::size_t> ids{0, 1, 2, 3, 4, 5, 30, 31, 32, 33};
+        auto contacts = flush_contacts(seam_edge, 6);
+        detector.reduce_contact_manifold(contacts, ids, nb_points);
+        REQUIRE( contacts.size() == 8 );
+    }
+}
@@ -0,0 +1,156 @@
+#include "../tests/catch.hpp"
+#include <cmath>
+#include <vector>
+#include <boost/graph/adjacency_list.hpp>
+#include "../tests/floe/test_floes.hpp"
+#include "floe/geometry/arithmetic/point_operators.hpp"
+#include "floe/collision/contact_point.hpp"
+#include "floe/collision/dem_manager.hpp"
+
+
+namespace {
+
+using floe::test::floe_type;
+using floe::test::point_type;
+
+using contact_type = floe::collision::ContactPoint<floe_type>;
+struct TestVertex { floe_type const* floe; };
+using graph_type = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, TestVertex, std::vector<contact_type>>;
+
+//! Floes of side 10 and mass 1000 at the positions xs, moving at the speeds
+std::vector<floe_type> square_floes(std::vector<double> const& xs, std::vector<point_type> const& speeds)
+{
+    std::vector<floe_type> floes(xs.size());
+    for (std::size_t i = 0; i < xs.size(); ++i)
+        floe::test::set_square(floes[i], 5, 1000, point_type{xs[i], 0}, speeds[i]);
+    return floes;
+}
+
+//! Floes 0 and 1 side by side at a distance gap (two contact points), the other floes alone
+graph_type contact_graph(std::vector<floe_type> const& floes, double gap)
+{
+    graph_type graph;
+    for (auto const& floe : floes) add_vertex({&floe}, graph);
+    add_edge(0, 1, std::vector<contact_type>{
+        {&floes[0], &floes[1], point_type{5, -4}, point_type{5 + gap, -4}},
+        {&floes[0], &floes[1], point_type{5, 4}, point_type{5 + gap, 4}}
+    }, graph);
+    return graph;
+}
+
+//! Same contact point detected from the other floe
+contact_type flipped(contact_type const& contact)
+{
+    const point_type u = contact.frame.u();
+    return {contact.floe2, contact.floe1, contact_type::frame_type{contact.frame.center(), point_type{-u.x, -u.y}}, contact.dist};
+}
+
+double momentum(std::vector<floe_type> const& floes, int k)
+{
+    double sum = 0;
+    for (auto const& floe : floes)
+    {
+        auto const& s = floe.get_state();
+        const double m = floe.mass();
+        sum += (k == 0) ? m * s.speed.x :
+               (k == 1) ? m * s.speed.y :
+                          floe.moment_cst() * s.rot + m * (s.pos.x * s.speed.y - s.pos.y * s.speed.x);
+    }
+    return sum;
+}
+
+} // namespace
+
+
+TEST_CASE( "Test explicit penalty contact forces", "[collision]" ) {
+
+    using manager_type = floe::collision::DEMManager<floe_type>;
+
+    // floe 0 pushes floe 1, that slides upward: overlap of half the skin (skin = sqrt(100) / 100)
+    auto floes = square_floes({0, 10.05, 30}, {point_type{0.1, 0}, point_type{0, 0.01}, point_type{-1, 0}});
+    auto graph = contact_graph(floes, 0.05);
+
+    manager_type manager;
+    REQUIRE( !manager.is_enabled() );
+    manager.set_stiffness(1e5);
+    REQUIRE( manager.is_enabled() );
+
+    // stiffness bound (2 contact points per floe) below the kinematic bound and the default time step
+    const double dt = manager.stable_time_step(floes, graph, 10.);
+    REQUIRE( dt == Approx(0.2 * std::sqrt(1000 / 2e5)) );
+
+    const double p0 = momentum(floes, 0), p1 = momentum(floes, 1), l0 = momentum(floes, 2);
+    const int nb_loaded = manager.solve_contacts(graph, dt);
+    REQUIRE( nb_loaded == 2 );
+    const double speed0 = floes[0].state().speed.x, speed1 = floes[1].state().speed.x, slide1 = floes[1].state().speed.y;
+    REQUIRE( speed0 < 0.1 );
+    REQUIRE( speed1 > 0 );
+    REQUIRE( slide1 < 0.01 ); // friction
+    const double impulse0 = floes[0].total_received_impulse(), impulse1 = floes[1].total_received_impulse();
+    REQUIRE( impulse0 > 0 );
+    REQUIRE( impulse0 == Approx(impulse1) );
+    REQUIRE( floes[2].total_received_impulse() == 0 );
+    const double p0_after = momentum(floes, 0), p1_after = momentum(floes, 1), l0_after = momentum(floes, 2);
+    REQUIRE( p0_after == Approx(p0) );
+    REQUIRE( p1_after == Approx(p1) );
+    REQUIRE( l0_after == Approx(l0) );
+
+    // no force beyond the skin
+    auto far_floes = square_floes({0, 10.2}, {point_type{0.1, 0}, point_type{0, 0.01}});
+    auto far_graph = contact_graph(far_floes, 0.2);
+    REQUIRE( manager.solve_contacts(far_graph, dt) == 0 );
+    REQUIRE( far_floes[0].state().speed.x == 0.1 );
+}
+
+TEST_CASE( "Test penalty contact spring across detection directions", "[collision]" ) {
+
+    using manager_type = floe::collision::DEMManager<floe_type>;
+
+    /* Floe 1 sliding along floe 0 during 3 steps, the contacts being detected:
+     *  0: from floe 0 at each step,
+     *  1: from floe 1 at the steps after the first one,
+     *  2: half from floe 0 and half from floe 1 (two parallel edges) after the first one.
+     */
+    auto run = [](int variant) {
+        auto floes = square_floes({0, 10.05}, {point_type{0, 0}, point_type{0, 0.01}});
+        manager_type manager;
+        manager.set_stiffness(1e5);
+        auto const graph = contact_graph(floes, 0.05);
+        auto const& contacts = graph[*edges(graph).first];
+        graph_type flipped_graph, split_graph;
+        for (auto const& floe : floes)
+        {
+            add_vertex({&floe}, flipped_graph);
+            add_vertex({&floe}, split_graph);
+        }
+        add_edge(1, 0, std::vector<contact_type>{flipped(contacts[0]), flipped(contacts[1])}, flipped_graph);
+        add_edge(0, 1, std::vector<contact_type>{contacts[0]}, split_graph);
+        add_edge(1, 0, std::vector<contact_type>{flipped(contacts[1])}, split_graph);
+
+        const double dt = manager.stable_time_step(floes, graph, 10.);
+        for (int step = 0; step < 3; ++step)
+        {
+            graph_type step_graph = (step == 0 || variant == 0) ? graph : (variant == 1 ? flipped_graph : split_graph);
+            REQUIRE( manager.solve_contacts(step_graph, dt) == 2 );
+        }
+        return floes;
+    };
+
+    // the tangential spring is kept: same motion whatever the detection direction
+    const auto reference = run(0);
+    REQUIRE( reference[1].state().speed.y < 0.01 );
+    for (int variant : {1, 2})
+    {
+        const auto floes = run(variant);
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            auto const& s = floes[i].get_state();
+            auto const& reference_s = reference[i].get_state();
+            const double impulse = floes[i].total_received_impulse(), reference_impulse = reference[i].total_received_impulse();
+            REQUIRE( s.speed.x == Approx(reference_s.speed.x) );
+            REQUIRE( s.speed.y == Approx(reference_s.speed.y) );
+            REQUIRE( s.rot == Approx(reference_s.rot) );
+            REQUIRE( impulse == Approx(reference_impulse) );
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#include "../tests/catch.hpp"
+#include <cmath>
+#include "../tests/floe/test_floes.hpp"
+#include "floe/geometry/arithmetic/point_operators.hpp"
+#include "floe/dynamics/external_forces.hpp"
+
+
+namespace {
+
+using floe::test::floe_type;
+using floe::test::point_type;
+
+//! Uniform wind and sheared current
+struct TestPhysicalData
+{
+    TestPhysicalData(double const&) {}
+    point_type water_speed(point_type p) const { return {0.3 + 0.01 * p.y, -0.2 + 0.02 * p.x}; }
+    point_type air_speed(point_type) const { return {5, 2}; }
+};
+
+} // namespace
+
+
+TEST_CASE( "Test generalized drag Jacobian", "[dynamics]" ) {
+
+    using forces_type = floe::dynamics::ExternalForces<floe_type, TestPhysicalData>;
+
+    double time = 0;
+    forces_type forces{time};
+    floe_type floe;
+    floe::test::set_square(floe, 1, 1, point_type{1, 2}, point_type{0.1, -0.4}, 0.05);
+    floe.static_floe().set_C_w(0.01);
+
+    for (point_type const p : {point_type{3, -1}, point_type{-2, 4}, point_type{1.5, 2.5}})
+    {
+        auto const drag = forces.total_generalized_drag(floe)(p.x, p.y);
+
+        // Same force and torque as the explicit drag
+        const point_type F = forces.total_drag(floe)(p.x, p.y);
+        REQUIRE( std::abs(drag.force[0] - F.x) < 1e-12 );
+        REQUIRE( std::abs(drag.force[1] - F.y) < 1e-12 );
+        REQUIRE( std::abs(drag.force[2] - forces.total_rot_drag(floe)(p.x, p.y)) < 1e-12 );
+
+        // Jacobian against centered finite differences (stored as the opposite of the Jacobian)
+        const double h = 1e-6;
+        const int idx[3][3] = {{0, 1, 2}, {1, 3, 4}, {2, 4, 5}};
+        for (int k = 0; k < 3; ++k)
+        {
+            auto const s0 = floe.get_state();
+            double* dof[3] = {&floe.state().speed.x, &floe.state().speed.y, &floe.state().rot};
+            *dof[k] += h;
+            auto const plus = forces.total_generalized_drag(floe)(p.x, p.y);
+            floe.state() = s0;
+            *dof[k] -= h;
+            auto const minus = forces.total_generalized_drag(floe)(p.x, p.y);
+            floe.state() = s0;
+            for (int i = 0; i < 3; ++i)
+            {
+                const double fd = - (plus.force[i] - minus.force[i]) / (2 * h);
+                REQUIRE( std::abs(drag.jacobian[idx[i][k]] - fd) < 1e-6 * (1 + std::abs(fd)) );
+            }
+        }
+    }
+}
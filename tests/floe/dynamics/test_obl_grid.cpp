@@ -0,0 +1,45 @@
+#include "../tests/catch.hpp"
+#include "floe/geometry/geometries/point.hpp"
+#include "floe/geometry/arithmetic/point_operators.hpp"
+#include "floe/dynamics/obl_grid.hpp"
+
+
+TEST_CASE( "Test OBL coupling grid", "[dynamics]" ) {
+
+    using point_type = floe::geometry::Point<double>;
+    floe::dynamics::OBLGrid<point_type> grid;
+
+    REQUIRE( !grid.is_initialized() );
+    grid.init({{-10, 10, 0, 5}}, 4, 2, point_type{0.1, 0.2});
+    REQUIRE( grid.is_initialized() );
+    REQUIRE( grid.nb_cells() == 8 );
+    REQUIRE( grid.cell_area() == 12.5 );
+
+    // Cell lookup, points outside the grid belong to the border cells
+    REQUIRE( grid.cell_index(point_type{-9, 1}) == 0 );
+    REQUIRE( grid.cell_index(point_type{9, 4}) == 7 );
+    REQUIRE( grid.cell_index(point_type{-100, -100}) == 0 );
+    REQUIRE( grid.cell_index(point_type{100, 100}) == 7 );
+    for (std::size_t c = 0; c < grid.nb_cells(); ++c)
+        REQUIRE( grid.cell_index(grid.cell_center(c)) == c );
+
+    // Speed per cell
+    grid.cell_speed(5) = point_type{1, 1};
+    REQUIRE( grid.speed(grid.cell_center(5)) == (point_type{1, 1}) );
+    REQUIRE( grid.speed(grid.cell_center(4)) == (point_type{0.1, 0.2}) );
+
+    // Thread-local accumulation and reduction
+    grid.reset_accumulators(3);
+    grid.add_contribution(0, point_type{-9, 1}, point_type{1, 0}, 2);
+    grid.add_contribution(2, point_type{-8, 2}, point_type{0, 3}, 1);
+    grid.add_contribution(1, point_type{9, 4}, point_type{-1, -1}, 4);
+    grid.reduce();
+    REQUIRE( grid.cell_force(0) == (point_type{1, 3}) );
+    REQUIRE( grid.cell_floe_area(0) == 3 );
+    REQUIRE( grid.cell_force(7) == (point_type{-1, -1}) );
+    REQUIRE( grid.cell_floe_area(7) == 4 );
+    REQUIRE( grid.cell_floe_area(3) == 0 );
+
+    grid.set_speed(point_type{2, -2});
+    REQUIRE( grid.mean_speed() == (point_type{2, -2}) );
+}
@@ -0,0 +1,74 @@
+#include "../tests/catch.hpp"
+#include <cmath>
+#include <utility>
+#include "floe/geometry/geometries/point.hpp"
+#include "floe/geometry/arithmetic/point_operators.hpp"
+#include "floe/dynamics/subgrid_ice.hpp"
+
+
+TEST_CASE( "Test sub-grid ice field", "[dynamics]" ) {
+
+    using point_type = floe::geometry::Point<double>;
+    using field_type = floe::dynamics::SubgridIceField<point_type>;
+
+    field_type field;
+    REQUIRE( !field.is_initialized() );
+    field.init({{0, 1000, 0, 500}}, 10, 5);
+    REQUIRE( field.nb_cells() == 50 );
+    REQUIRE( field.cell_index(point_type{-10, 250}) == 20 );
+
+    // scattered small floes: low concentration, negligible pressure
+    field.absorb(point_type{150, 250}, 500, 500 * 917, point_type{0.5, 0.1});
+    field.absorb(point_type{160, 240}, 300, 300 * 917 * 2, point_type{0.3, -0.1});
+    field.absorb(point_type{550, 50}, 200, 200 * 917, point_type{-0.2, 0});
+    const double area = field.total_area(), mass = field.total_mass();
+    const point_type momentum = field.total_momentum();
+    const std::size_t c = field.cell_index(point_type{150, 250});
+    REQUIRE( std::abs(field.thickness(c) - 1.375) < 1e-12 );
+    REQUIRE( std::abs(field.concentration(c) - 0.08) < 1e-12 );
+
+    SECTION( "Advection conserves the ice" ) {
+        auto no_forcing = [](point_type, point_type, double) { return std::make_pair(point_type{0, 0}, 0.); };
+        for (int n = 0; n < 50; ++n)
+            field.step(10, no_forcing);
+        REQUIRE( std::abs(field.total_area() - area) < 1e-9 * area );
+        REQUIRE( std::abs(field.total_mass() - mass) < 1e-9 * mass );
+        const point_type dp = field.total_momentum() - momentum;
+        const double err = std::abs(dp.x) + std::abs(dp.y);
+        REQUIRE( err < 1e-6 * mass );
+        // the main cluster drifted eastward
+        REQUIRE( field.cell_mass(c) < 0.5 * (500 + 600) * 917 );
+        REQUIRE( field.cell_mass(c + 1) > 0 );
+    }
+
+    SECTION( "Implicit drag relaxes toward the water speed" ) {
+        const point_type water{0.1, -0.05};
+        auto drag = [&water](point_type, point_type, double) { return std::make_pair(10 * water, 10.); };
+        for (int n = 0; n < 30; ++n)
+            field.step(100, drag);
+        for (std::size_t i = 0; i < field.nb_cells(); ++i)
+        {
+            if (field.cell_mass(i) <= 0) continue;
+            const point_type dv = field.velocity(i) - water;
+            const double err = std::abs(dv.x) + std::abs(dv.y);
+            REQUIRE( err < 1e-2 );
+        }
+    }
+
+    SECTION( "Exchange with a floe conserves momentum" ) {
+        const double floe_mass = 1e6, floe_area = 1000;
+        const point_type floe_speed{1, 0};
+        const point_type before = field.total_momentum() + floe_mass * floe_speed;
+        const point_type impulse = field.exchange(point_type{155, 245}, floe_area, floe_mass, floe_speed, 10);
+        const point_type new_speed = floe_speed + impulse / floe_mass;
+        const point_type after = field.total_momentum() + floe_mass * new_speed;
+        const double err = std::abs(after.x - before.x) + std::abs(after.y - before.y);
+        REQUIRE( err < 1e-6 * floe_mass );
+        REQUIRE( impulse.x < 0 );
+        REQUIRE( new_speed.x > field.velocity(c).x );
+        // no ice, no exchange
+        const point_type none = field.exchange(point_type{950, 450}, floe_area, floe_mass, floe_speed, 10);
+        REQUIRE( none.x == 0 );
+        REQUIRE( none.y == 0 );
+    }
+}
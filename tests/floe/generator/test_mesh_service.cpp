@@ -0,0 +1,52 @@
+#include "../tests/catch.hpp"
+#include <cmath>
+#include <vector>
+#include "floe/floes/static_floe.hpp"
+#include "floe/generator/mesh_service.hpp"
+
+TEST_CASE( "Test batched meshing of similar shapes", "[generator]" ) {
+
+    using static_floe_type = floe::floes::StaticFloe<double>;
+    using point_type = static_floe_type::point_type;
+    using shape_type = static_floe_type::geometry_type;
+    using mesh_type = static_floe_type::mesh_type;
+    using namespace floe::generator;
+
+    auto make_shape = [](std::vector<point_type> const& points, double scale, point_type const& shift) {
+        shape_type shape;
+        for (auto const& pt : points) shape.outer().push_back({shift.x + scale * pt.x, shift.y + scale * pt.y});
+        return shape;
+    };
+    const std::vector<point_type> pentagon{{0, 0}, {2, 0}, {3, 1.5}, {1, 3}, {-1, 1.5}};
+    const std::vector<point_type> triangle{{0, 0}, {1, 0}, {0, 1}};
+    const std::vector<shape_type> shapes{
+        make_shape(pentagon, 1, {0, 0}),
+        make_shape(triangle, 10, {5, 5}),
+        make_shape(pentagon, 3.7, {-100, 40}), // same library shape, other size and place
+        make_shape(triangle, 10, {5, 5}),
+        make_shape({{0, 0}, {1, 0}, {0, 1.01}}, 10, {5, 5}) // not similar
+    };
+
+    const auto similarities = similar_shapes(shapes);
+    REQUIRE( similarities[0].rep == 0 );
+    REQUIRE( similarities[1].rep == 1 );
+    REQUIRE( similarities[2].rep == 0 );
+    REQUIRE( similarities[3].rep == 1 );
+    REQUIRE( similarities[4].rep == 4 );
+    const double ratio = similarities[2].scale / similarities[0].scale;
+    REQUIRE( ratio == Approx(3.7) );
+
+    // the mesh of a similar shape is the scaled and translated mesh of its representative
+    const auto meshes = generate_meshes_for_shapes<shape_type, mesh_type>(shapes);
+    REQUIRE( meshes.size() == shapes.size() );
+    REQUIRE( meshes[2].points().size() == meshes[0].points().size() );
+    REQUIRE( meshes[2].connectivity() == meshes[0].connectivity() );
+    bool scaled = true;
+    for (std::size_t k = 0; k < meshes[0].points().size(); ++k)
+    {
+        auto const& p0 = meshes[0].points()[k];
+        auto const& p2 = meshes[2].points()[k];
+        scaled = scaled && std::abs(p2.x - (-100 + 3.7 * p0.x)) < 1e-9 && std::abs(p2.y - (40 + 3.7 * p0.y)) < 1e-9;
+    }
+    REQUIRE( scaled );
+}
@@ -0,0 +1,79 @@
+#include "../tests/catch.hpp"
+#include <cmath>
+#include <vector>
+#include "floe/geometry/geometries/point.hpp"
+#include "floe/geometry/arithmetic/point_operators.hpp"
+#include "floe/geometry/algorithms/oriented_box.hpp"
+
+TEST_CASE( "Test convex hull and oriented box envelope", "[geometry]" ) {
+
+    using point_type = floe::geometry::Point<double>;
+    using namespace floe::geometry;
+
+    // thin rectangle 100 x 10 rotated by 30 degrees around (20, -5), closed, with interior and edge points
+    const double angle = M_PI / 6, c = std::cos(angle), s = std::sin(angle);
+    auto place = [&](double u, double v) { return point_type{20 + c * u - s * v, -5 + s * u + c * v}; };
+    std::vector<point_type> ring;
+    for (int i = 0; i <= 10; ++i) ring.push_back(place(-50 + 10 * i, -5));
+    for (int i = 0; i <= 10; ++i) ring.push_back(place(50 - 10 * i, 5));
+    ring.push_back(place(0, 0));
+    ring.push_back(place(-50, -5)); // closing point
+
+    const auto hull = convex_hull_points(ring);
+    REQUIRE( hull.size() >= 4 ); // with points of the long sides, collinear up to rounding
+    REQUIRE( hull.size() < ring.size() - 2 );
+    double area = 0;
+    for (std::size_t i = 0; i < hull.size(); ++i)
+    {
+        auto const& a = hull[i];
+        auto const& b = hull[(i + 1) % hull.size()];
+        area += a.x * b.y - a.y * b.x;
+    }
+    area /= 2;
+    REQUIRE( area == Approx(1000) ); // counter-clockwise
+
+    const auto box = oriented_box_envelope<point_type>(ring);
+    const double long_side = std::max(box.half_length, box.half_width);
+    const double short_side = std::min(box.half_length, box.half_width);
+    REQUIRE( long_side == Approx(50) );
+    REQUIRE( short_side == Approx(5) );
+    REQUIRE( box.center.x == Approx(20) );
+    REQUIRE( box.center.y == Approx(-5) );
+    const double axis_norm = std::hypot(box.axis.x, box.axis.y);
+    REQUIRE( axis_norm == Approx(1) );
+
+    // axis-aligned square with a point in the middle of each side
+    const std::vector<point_type> square{{0, 0}, {1, 0}, {2, 0}, {2, 1}, {2, 2}, {1, 2}, {0, 2}, {0, 1}, {1, 1}};
+    REQUIRE( convex_hull_points(square).size() == 4 );
+}
+
+TEST_CASE( "Test separating axis distance between oriented boxes", "[geometry]" ) {
+
+    using point_type = floe::geometry::Point<double>;
+    using box_type = floe::geometry::OrientedBox<point_type>;
+    using floe::geometry::distance_box_box;
+
+    const double r = std::sqrt(0.5);
+    // two parallel diagonal needles, 20 apart along their normal: their surrounding disks intersect
+    const box_type b1{{0, 0}, {r, r}, 50, 2};
+    const box_type b2{{-20 * r, 20 * r}, {r, r}, 50, 2};
+    REQUIRE( distance_box_box(b1, b2) == Approx(16) );
+    REQUIRE( distance_box_box(b2, b1) == Approx(16) );
+
+    // crossing needles overlap
+    const box_type b3{{10, 0}, {r, -r}, 50, 2};
+    REQUIRE( distance_box_box(b1, b3) <= 0 );
+
+    // lower bound of the distance between the box corners
+    const box_type b4{{60, 75}, {1, 0}, 10, 3};
+    double min_dist = 1e10;
+    for (int i : {-1, 1}) for (int j : {-1, 1}) for (int k : {-1, 1}) for (int l : {-1, 1})
+    {
+        const point_type p1 = b1.center + i * b1.half_length * b1.axis + j * b1.half_width * b1.normal();
+        const point_type p2 = b4.center + k * b4.half_length * b4.axis + l * b4.half_width * b4.normal();
+        min_dist = std::min(min_dist, std::hypot(p1.x - p2.x, p1.y - p2.y));
+    }
+    const double dist = distance_box_box(b1, b4);
+    REQUIRE( dist > 0 );
+    REQUIRE( dist <= min_dist );
+}
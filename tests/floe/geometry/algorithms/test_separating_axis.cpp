@@ -0,0 +1,48 @@
+#include "../tests/catch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "floe/geometry/geometries/point.hpp"
+#include "floe/geometry/algorithms/convex_hull.hpp"
+#include "floe/geometry/algorithms/separating_axis.hpp"
+
+TEST_CASE( "Test separating axis gap between convex hulls of point ranges", "[geometry]" ) {
+
+    using point_type = floe::geometry::Point<double>;
+    using namespace floe::geometry;
+
+    // non-convex "L" shape (counter-clockwise), the hull skips the inner corner (index 3)
+    const std::vector<point_type> L{{0, 0}, {4, 0}, {4, 1}, {1, 1}, {1, 4}, {0, 4}};
+    const auto ids = convex_hull_indices(L);
+    REQUIRE( ids.size() == 5 );
+    REQUIRE( std::find(ids.begin(), ids.end(), 3) == ids.end() );
+    std::vector<double> lengths;
+    for (std::size_t k = 0; k < ids.size(); ++k)
+    {
+        auto const& a = L[ids[k]];
+        auto const& b = L[ids[(k + 1) % ids.size()]];
+        lengths.push_back(std::hypot(b.x - a.x, b.y - a.y));
+    }
+
+    // unit square in the notch of the "L": close to the shape, inside its hull
+    const std::vector<point_type> square{{2, 2}, {3, 2}, {3, 3}, {2, 3}};
+    const std::vector<std::size_t> square_ids{0, 1, 2, 3};
+    const std::vector<double> square_lengths(4, 1.);
+    REQUIRE( convex_polygons_gap(L, ids, lengths, square, square_ids, square_lengths, 0.) <= 0 );
+
+    // same square beyond the hull diagonal edge, from (4,1) to (1,4)
+    const std::vector<point_type> far_square{{4, 4}, {5, 4}, {5, 5}, {4, 5}};
+    const double gap = convex_polygons_gap(L, ids, lengths, far_square, square_ids, square_lengths, 0.);
+    REQUIRE( gap == Approx(3 / std::sqrt(2.)) );
+    REQUIRE( convex_polygons_gap(far_square, square_ids, square_lengths, L, ids, lengths, 0.) == Approx(gap) );
+
+    // required gap greater than the separation
+    REQUIRE( convex_polygons_gap(L, ids, lengths, far_square, square_ids, square_lengths, 3.) <= 3 );
+
+    // a segment (2 vertices) is a degenerate convex polygon
+    const std::vector<point_type> segment{{6, 0}, {6, 3}};
+    const std::vector<std::size_t> segment_ids{0, 1};
+    const std::vector<double> segment_lengths(2, 3.);
+    REQUIRE( convex_polygons_gap(L, ids, lengths, segment, segment_ids, segment_lengths, 0.) == Approx(2) );
+    REQUIRE( convex_polygons_gap(segment, segment_ids, segment_lengths, L, ids, lengths, 0.) == Approx(2) );
+}
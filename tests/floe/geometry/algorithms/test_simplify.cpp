@@ -0,0 +1,64 @@
+#include "../tests/catch.hpp"
+#include <cmath>
+#include "floe/geometry/geometry.hpp"
+#include "floe/geometry/geometries/point.hpp"
+#include <boost/geometry/geometries/polygon.hpp>
+#include <boost/geometry/algorithms/is_valid.hpp>
+#include "floe/geometry/algorithms/simplify.hpp"
+
+TEST_CASE( "Test topology preserving boundary simplification", "[geometry]" ) {
+
+    using point_type = floe::geometry::Point<double>;
+    using Polygon = boost::geometry::model::polygon<point_type, false, false>;
+
+    // high resolution noisy disk, with a deep and thin notch
+    Polygon P;
+    const std::size_t N = 2000;
+    for (std::size_t i = 0; i != N; ++i)
+    {
+        const double frac = 2 * M_PI * i / N;
+        double r = 100 + 0.05 * std::sin(97 * frac) + 0.02 * std::cos(331 * frac);
+        if (i >= 500 && i <= 502) r = 30; // notch of 3 vertices
+        P.outer().push_back({r * std::cos(frac), r * std::sin(frac)});
+    }
+    const double max_error = 0.1;
+
+    Polygon S;
+    const std::size_t nb_removed = floe::geometry::simplify_polygon(P, S, max_error, false);
+    REQUIRE( nb_removed > N / 2 );
+    REQUIRE( S.outer().size() == N - nb_removed );
+    REQUIRE( boost::geometry::is_valid(S) );
+
+    // the notch is kept
+    double min_r = 1e10;
+    for (auto const& p : S.outer()) min_r = std::min(min_r, std::hypot(p.x, p.y));
+    REQUIRE( std::abs(min_r - 30) < 1e-12 );
+
+    // Hausdorff bound: every original point is close to the simplified boundary
+    double max_dist = 0;
+    auto const& ring = S.outer();
+    for (auto const& p : P.outer())
+    {
+        double dist = 1e10;
+        for (std::size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++)
+            dist = std::min(dist, floe::geometry::detail::simplify::segment_distance(p, ring[j], ring[i]));
+        max_dist = std::max(max_dist, dist);
+    }
+    REQUIRE( max_dist <= max_error );
+
+    // area preserving version
+    Polygon A;
+    floe::geometry::simplify_polygon(P, A, max_error);
+    const double area_P = boost::geometry::area(P), area_A = boost::geometry::area(A);
+    REQUIRE( A.outer().size() == S.outer().size() );
+    REQUIRE( std::abs(area_A - area_P) < 1e-9 * area_P );
+
+    // closed rings keep their closing point, nothing removed without tolerance
+    std::vector<point_type> square{{0, 0}, {1, 0}, {2, 0}, {2, 2}, {0, 2}, {0, 0}};
+    std::vector<point_type> out;
+    floe::geometry::simplify_ring(square, out, 1e-6);
+    REQUIRE( out.size() == 5 );
+    REQUIRE( out.front().x == out.back().x );
+    floe::geometry::simplify_ring(square, out, 0.);
+    REQUIRE( out.size() == 6 );
+}
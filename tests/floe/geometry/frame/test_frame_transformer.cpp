@@ -8,7 +8,10 @@
 #include "floe/geometry/geometries/point.hpp"
 #include "floe/geometry/frame/theta_frame.hpp"
 #include "floe/geometry/frame/frame_transformers.hpp"
+#include "floe/geometry/frame/batch_transform.hpp"
 #include "floe/geometry/geometries/circle.hpp"
+#include "floe/geometry/geometries/multi_circle.hpp"
+#include "floe/geometry/algorithms/transform.hpp"
 
 #include <chrono>
 
@@ -92,4 +95,53 @@ TEST_CASE( "Test frame transformer", "[frame]" ) {
     t_end = chrono::high_resolution_clock::now();
     cout << "boost rotate : " << chrono::duration<double, std::milli>(t_end-t_start).count() << " ms" << endl;
     // CHRONO TRANSFORM
-}
\ No newline at end of file
+}
+
+TEST_CASE( "Test batch frame transform", "[frame]" ) {
+
+    using namespace floe::geometry;
+    using namespace std;
+
+    using point_type = Point<double>;
+    using frame_type = frame::ThetaFrame<point_type>;
+    using polygon = boost::geometry::model::polygon<point_type, false, false>;
+    using circle_type = Circle<point_type>;
+
+    const frame_type frame1{point_type{1.23, 3.21}, 0.7}, frame2{point_type{-4.5, 0.3}, -2.1};
+
+    int N = 2000;
+    polygon B{}, B1{}, B2{};
+    for (int i = 0; i < N ; ++i)
+        B.outer().push_back(point_type{cos((double) i / N), 2 * sin((double) i / N)});
+
+    // Same result as the matrix transformer
+    auto t_start = chrono::high_resolution_clock::now();
+    transform( B, B1, frame::transformer( frame1 ) );
+    auto t_end = chrono::high_resolution_clock::now();
+    cout << "boost transform : " << chrono::duration<double, std::milli>(t_end-t_start).count() << " ms" << endl;
+
+    t_start = chrono::high_resolution_clock::now();
+    frame::transform_polygon( B, B2, frame::rigid_transformer( frame1 ) );
+    t_end = chrono::high_resolution_clock::now();
+    cout << "batch transform : " << chrono::duration<double, std::milli>(t_end-t_start).count() << " ms" << endl;
+
+    REQUIRE( B2.outer().size() == B.outer().size() );
+    double err = 0;
+    for (int i = 0; i < N; ++i)
+        err = std::max(err, distance(B1.outer()[i], B2.outer()[i]));
+    REQUIRE( err < 1e-12 );
+
+    // Frame to frame, in place, on circles
+    MultiCircle<circle_type> C1, C2;
+    for (int i = 0; i < 10; ++i)
+        C1.push_back(circle_type{point_type{double(i), -0.5 * i}, 0.1 * i});
+    C2 = C1;
+    transform( C1, C1, frame::itransformer( frame1, frame2 ) );
+    frame::transform_circles( C2, C2, frame::rigid_itransformer( frame1, frame2 ) );
+    for (int i = 0; i < 10; ++i)
+    {
+        const double d = distance(C1[i].center, C2[i].center);
+        REQUIRE( d < 1e-12 );
+        REQUIRE( C2[i].radius == C1[i].radius );
+    }
+}
@@ -0,0 +1,98 @@
+#include "../tests/catch.hpp"
+#include <array>
+#include <cmath>
+#include <vector>
+#include "../tests/floe/test_floes.hpp"
+#include "floe/geometry/arithmetic/point_operators.hpp"
+#include "floe/io/diagnostics.hpp"
+
+
+namespace {
+
+using floe::test::floe_type;
+using floe::test::point_type;
+
+//! Floes in the fixed window [0, 100] x [0, 100]
+struct TestFloeGroup
+{
+    using floe_type = ::floe_type;
+    using real_type = double;
+    using point_type = ::point_type;
+    std::vector<floe_type> floes;
+    std::vector<floe_type> const& get_floes() const { return floes; }
+    std::array<double, 4> bounding_window(double) const { return {{0, 100, 0, 100}}; }
+};
+
+} // namespace
+
+
+TEST_CASE( "Test in-situ diagnostics", "[io]" ) {
+
+    using manager_type = floe::io::DiagnosticsManager<TestFloeGroup>;
+
+    // square floes of areas 100, 300, 2000 and 10 m^2
+    TestFloeGroup group;
+    group.floes.resize(4);
+    floe::test::set_square(group.floes[0], 5, 1e3, point_type{10, 10}, point_type{1, 0});
+    floe::test::set_square(group.floes[1], 0.5 * std::sqrt(300.), 3e3, point_type{20, 20}, point_type{0, 1});
+    floe::test::set_square(group.floes[2], 0.5 * std::sqrt(2000.), 1e4, point_type{80, 80}, point_type{-1, 0});
+    floe::test::set_square(group.floes[3], 0.5 * std::sqrt(10.), 1e2, point_type{80, 20}, point_type{5, 5});
+    group.floes[3].state().desactivate();
+
+    manager_type diagnostics;
+    REQUIRE( !diagnostics.is_enabled() );
+    diagnostics.add_default_reducers(2, 1, 1e4);
+    diagnostics.set_out_step(60);
+    REQUIRE( diagnostics.nb_reducers() == 4 );
+
+    // first diagnostics at the first call, then every out step
+    REQUIRE( diagnostics.reduce_if_needed(0, group) );
+    REQUIRE( !diagnostics.reduce_if_needed(30, group) );
+    auto const& records = diagnostics.records();
+    REQUIRE( records.size() == 4 );
+
+    // gridded fields: 2x2 cells of 50 m, [concentration, u, v, kinetic energy] x 4 cells
+    auto const& fields = records[0].second;
+    REQUIRE( records[0].first == "gridded_fields" );
+    REQUIRE( fields.size() == 1 + 16 );
+    REQUIRE( fields[0] == 0 );
+    REQUIRE( std::abs(fields[1 + 0] - 400. / 2500) < 1e-12 );
+    REQUIRE( std::abs(fields[1 + 4] - 0.25) < 1e-12 );
+    REQUIRE( std::abs(fields[1 + 8] - 0.75) < 1e-12 );
+    REQUIRE( fields[1 + 1] == 0 ); // only an inactive floe in cell 1
+    REQUIRE( std::abs(fields[1 + 7] + 1) < 1e-12 );
+    REQUIRE( std::abs(fields[1 + 15] - 5e3) < 1e-9 );
+
+    // spectrum: mean flow energy in the first shell
+    auto const& spectrum = records[1].second;
+    REQUIRE( spectrum.size() == 1 + 2 );
+    const double mean_u = (0.25 - 1) / 4, mean_v = 0.75 / 4;
+    const double total_energy = 0.5 * (0.25 * 0.25 + 0.75 * 0.75 + 1) / 4;
+    REQUIRE( std::abs(spectrum[1] - 0.5 * (mean_u * mean_u + mean_v * mean_v)) < 1e-12 );
+    REQUIRE( std::abs(spectrum[1] + spectrum[2] - total_energy) < 1e-12 );
+
+    // floe size distribution: 3 active floes in 40 log classes between 1 and 1e4 m^2
+    auto const& fsd = records[2].second;
+    REQUIRE( fsd.size() == 1 + 40 );
+    double nb = 0;
+    for (std::size_t k = 1; k < fsd.size(); ++k) nb += fsd[k];
+    REQUIRE( nb == 3 );
+    REQUIRE( fsd[1 + 20] == 1 );
+    REQUIRE( fsd[1 + 24] == 1 );
+    REQUIRE( fsd[1 + 33] == 1 );
+
+    // dispersion after a uniform drift and a spreading
+    diagnostics.clear();
+    for (auto& floe : group.floes) floe.state().pos += point_type{5, 0};
+    group.floes[0].state().pos += point_type{0, 3};
+    group.floes[1].state().pos += point_type{0, -3};
+    REQUIRE( diagnostics.reduce_if_needed(60, group) );
+    auto const& dispersion = diagnostics.records()[3].second;
+    REQUIRE( dispersion.size() == 1 + 6 );
+    REQUIRE( dispersion[0] == 60 );
+    REQUIRE( dispersion[1] == 3 );
+    REQUIRE( std::abs(dispersion[2] - 5) < 1e-12 );
+    REQUIRE( std::abs(dispersion[3]) < 1e-12 );
+    REQUIRE( std::abs(dispersion[4]) < 1e-12 );
+    REQUIRE( std::abs(dispersion[5] - 6) < 1e-12 );
+}
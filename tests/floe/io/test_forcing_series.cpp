@@ -0,0 +1,68 @@
+#include "../tests/catch.hpp"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "floe/geometry/geometries/point.hpp"
+#include "floe/geometry/arithmetic/point_operators.hpp"
+#include "floe/io/forcing_series.hpp"
+
+
+TEST_CASE( "Test forcing series read by windows", "[io]" ) {
+
+    using point_type = floe::geometry::Point<double>;
+    using series_type = floe::io::ForcingSeries<point_type>;
+
+    // 100 hours of rotating ocean and air speeds
+    std::vector<point_type> ocean_data, air_data;
+    for (int i = 0; i < 100; ++i)
+    {
+        ocean_data.push_back({0.1 * std::cos(0.3 * i), 0.1 * std::sin(0.3 * i)});
+        air_data.push_back({5 + std::cos(0.05 * i), -2 + 0.01 * i});
+    }
+    const std::string file_name = "test_forcing_series.frc";
+    floe::io::write_forcing_series(file_name, ocean_data, air_data);
+
+    series_type full, windowed;
+    full.open(file_name, 100);
+    windowed.open(file_name, 6);
+    REQUIRE( full.nb_hours() == 100 );
+    REQUIRE( windowed.window_size() == 6 );
+
+    // ramp from rest, then hourly data
+    const point_type start = full.ocean(0);
+    REQUIRE( start.x == 0 );
+    REQUIRE( start.y == 0 );
+    const double hour_12 = 12 * 3600;
+    for (int i : {0, 10, 98})
+    {
+        const point_type p = full.air(hour_12 + 3600 * i);
+        const double err = std::abs(p.x - air_data[i].x) + std::abs(p.y - air_data[i].y);
+        REQUIRE( err < 1e-12 );
+    }
+    // the last minute is kept after the end of the series
+    const point_type end = full.ocean(1e9), last = full.ocean(hour_12 + 3600 * 99 - 60);
+    REQUIRE( end.x == last.x );
+    REQUIRE( end.y == last.y );
+
+    // same values with only a few hours in memory
+    double max_err = 0;
+    for (double t = 0; t < hour_12 + 3600 * 101; t += 300)
+    {
+        windowed.prepare(t);
+        REQUIRE( windowed.window_size() <= 6 );
+        const point_type dp = windowed.ocean(t) - full.ocean(t);
+        const point_type da = windowed.air(t) - full.air(t);
+        max_err = std::max(max_err, std::abs(dp.x) + std::abs(dp.y) + std::abs(da.x) + std::abs(da.y));
+    }
+    REQUIRE( max_err == 0 );
+    REQUIRE( windowed.window_first() > 90 );
+
+    // back in time (states recovered from file)
+    windowed.prepare(hour_12 + 3600 * 5.5);
+    REQUIRE( windowed.window_first() == 5 );
+    const point_type back = windowed.ocean(hour_12 + 3600 * 5.5) - full.ocean(hour_12 + 3600 * 5.5);
+    REQUIRE( back.x == 0 );
+    REQUIRE( back.y == 0 );
+
+    std::remove(file_name.c_str());
+}
@@ -0,0 +1,68 @@
+#include "../tests/catch.hpp"
+#include <cmath>
+#include <vector>
+#include "floe/geometry/geometries/point.hpp"
+#include "floe/io/raster_import.hpp"
+
+
+TEST_CASE( "Test floe extraction from a labelled raster", "[io]" ) {
+
+    using point_type = floe::geometry::Point<double>;
+
+    // 200 x 100 raster of 2 m pixels: a rectangle, a disk, a pixel and two diagonal blocks with the same label
+    floe::io::LabelRaster<double> raster;
+    raster.nx = 200;
+    raster.ny = 100;
+    raster.pixel_size = 2;
+    raster.labels.assign(raster.nx * raster.ny, 0);
+    auto set = [&](std::size_t i, std::size_t j, std::uint32_t label) { raster.labels[(raster.ny - 1 - j) * raster.nx + i] = label; };
+    std::size_t nb_disk = 0;
+    for (std::size_t j = 0; j < raster.ny; ++j)
+        for (std::size_t i = 0; i < raster.nx; ++i)
+        {
+            if (i >= 10 && i < 40 && j >= 20 && j < 30) set(i, j, 7);
+            const double dx = i + 0.5 - 120, dy = j + 0.5 - 50;
+            if (dx * dx + dy * dy < 30 * 30) { set(i, j, 3); ++nb_disk; }
+            if (i >= 180 && i < 185 && j >= 80 && j < 85) set(i, j, 9);
+            if (i >= 185 && i < 188 && j >= 85 && j < 88) set(i, j, 9);
+        }
+    set(5, 5, 11); // too small
+    set(20, 25, 0); // hole in the rectangle, filled
+
+    auto floes = floe::io::extract_raster_floes<point_type>(raster, 0.5, 4);
+    REQUIRE( floes.size() == 3 );
+    REQUIRE( floes[0].label == 3 );
+    REQUIRE( floes[1].label == 7 );
+    REQUIRE( floes[2].label == 9 );
+
+    auto ring_area = [](std::vector<point_type> const& ring) {
+        double area = 0;
+        for (std::size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++)
+            area += ring[j].x * ring[i].y - ring[i].x * ring[j].y;
+        return area / 2;
+    };
+
+    // counterclockwise shapes centered on their centroid, with the area of their pixels
+    const double disk_area = ring_area(floes[0].shape);
+    REQUIRE( std::abs(disk_area - 4. * nb_disk) < 1e-9 * disk_area );
+    REQUIRE( std::abs(floes[0].pos.x - 240) < 0.5 );
+    REQUIRE( std::abs(floes[0].pos.y - 100) < 0.5 );
+    REQUIRE( floes[0].shape.size() < 100 );
+    double max_r = 0;
+    for (auto const& p : floes[0].shape) max_r = std::max(max_r, std::hypot(p.x, p.y));
+    REQUIRE( std::abs(max_r - 60) < 3 );
+
+    // the rectangle contour cuts its corners by half a pixel, within the tolerance: 4 points are left
+    const double rectangle_area = ring_area(floes[1].shape);
+    REQUIRE( std::abs(rectangle_area - 4. * 300) < 1e-9 );
+    REQUIRE( floes[1].shape.size() == 4 );
+    REQUIRE( std::abs(floes[1].pos.x - 50) < 1e-9 );
+    REQUIRE( std::abs(floes[1].pos.y - 50) < 1e-9 );
+
+    // diagonal blocks are not connected: the largest one is kept
+    const double block_area = ring_area(floes[2].shape);
+    REQUIRE( std::abs(block_area - 4. * 25) < 1e-9 );
+    REQUIRE( std::abs(floes[2].pos.x - 365) < 1e-9 );
+
+    REQUIRE( raster.window()[1] == 400 );
+}
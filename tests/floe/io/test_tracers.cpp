@@ -0,0 +1,96 @@
+#include "../tests/catch.hpp"
+#include <cmath>
+#include <vector>
+#include "../tests/floe/test_floes.hpp"
+#include "floe/geometry/arithmetic/point_operators.hpp"
+#include "floe/io/tracers.hpp"
+
+
+namespace {
+
+using floe::test::floe_type;
+using floe::test::point_type;
+
+struct TestFloeGroup
+{
+    using floe_type = ::floe_type;
+    using real_type = double;
+    using point_type = ::point_type;
+    std::vector<floe_type> floes;
+    std::vector<floe_type> const& get_floes() const { return floes; }
+};
+
+//! Rigid motion of a floe and of its geometry
+void move(floe_type& floe, point_type const& dx, double dtheta)
+{
+    auto state = floe.get_state();
+    state.pos += dx;
+    state.theta += dtheta;
+    floe.set_state(state);
+}
+
+} // namespace
+
+
+TEST_CASE( "Test virtual buoys", "[io]" ) {
+
+    using manager_type = floe::io::TracerManager<TestFloeGroup>;
+
+    // floes set in place: room for the two fragments of the fracture below
+    TestFloeGroup group;
+    group.floes.reserve(5);
+    group.floes.resize(3);
+    floe::test::set_square(group.floes[0], 10, 1, point_type{0, 0});
+    floe::test::set_square(group.floes[1], 20, 1, point_type{100, 0});
+    floe::test::set_square(group.floes[2], 5, 1, point_type{0, 100});
+    auto& holed = group.floes[2].static_floe().geometry(); // hole in the third floe
+    holed.inners().resize(1);
+    holed.inners()[0] = {{-1, -1}, {-1, 1}, {1, 1}, {1, -1}};
+    group.floes[2].update();
+
+    manager_type tracers;
+    tracers.set_points({{5, 5}, {110, -10}, {50, 50}, {0, 100}, {3, 100}});
+    REQUIRE( !tracers.is_enabled() );
+    tracers.set_out_step(10);
+
+    REQUIRE( tracers.record_if_needed(0, group) );
+    REQUIRE( tracers.floe_id(0) == 0 );
+    REQUIRE( tracers.floe_id(1) == 1 );
+    REQUIRE( tracers.floe_id(2) == manager_type::npos ); // in water
+    REQUIRE( tracers.floe_id(3) == manager_type::npos ); // in the hole
+    REQUIRE( tracers.floe_id(4) == 2 );
+    REQUIRE( !tracers.record_if_needed(5, group) );
+
+    // rigid motion of the floes
+    move(group.floes[0], {1, 2}, M_PI / 2);
+    move(group.floes[1], {-3, 0}, 0);
+    group.floes[1].state().trans = {1000, 0}; // periodic translation
+    REQUIRE( tracers.record_if_needed(10, group) );
+    const point_type p0 = tracers.position(0), p1 = tracers.position(1), p2 = tracers.position(2);
+    REQUIRE( std::abs(p0.x - (1 - 5)) < 1e-12 );
+    REQUIRE( std::abs(p0.y - (2 + 5)) < 1e-12 );
+    REQUIRE( std::abs(p1.x - 1107) < 1e-12 );
+    REQUIRE( std::abs(p1.y + 10) < 1e-12 );
+    REQUIRE( p2.x == 50 );
+    REQUIRE( p2.y == 50 );
+
+    auto const& line = tracers.records().back().second;
+    REQUIRE( line.size() == 1 + 3 * 5 );
+    REQUIRE( line[0] == 10 );
+    REQUIRE( line[3] == 0 );
+    REQUIRE( line[9] == -1 );
+
+    // fracture of the first floe: its tracer goes to the fragment containing it
+    group.floes[0].state().desactivate();
+    group.floes.resize(5);
+    floe::test::set_square(group.floes[3], 2, 1, point_type{-4, 7});
+    floe::test::set_square(group.floes[4], 2, 1, point_type{6, 7});
+    REQUIRE( tracers.record_if_needed(20, group) );
+    REQUIRE( tracers.floe_id(0) == 3 );
+    move(group.floes[3], {0, 10}, 0);
+    tracers.record(25, group);
+    const point_type p3 = tracers.position(0);
+    REQUIRE( std::abs(p3.x + 4) < 1e-12 );
+    REQUIRE( std::abs(p3.y - 17) < 1e-12 );
+    REQUIRE( tracers.records().size() == 4 );
+}
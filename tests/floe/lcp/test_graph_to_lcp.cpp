@@ -0,0 +1,259 @@
+#include "../tests/catch.hpp"
+#include <random>
+#include <vector>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+
+#include "../tests/floe/test_floes.hpp"
+#include "floe/geometry/arithmetic/point_operators.hpp"
+#include "floe/collision/contact_graph.hpp"
+#include "floe/lcp/builder/graph_to_lcp.hpp"
+#include "floe/lcp/contact_impulse_record.hpp"
+
+
+namespace {
+
+using floe::test::floe_type;
+using floe::test::point_type;
+
+using contact_type = floe::collision::ContactPoint<floe_type>;
+using graph_type = floe::collision::ContactGraph<contact_type>;
+
+//! Random contact graph between 6 floes (the last one being an obstacle)
+graph_type make_graph(std::vector<floe_type>& floes, std::mt19937& gen)
+{
+    std::uniform_real_distribution<double> U(-1, 1);
+
+    floes.resize(6);
+    for (auto& f : floes)
+    {
+        const point_type pos{5 * U(gen), 5 * U(gen)}, speed{U(gen), U(gen)};
+        const double rot = U(gen), m = 1.5 + U(gen), h = 1 + 0.5 * U(gen);
+        floe::test::set_rectangle(f, h, 1, m, pos, speed, rot);
+    }
+    floes[5].is_obstacle() = true;
+
+    graph_type graph;
+    for (auto& f : floes) add_vertex(floe::collision::FloeVertex<floe_type>(&f), graph);
+    const int pairs[][2] = {{0,1}, {1,2}, {2,0}, {3,4}, {4,5}, {1,5}, {0,3}};
+    for (auto const& p : pairs)
+    {
+        floe::collision::FloeContact<contact_type> contacts;
+        for (int c = 0; c < 3; ++c)
+        {
+            point_type a{5 * U(gen), 5 * U(gen)};
+            point_type b{a.x + 0.1 * U(gen), a.y + 0.1 * U(gen)};
+            if (c % 2) contacts.push_back(contact_type(&floes[p[0]], &floes[p[1]], a, b));
+            else       contacts.push_back(contact_type(&floes[p[1]], &floes[p[0]], a, b));
+        }
+        add_edge(p[0], p[1], contacts, graph);
+    }
+    return graph;
+}
+
+} // namespace
+
+
+TEST_CASE( "Test direct LCP assembly", "[lcp]" ) {
+
+    namespace ublas = boost::numeric::ublas;
+
+    std::mt19937 gen(3);
+    std::vector<floe_type> floes;
+    graph_type graph = make_graph(floes, gen);
+
+    floe::lcp::builder::GraphLCP<double, graph_type> graph_lcp( graph );
+    auto const lcp = graph_lcp.getLCP();
+    const std::size_t m = graph_lcp.nb_contacts;
+
+    // Reference blocks with ublas products
+    ublas::matrix<double> J(graph_lcp.J), D(graph_lcp.D), iM(graph_lcp.invM);
+    ublas::matrix<double> iMJ = ublas::prod(iM, J), iMD = ublas::prod(iM, D);
+    ublas::matrix<double> JJ = ublas::prod(ublas::trans(J), iMJ);
+    ublas::matrix<double> JD = ublas::prod(ublas::trans(J), iMD);
+    ublas::matrix<double> DD = ublas::prod(ublas::trans(D), iMD);
+    ublas::vector<double> qn = ublas::prod(ublas::trans(J), graph_lcp.W);
+    ublas::vector<double> qt = ublas::prod(ublas::trans(D), graph_lcp.W);
+
+    const double tol = 1e-12;
+    for (std::size_t i = 0; i < m; ++i)
+    {
+        REQUIRE( std::abs(lcp.q(i) - qn(i)) < tol );
+        REQUIRE( lcp.q(3*m + i) == 0 );
+        REQUIRE( lcp.M(3*m + i, i) == graph_lcp.mu(i, i) );
+        for (std::size_t j = 0; j < m; ++j)
+            REQUIRE( std::abs(lcp.M(i, j) - JJ(i, j)) < tol );
+        for (std::size_t j = 0; j < 2*m; ++j)
+        {
+            REQUIRE( std::abs(lcp.M(i, m + j) - JD(i, j)) < tol );
+            REQUIRE( std::abs(lcp.M(m + j, i) - JD(i, j)) < tol );
+        }
+    }
+    for (std::size_t i = 0; i < 2*m; ++i)
+    {
+        REQUIRE( std::abs(lcp.q(m + i) - qt(i)) < tol );
+        REQUIRE( lcp.M(m + i, 3*m + i/2) == 1 );
+        REQUIRE( lcp.M(3*m + i/2, m + i) == -1 );
+        for (std::size_t j = 0; j < 2*m; ++j)
+            REQUIRE( std::abs(lcp.M(m + i, m + j) - DD(i, j)) < tol );
+    }
+}
+
+
+TEST_CASE( "Test contact impulses", "[lcp]" ) {
+
+    namespace ublas = boost::numeric::ublas;
+
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> U(0, 1);
+    std::vector<floe_type> floes;
+    graph_type graph = make_graph(floes, gen);
+
+    floe::lcp::builder::GraphLCP<double, graph_type> graph_lcp( graph );
+    auto lcp = graph_lcp.getLCP();
+    const std::size_t m = graph_lcp.nb_contacts;
+    for (std::size_t i = 0; i < 4*m; ++i) lcp.z(i) = U(gen);
+
+    // Impulses received by each floe from the LCP solution
+    ublas::vector<double> floe_impulses = ublas::prod(graph_lcp.J, ublas::subrange(lcp.z, 0, m))
+                                        + ublas::prod(graph_lcp.D, ublas::subrange(lcp.z, m, 3*m));
+
+    // Same impulses from the contact impulses (floe2 receives them in the contact frame)
+    auto const impulses = graph_lcp.contact_impulses(lcp);
+    REQUIRE( impulses[0].size() == m );
+    ublas::vector<double> floe_impulses_c(floe_impulses.size(), 0);
+    std::size_t j = 0;
+    for ( auto const& edge : make_iterator_range( edges( graph ) ) )
+    {
+        for ( auto const& contact : graph[edge] )
+        {
+            const point_type P = contact.frame.v() * impulses[0](j) + contact.frame.u() * impulses[1](j);
+            for (auto const v : {source(edge, graph), target(edge, graph)})
+            {
+                const double s = (graph[v].floe == contact.floe2) ? 1 : -1;
+                const point_type r = contact.frame.center() - graph[v].floe->state().pos;
+                floe_impulses_c(3*v)     += s * P.x;
+                floe_impulses_c(3*v + 1) += s * P.y;
+                floe_impulses_c(3*v + 2) += s * (r.x * P.y - r.y * P.x);
+            }
+            ++j;
+        }
+    }
+    for (std::size_t i = 0; i < floe_impulses.size(); ++i)
+        REQUIRE( std::abs(floe_impulses(i) - floe_impulses_c(i)) < 1e-12 );
+
+    // Record: one line per contact, accumulating the impulses of each LCP
+    floe::lcp::ContactImpulseRecord<double> record;
+    record.start_step(10., floes.data(), graph);
+    record.add(graph, impulses);
+    record.add(graph, impulses);
+    REQUIRE( record.records().size() == m );
+    j = 0;
+    for ( auto const& edge : make_iterator_range( edges( graph ) ) )
+    {
+        for ( auto const& contact : graph[edge] )
+        {
+            auto const& line = record.records()[j];
+            REQUIRE( line[0] == 10. );
+            REQUIRE( line[1] == double(contact.floe1 - floes.data()) );
+            REQUIRE( line[2] == double(contact.floe2 - floes.data()) );
+            REQUIRE( line[3] == contact.frame.center().x );
+            REQUIRE( line[5] == 2 * impulses[0](j) );
+            REQUIRE( line[6] == 2 * impulses[1](j) );
+            ++j;
+        }
+    }
+}
+
+
+TEST_CASE( "Test contact impulses record of parallel edges", "[lcp]" ) {
+
+    std::mt19937 gen(7);
+    std::vector<floe_type> floes;
+    graph_type graph = make_graph(floes, gen);
+
+    // second edge between floes 0 and 1 (other detection direction), with another number of contacts
+    floe::collision::FloeContact<contact_type> contacts;
+    contacts.push_back(contact_type(&floes[1], &floes[0], point_type{0.5, 0.5}, point_type{0.6, 0.5}));
+    contacts.push_back(contact_type(&floes[1], &floes[0], point_type{0.5, 0.7}, point_type{0.6, 0.7}));
+    add_edge(1, 0, contacts, graph);
+    const std::size_t m = num_contacts(graph);
+
+    // impulses of each contact added through a copy of the graph, as the LCP manager does with the subgraphs
+    floe::lcp::ContactImpulseRecord<double> record;
+    record.start_step(0., floes.data(), graph);
+    REQUIRE( record.records().size() == m );
+    graph_type subgraph;
+    copy_graph( floe::collision::graph_from_ids( graph, {0, 1, 2} ), subgraph );
+    std::array<boost::numeric::ublas::vector<double>, 2> impulses{{
+        boost::numeric::ublas::vector<double>(num_contacts(subgraph)), boost::numeric::ublas::vector<double>(num_contacts(subgraph))
+    }};
+    std::size_t j = 0;
+    for ( auto const& edge : make_iterator_range( edges( subgraph ) ) )
+        for ( auto const& contact : subgraph[edge] )
+        {
+            impulses[0](j) = contact.frame.center().x;
+            impulses[1](j) = contact.frame.center().y;
+            ++j;
+        }
+    record.add(subgraph, impulses);
+
+    // each line has the impulses of its own contact, the contacts outside the subgraph have none
+    std::size_t nb_recorded = 0;
+    for ( auto const& line : record.records() )
+    {
+        const bool in_subgraph = line[1] <= 2 && line[2] <= 2;
+        REQUIRE( line[5] == (in_subgraph ? line[3] : 0.) );
+        REQUIRE( line[6] == (in_subgraph ? line[4] : 0.) );
+        if (in_subgraph) ++nb_recorded;
+    }
+    REQUIRE( nb_recorded == num_contacts(subgraph) );
+}
+
+
+TEST_CASE( "Test projected Gauss-Seidel fallback", "[lcp]" ) {
+
+    namespace ublas = boost::numeric::ublas;
+
+    std::mt19937 gen(11);
+    std::vector<floe_type> floes;
+    graph_type graph = make_graph(floes, gen);
+    floes[5].state().speed = point_type{0, 0}; floes[5].state().rot = 0;
+
+    floe::lcp::builder::GraphLCP<double, graph_type> graph_lcp( graph );
+    auto lcp = graph_lcp.getLCP();
+    const std::size_t m = graph_lcp.nb_contacts;
+
+    auto kinetic_energy = [&](ublas::vector<double> const& V) {
+        return ublas::inner_prod(V, ublas::vector<double>(ublas::prod(graph_lcp.M, V)));
+    };
+
+    for (std::size_t sweeps : {1, 10, 20000})
+    {
+        lcp.z = graph_lcp.pgs_solution(graph_lcp.W, sweeps, 1e-12);
+        REQUIRE( lcp.z.size() == 4*m );
+
+        // Admissible impulses whatever the number of sweeps
+        for (std::size_t j = 0; j < m; ++j)
+        {
+            REQUIRE( lcp.z(j) >= 0 );
+            REQUIRE( lcp.z(m+2*j) >= 0 );
+            REQUIRE( lcp.z(m+2*j+1) >= 0 );
+            const double friction = lcp.z(m+2*j) + lcp.z(m+2*j+1);
+            REQUIRE( friction <= graph_lcp.mu(j, j) * lcp.z(j) + 1e-12 );
+        }
+
+        ublas::vector<double> V = graph_lcp.W + ublas::prod(graph_lcp.invM, ublas::vector<double>(
+            ublas::prod(graph_lcp.J, ublas::subrange(lcp.z, 0, m)) + ublas::prod(graph_lcp.D, ublas::subrange(lcp.z, m, 3*m))
+        ));
+        if (sweeps < 20000) continue;
+
+        // Converged: no interpenetrating speed, dissipative, and close to the LCP solution
+        ublas::vector<double> Vn = ublas::prod(ublas::trans(graph_lcp.J), V);
+        for (std::size_t j = 0; j < m; ++j)
+            REQUIRE( Vn(j) >= -1e-6 );
+        REQUIRE( kinetic_energy(V) <= kinetic_energy(graph_lcp.W) );
+        REQUIRE( lcp.LCP_error() < 1e-5 );
+    }
+}
@@ -0,0 +1,112 @@
+#include "../tests/catch.hpp"
+#include <random>
+#include <vector>
+
+#include "../tests/floe/test_floes.hpp"
+#include "floe/geometry/arithmetic/point_operators.hpp"
+#include "floe/collision/contact_graph.hpp"
+#include "floe/lcp/solver/LCP_solver.hpp"
+#include "floe/lcp/LCP_manager.hpp"
+
+
+namespace {
+
+using floe::test::floe_type;
+using floe::test::point_type;
+
+using contact_type = floe::collision::ContactPoint<floe_type>;
+using graph_type = floe::collision::ContactGraph<contact_type>;
+
+/*! Contact graph of 8 clusters of 4 floes converging to their center,
+ *  the first two clusters touching the same obstacle (last floe)
+ */
+graph_type make_graph(std::vector<floe_type>& floes)
+{
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> U(-1, 1);
+    const std::size_t nb_clusters = 8;
+    floes.resize(4 * nb_clusters + 1);
+    floe::test::set_square(floes.back(), 1, 1e9, point_type{0, -10});
+    floes.back().is_obstacle() = true;
+    graph_type graph;
+    for (auto& f : floes) add_vertex(floe::collision::FloeVertex<floe_type>(&f), graph);
+
+    auto add_contact = [&](std::size_t i, std::size_t j, point_type a, point_type n) {
+        floe::collision::FloeContact<contact_type> contacts;
+        contacts.push_back(contact_type(&floes[i], &floes[j], a, a + 1e-3 * n));
+        add_edge(i, j, contacts, graph);
+    };
+    for (std::size_t c = 0; c < nb_clusters; ++c)
+    {
+        const point_type center{100. * c, 0};
+        const point_type offsets[4] = {{-1, -1}, {1, -1}, {1, 1}, {-1, 1}};
+        for (std::size_t k = 0; k < 4; ++k)
+        {
+            const point_type speed{-offsets[k].x + 0.1 * U(gen), -offsets[k].y};
+            const double rot = 0.1 * U(gen), m = 1 + 0.2 * U(gen), h = 0.5 + 0.1 * U(gen);
+            floe::test::set_square(floes[4 * c + k], h, m, center + offsets[k], speed, rot);
+        }
+        add_contact(4 * c, 4 * c + 1, center + point_type{0, -1}, point_type{1, 0});
+        add_contact(4 * c + 1, 4 * c + 2, center + point_type{1, 0}, point_type{0, 1});
+        add_contact(4 * c + 2, 4 * c + 3, center + point_type{0, 1}, point_type{-1, 0});
+        add_contact(4 * c + 3, 4 * c, center + point_type{-1, 0}, point_type{0, -1});
+        if (c < 2)
+            add_contact(4 * c, floes.size() - 1, center + point_type{-1, -2}, point_type{0, -1});
+    }
+    return graph;
+}
+
+} // namespace
+
+
+TEST_CASE( "Test parallel solving of the collision subgraphs", "[lcp]" ) {
+
+    using manager_type = floe::lcp::LCPManager<floe::lcp::solver::LCPSolver<double>>;
+
+    std::vector<floe_type> floes_seq, floes_par;
+    graph_type graph_seq = make_graph(floes_seq);
+    graph_type graph_par = make_graph(floes_par);
+
+    manager_type seq(0.4), par(0.4);
+    seq.set_parallel(false);
+    const int nb_success_seq = seq.solve_contacts(graph_seq);
+    const int nb_success_par = par.solve_contacts(graph_par);
+    REQUIRE( nb_success_seq > 0 );
+    REQUIRE( nb_success_par == nb_success_seq );
+
+    // same solution, whatever the order of the tasks
+    bool same = true;
+    for (std::size_t i = 0; i < floes_seq.size(); ++i)
+    {
+        auto const& s_seq = floes_seq[i].get_state();
+        auto const& s_par = floes_par[i].get_state();
+        same = same && s_seq.speed.x == s_par.speed.x && s_seq.speed.y == s_par.speed.y && s_seq.rot == s_par.rot
+                    && floes_seq[i].total_received_impulse() == floes_par[i].total_received_impulse();
+    }
+    REQUIRE( same );
+    REQUIRE( floes_par.back().total_received_impulse() > 0 );
+}
+
+TEST_CASE( "Test mixed precision counters of the parallel LCP solving", "[lcp]" ) {
+
+    using manager_type = floe::lcp::LCPManager<floe::lcp::solver::LCPSolver<double>>;
+
+    manager_type seq(0.4), par(0.4);
+    seq.set_parallel(false);
+    seq.get_solver().set_mixed_precision(true);
+    par.get_solver().set_mixed_precision(true);
+
+    // two consecutive steps: the counters of the thread copies are only merged once
+    for (int step = 0; step < 2; ++step)
+    {
+        std::vector<floe_type> floes_seq, floes_par;
+        graph_type graph_seq = make_graph(floes_seq);
+        graph_type graph_par = make_graph(floes_par);
+        seq.solve_contacts(graph_seq);
+        par.solve_contacts(graph_par);
+        const long nb_runs = seq.get_solver().get_nb_mixed_solved() + seq.get_solver().get_nb_mixed_fallback();
+        REQUIRE( nb_runs > 0 );
+        REQUIRE( par.get_solver().get_nb_mixed_solved() == seq.get_solver().get_nb_mixed_solved() );
+        REQUIRE( par.get_solver().get_nb_mixed_fallback() == seq.get_solver().get_nb_mixed_fallback() );
+    }
+}
@@ -0,0 +1,84 @@
+#include "../tests/catch.hpp"
+#include <random>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+
+#include "floe/lcp/lcp.hpp"
+#include "floe/lcp/solver/lexicolemke_MR.hpp"
+
+
+TEST_CASE( "Test mixed precision Lemke", "[lcp]" ) {
+
+    namespace ublas = boost::numeric::ublas;
+    using lcp_type = floe::lcp::LCP<double>;
+
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> U(-1, 1);
+
+    const std::size_t dim = 12;
+    const double tol = 1e-5;
+
+    for (int n = 0; n < 20; ++n)
+    {
+        // P-matrix LCP: unique solution
+        ublas::matrix<double> B(dim, dim);
+        for (std::size_t i = 0; i < dim; ++i)
+            for (std::size_t j = 0; j < dim; ++j)
+                B(i, j) = U(gen);
+        ublas::matrix<double> M = ublas::prod(B, ublas::trans(B)) + ublas::identity_matrix<double>(dim);
+        ublas::vector<double> q(dim);
+        for (std::size_t i = 0; i < dim; ++i) q(i) = 10 * U(gen);
+
+        lcp_type lcp_d(dim, M), lcp_m(dim, M), lcp_orig(dim);
+        lcp_d.q = q; lcp_m.q = q;
+        lcp_orig.M = M; lcp_orig.q = q;
+
+        floe::lcp::solver::lexicolemke_MR(tol, lcp_d, 1000);
+        bool used_fallback;
+        auto status = floe::lcp::solver::lexicolemke_MR_mixed(tol, lcp_m, 1000, used_fallback);
+
+        REQUIRE( status[0] < 0 );
+        lcp_orig.z = lcp_m.z;
+        REQUIRE( lcp_orig.LCP_error() <= tol );
+        REQUIRE( ublas::norm_inf(lcp_m.z - lcp_d.z) <= 1e-8 * (1 + ublas::norm_inf(lcp_d.z)) );
+        // Well conditioned LCP: no need to pivot in double precision
+        CHECK( !used_fallback );
+    }
+}
+
+TEST_CASE( "Test step arena use of repeated Lemke attempts", "[lcp]" ) {
+
+    namespace ublas = boost::numeric::ublas;
+    using lcp_type = floe::lcp::LCP<double>;
+    using floe::utils::step_arena;
+
+    // no solution (M = -Id, q < 0): Lemke's algorithm ends on a secondary ray
+    const std::size_t dim = 60;
+    ublas::matrix<double> M = - ublas::identity_matrix<double>(dim);
+
+    floe::utils::ArenaScope scope; // as in LCPSolver::solve, over all the attempts
+    lcp_type lcp(dim, M);
+    for (std::size_t i = 0; i < dim; ++i) lcp.q(i) = -1;
+    const lcp_type lcp_orig = lcp;
+
+    std::size_t used = 0, capacity = 0;
+    bool bounded = true, failed = true;
+    for (int attempt = 0; attempt < 20; ++attempt)
+    {
+        lcp = lcp_orig;
+        bool used_fallback;
+        auto status = (attempt % 2) ? floe::lcp::solver::lexicolemke_MR(1e-7, lcp, 1000)
+                                    : floe::lcp::solver::lexicolemke_MR_mixed(1e-7, lcp, 1000, used_fallback);
+        failed = failed && status[0] >= 0;
+        if (attempt == 1)
+        {
+            used = step_arena().mark().offset;
+            capacity = step_arena().capacity();
+        }
+        else if (attempt > 1)
+            bounded = bounded && step_arena().mark().offset == used && step_arena().capacity() == capacity;
+    }
+    REQUIRE( failed );
+    REQUIRE( bounded );
+}
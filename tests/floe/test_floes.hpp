@@ -0,0 +1,86 @@
+/*!
+ * \file tests/floe/test_floes.hpp
+ * \brief Floes of the unit tests: real kinematic floes, meshed without the mesh generator
+ */
+
+#ifndef TESTS_FLOE_TEST_FLOES_HPP
+#define TESTS_FLOE_TEST_FLOES_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "floe/floes/static_floe.hpp"
+#include "floe/floes/kinematic_floe.hpp"
+
+namespace floe { namespace test
+{
+
+using floe_type = floe::floes::KinematicFloe<floe::floes::StaticFloe<double>>;
+using point_type = floe_type::point_type;
+using state_type = floe_type::state_type;
+
+/*! Sets a floe to a rectangle of half sides (hx, hy) centered on its position, of mass m (unit thickness)
+ *
+ * The mesh is a fan of triangles around the center, one per boundary segment: the boundary is made of
+ * the 4 corners, or of points every ds (about) along the sides.
+ * The static floe refers to the mesh of the floe: the floe is set in place,
+ * and its list must not be reallocated afterwards.
+ */
+inline void set_rectangle(floe_type& floe, double hx, double hy, double m,
+                          point_type pos, point_type speed = {0, 0}, double rot = 0, double theta = 0, double ds = 0)
+{
+    using static_floe_type = floe_type::static_floe_type;
+    using geometry_type = floe_type::geometry_type;
+
+    floe.attach_static_floe_ptr(std::unique_ptr<static_floe_type>(new static_floe_type()));
+    auto& static_floe = floe.static_floe();
+    std::unique_ptr<geometry_type> shape(new geometry_type);
+    const point_type corners[4] = {{-hx, -hy}, {hx, -hy}, {hx, hy}, {-hx, hy}};
+    for (std::size_t k = 0; k < 4; ++k)
+    {
+        const point_type a = corners[k], b = corners[(k + 1) % 4];
+        const std::size_t n = (ds > 0) ? std::max<std::size_t>(1, std::lround(std::hypot(b.x - a.x, b.y - a.y) / ds)) : 1;
+        for (std::size_t i = 0; i < n; ++i)
+            shape->outer().push_back(point_type{a.x + (b.x - a.x) * i / n, a.y + (b.y - a.y) * i / n});
+    }
+    auto& mesh = floe.get_floe_h().m_static_mesh;
+    mesh = floe_type::mesh_type{};
+    mesh.points().push_back(point_type{0, 0});
+    mesh.points().insert(mesh.points().end(), shape->outer().begin(), shape->outer().end());
+    const std::size_t nb_points = shape->outer().size();
+    for (std::size_t k = 1; k <= nb_points; ++k) mesh.add_triangle(0, k, k % nb_points + 1);
+    static_floe.attach_geometry_ptr(std::move(shape));
+    static_floe.attach_mesh_ptr(&mesh);
+    static_floe.set_density(m / (4 * hx * hy));
+    floe.set_state({pos, theta, speed, rot, {0, 0}, true});
+}
+
+//! Square floe of half side h (see set_rectangle)
+inline void set_square(floe_type& floe, double h, double m, point_type pos, point_type speed = {0, 0}, double rot = 0)
+{
+    set_rectangle(floe, h, h, m, pos, speed, rot);
+}
+
+/*! Sets the n floes of a floe group in place (set_floe(floe, i) for the i-th floe)
+ *
+ * \tparam TFloeGroup  Floe group with a filtered floe list (e.g. PartialFloeGroup).
+ */
+template <typename TFloeGroup, typename TSetFloe>
+void set_floes(TFloeGroup& group, std::size_t n, TSetFloe set_floe)
+{
+    auto& floes = group.get_floes();
+    floes.filter_off();
+    floes.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        set_floe(floes[i], i);
+        group.get_floe_group_h().add_floe(floes[i].get_floe_h());
+    }
+    group.update_list_ids_active();
+}
+
+}} // namespace floe::test
+
+#endif // TESTS_FLOE_TEST_FLOES_HPP
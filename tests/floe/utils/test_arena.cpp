@@ -0,0 +1,59 @@
+#include "../tests/catch.hpp"
+#include <cstdint>
+#include <vector>
+#include "floe/utils/arena.hpp"
+#include "floe/lcp/lcp.h"
+
+TEST_CASE( "Test monotonic arenas", "[utils]" ) {
+
+    using namespace floe::utils;
+
+    MonotonicArena arena(256);
+
+    // alignment and LIFO roll back
+    void* a = arena.allocate(3, 1);
+    double* b = static_cast<double*>(arena.allocate(sizeof(double), alignof(double)));
+    const std::uintptr_t misalignment = reinterpret_cast<std::uintptr_t>(b) % alignof(double);
+    REQUIRE( misalignment == 0 );
+    arena.deallocate(b, sizeof(double));
+    REQUIRE( arena.allocate(sizeof(double), alignof(double)) == b );
+    arena.deallocate(a, 3); // not the last one: nothing done
+    REQUIRE( arena.allocate(1, 1) != a );
+
+    // rewinding and reset merge the blocks
+    auto marker = arena.mark();
+    void* c = arena.allocate(1000);
+    REQUIRE( arena.capacity() > 1000 );
+    arena.rewind(marker);
+    arena.reset();
+    const std::size_t capacity = arena.capacity();
+    REQUIRE( arena.allocate(1000) != nullptr );
+    REQUIRE( arena.capacity() == capacity );
+    (void)c;
+
+    // containers in the step arena, given back by a scope
+    std::size_t used;
+    {
+        ArenaScope scope;
+        used = step_arena().mark().offset;
+        std::vector<int, ArenaAllocator<int>> v(100, 1);
+        floe::lcp::arena_matrix<double> M(20, 21, 0.5);
+        REQUIRE( v[99] == 1 );
+        REQUIRE( M(19, 20) == 0.5 );
+        REQUIRE( step_arena().mark().offset > used );
+    }
+    REQUIRE( step_arena().mark().offset == used );
+    reset_step_arenas();
+    REQUIRE( step_arena().mark().offset == 0 );
+
+    // no lazy reset while a scope is open (step ended by another thread)
+    {
+        ArenaScope scope;
+        std::vector<int, ArenaAllocator<int>> v(100, 1);
+        used = step_arena().mark().offset;
+        reset_step_arenas();
+        REQUIRE( step_arena().mark().offset == used );
+        REQUIRE( v[99] == 1 );
+    }
+    REQUIRE( step_arena().mark().offset == 0 );
+}
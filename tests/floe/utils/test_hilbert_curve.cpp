@@ -0,0 +1,37 @@
+#include "../tests/catch.hpp"
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include "floe/utils/hilbert_curve.hpp"
+
+TEST_CASE( "Test Hilbert curve", "[utils]" ) {
+
+    using namespace floe::utils;
+
+    // the first 64 indices fill the 8 x 8 cells at the origin, consecutive indices being neighbour cells
+    std::vector<std::array<int, 2>> cells(64, {{-1, -1}});
+    for (std::uint32_t x = 0; x < 8; ++x)
+        for (std::uint32_t y = 0; y < 8; ++y)
+        {
+            const std::uint32_t d = hilbert_index(x, y);
+            REQUIRE( d < 64 );
+            REQUIRE( cells[d][0] == -1 );
+            cells[d] = {{int(x), int(y)}};
+        }
+    for (std::size_t d = 1; d < cells.size(); ++d)
+    {
+        const int dist = std::abs(cells[d][0] - cells[d - 1][0]) + std::abs(cells[d][1] - cells[d - 1][1]);
+        REQUIRE( dist == 1 );
+    }
+    REQUIRE( hilbert_index(0, 0) == 0 );
+
+    // points in a window, clamped to it
+    struct Point { double x, y; };
+    const std::array<double, 4> window{{-10, 10, 0, 5}};
+    REQUIRE( hilbert_index(Point{-10, 0}, window) == 0 );
+    REQUIRE( hilbert_index(Point{-20, -1}, window) == 0 );
+    const std::uint32_t last = (1u << 16) - 1;
+    REQUIRE( hilbert_index(Point{10, 5}, window) == hilbert_index(last, last) );
+    REQUIRE( hilbert_index(Point{15, 8}, window) == hilbert_index(last, last) );
+}
@@ -0,0 +1,71 @@
+#include "../tests/catch.hpp"
+#include <array>
+#include <cstddef>
+#include <vector>
+#include "floe/utils/shared_storage_allocator.hpp"
+#include "floe/geometry/geometry.hpp"
+#include "floe/geometry/geometries/point.hpp"
+#include "floe/geometry/geometries/triangle_mesh.hpp"
+
+TEST_CASE( "Test shared storage allocator", "[utils]" ) {
+
+    using namespace floe::utils;
+    using point_type = floe::geometry::Point<double>;
+    using polygon_type = boost::geometry::model::polygon<point_type, false, false, std::vector, std::vector, SharedStorageAllocator>;
+    using mesh_type = floe::geometry::TriangleMesh<point_type, SharedStorageAllocator>;
+    using triangle_type = std::array<std::size_t, 3>;
+
+    // storage owned elsewhere (e.g. a node shared window)
+    std::vector<point_type> points{{0, 0}, {2, 0}, {2, 1}, {0, 1}};
+    std::vector<triangle_type> triangles{{{0, 1, 2}}, {{0, 2, 3}}};
+
+    {
+        // attached values: no copy
+        polygon_type shape;
+        attach_storage<point_type>(shape.outer(), points.data(), points.size());
+        REQUIRE( shape.outer().data() == points.data() );
+        REQUIRE( boost::geometry::area(shape) == Approx(2) );
+
+        mesh_type mesh;
+        attach_storage<point_type>(mesh.points(), points.data(), points.size());
+        attach_storage<triangle_type>(mesh.connectivity(), triangles.data(), triangles.size());
+        REQUIRE( mesh.points().data() == points.data() );
+        REQUIRE( mesh.connectivity().data() == triangles.data() );
+
+        // copies on the heap
+        polygon_type copy = shape;
+        REQUIRE( copy.outer().data() != points.data() );
+        REQUIRE( copy.outer().size() == 4 );
+        copy.outer().push_back(point_type{-1, 1});
+
+        // transformation into a mesh with another allocator
+        floe::geometry::TriangleMesh<point_type> moved_mesh;
+        boost::geometry::strategy::transform::translate_transformer<double, 2, 2> translate(1, 1);
+        floe::geometry::transform(mesh, moved_mesh, translate);
+        REQUIRE( moved_mesh.connectivity() == std::vector<triangle_type>(triangles) );
+        REQUIRE( moved_mesh.points()[2].x == 3 );
+
+        // assignments replace the storage instead of writing in it
+        polygon_type other;
+        other.outer() = {{5, 5}, {6, 5}, {6, 6}};
+        shape = other;
+        REQUIRE( shape.outer().data() != points.data() );
+        const mesh_type::multi_point_type heap_points(copy.outer().begin(), copy.outer().end());
+        mesh.points() = heap_points;
+        mesh.connectivity() = mesh_type::connectivity_type(1, triangle_type{{0, 1, 2}});
+        REQUIRE( mesh.points().size() == 5 );
+        REQUIRE( mesh.connectivity().size() == 1 );
+
+        // a second attachment to the same storage
+        polygon_type shared;
+        attach_storage<point_type>(shared.outer(), points.data(), points.size());
+        attach_storage<point_type>(shared.outer(), points.data(), points.size());
+        REQUIRE( shared.outer().data() == points.data() );
+    }
+
+    // the storage has not been modified nor freed by the containers
+    REQUIRE( points.size() == 4 );
+    REQUIRE( points[1].x == 2 );
+    REQUIRE( points[3].y == 1 );
+    REQUIRE( triangles[1][2] == 3 );
+}